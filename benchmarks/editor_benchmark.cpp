@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// The editor side operations: project allocations, mip chain generation and the animation name search.
+// The runtime reader lookups are measured apart by runtime_benchmark, which does not link the editor.
+
+#include "export.hpp"
+#include "mip_pyramid.hpp"
+#include "name_index.hpp"
+#include "project.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Every heap allocation of the process is counted, the editor operations are measured in allocations per call
+std::atomic<int64_t> heapAllocations{};
+
+void*
+operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory{ std::malloc(size ? size : 1) })
+        {
+            return memory;
+        }
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void
+operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+constexpr int32_t NUM_ANIMATIONS{ 10000 };
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Operation>
+void
+ReportAllocations(const char* name, int32_t operations, Operation&& operation)
+{
+    const int64_t before{ heapAllocations.load(std::memory_order_relaxed) };
+    const auto    start{ Clock::now() };
+    for (int32_t i{}; i < operations; ++i)
+        {
+            operation();
+        }
+    const double  seconds{ std::chrono::duration<double>(Clock::now() - start).count() };
+    const int64_t allocations{ heapAllocations.load(std::memory_order_relaxed) - before };
+    std::printf("%-24s %12.1f allocs/op  (%.2f per animation, %.3f ms/op)\n", name, static_cast<double>(allocations) / operations,
+    static_cast<double>(allocations) / operations / NUM_ANIMATIONS, seconds * 1e3 / operations);
+}
+
+/**
+ * \brief Load, undo, redo and export of the editor project, the allocations are what fragments the heap in long sessions.
+ */
+void
+BenchmarkProjectAllocations(const nlohmann::ordered_json& j)
+{
+    constexpr int32_t NUM_OPERATIONS{ 20 };
+
+    // The project file is merged from disk like an external edit
+    const auto directory{ std::filesystem::temp_directory_path() };
+    Project    project{};
+    project.SpritePath = (directory / "editor_benchmark.png").string();
+    const auto writeProject = [&project](const nlohmann::ordered_json& projectJson) { std::ofstream(project.GetProjectFilePath()) << projectJson.dump(); };
+
+    auto edited = j;
+    edited["animations"].at(0)["x"] = 1;
+    std::printf("Project, %d animations\n", NUM_ANIMATIONS);
+    ReportAllocations("Load (merge file)", NUM_OPERATIONS, [&, toggle = false]() mutable {
+        writeProject((toggle = !toggle) ? edited : j);
+        project.MergeAnimationDataFromFile();
+    });
+    ReportAllocations("Undo", NUM_OPERATIONS, [&]() { project.UndoAction(); });
+    ReportAllocations("Redo", NUM_OPERATIONS, [&]() { project.RedoAction(); });
+    ReportAllocations("BuildBinaryExport", NUM_OPERATIONS, [&]() { (void)BuildBinaryExport(j, { Vec2{ 4096, 4096 } }); });
+    ReportAllocations("BuildCppHeaderExport", NUM_OPERATIONS, [&]() { (void)BuildCppHeaderExport(j, { Vec2{ 4096, 4096 } }, "benchmark"); });
+
+    std::filesystem::remove(project.GetProjectFilePath());
+}
+
+/**
+ * \brief The mip chain generated when a sheet is loaded, a third of the texels are transparent like on a packed atlas.
+ */
+void
+BenchmarkMipChain()
+{
+    constexpr int32_t SIZE{ 4096 };
+    constexpr int32_t NUM_OPERATIONS{ 5 };
+
+    const int32_t        numLevels{ GetNumMipLevels(SIZE, SIZE) };
+    std::vector<uint8_t> chain(GetMipChainBytes(SIZE, SIZE, numLevels));
+    for (size_t i{}; i < static_cast<size_t>(SIZE) * SIZE; ++i)
+        {
+            const uint32_t texel{ i % 3 == 0 ? 0u : static_cast<uint32_t>(i * 2654435761u) | 0xFF000000u };
+            std::memcpy(&chain[i * 4], &texel, sizeof(texel));
+        }
+    std::printf("\nMip chain, %dx%d, %d levels\n", SIZE, SIZE, numLevels);
+    for (const auto& [name, filter] : { std::pair{ "GenerateMipChain(box)", EMipFilter::BOX }, std::pair{ "GenerateMipChain(lanczos)", EMipFilter::LANCZOS } })
+        {
+            const auto start{ Clock::now() };
+            for (int32_t i{}; i < NUM_OPERATIONS; ++i)
+                {
+                    GenerateMipChain(chain.data(), SIZE, SIZE, numLevels, filter);
+                }
+            const double seconds{ std::chrono::duration<double>(Clock::now() - start).count() };
+            std::printf("%-24s %12.2f ms/op  (%.2f ns/texel, sink %u)\n", name, seconds * 1e3 / NUM_OPERATIONS, seconds * 1e9 / NUM_OPERATIONS / (chain.size() / 4),
+                        chain.back());
+        }
+}
+
+/**
+ * \brief The animation list search typed one key at a time, every prefix of the query is a keystroke.
+ */
+void
+BenchmarkNameSearch()
+{
+    constexpr int32_t NUM_NAMES{ 100000 };
+    constexpr char    QUERY[]{ "walk_left_42" };
+
+    NameIndex         index{};
+    const char* const parts[]{ "Player", "Enemy", "Boss", "Coin", "Walk", "Run", "Idle", "Attack", "Left", "Right", "Up", "Down" };
+    const auto        start{ Clock::now() };
+    for (uint32_t i{}; i < NUM_NAMES; ++i)
+        {
+            const uint32_t hash{ i * 2654435761u };
+            (void)index.Add(std::string{ parts[hash % 4] } + "_" + parts[4 + (hash >> 8) % 4] + "_" + parts[8 + (hash >> 16) % 4] + "_" + std::to_string(i));
+        }
+    std::printf("\nName search, %d names\n", NUM_NAMES);
+    std::printf("%-24s %12.2f ms  (%.1f MB)\n", "NameIndex::Add", std::chrono::duration<double>(Clock::now() - start).count() * 1e3, index.GetBytes() / 1e6);
+
+    const std::string_view query{ QUERY };
+    for (size_t length{ 1 }; length <= query.size(); ++length)
+        {
+            const auto   keyStart{ Clock::now() };
+            const size_t numOfMatches{ index.Search(query.substr(0, length)).size() };
+            const double seconds{ std::chrono::duration<double>(Clock::now() - keyStart).count() };
+            std::printf("  %-22.*s %12.3f ms  (%zu matches, %zu verified)\n", static_cast<int>(length), QUERY, seconds * 1e3, numOfMatches, index.GetNumVerified());
+        }
+}
+}
+
+int
+main()
+{
+    // Synthetic project, the same json the editor saves
+    nlohmann::ordered_json j{};
+    j["animations"] = nlohmann::ordered_json::array();
+    for (int32_t i{}; i < NUM_ANIMATIONS; ++i)
+        {
+            j["animations"].push_back({ { "name", "Animation_" + std::to_string(i) },
+            { "type", "Spritesheet" },
+            { "x", (i % 64) * 32 },
+            { "y", (i / 64) * 32 },
+            { "width", 32 },
+            { "height", 32 },
+            { "frames", 1 + i % 16 },
+            { "columns", 4 },
+            { "durationMs", 50 + i % 100 },
+            { "looping", i % 3 != 0 } });
+        }
+    j["selectedAnimationIndex"] = -1;
+
+    BenchmarkProjectAllocations(j);
+    BenchmarkMipChain();
+    BenchmarkNameSearch();
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Only links the header only runtime reader, the export is written here with the layout of sprite_uv/binary_format.hpp
+
+#include <sprite_uv/runtime.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int32_t  NUM_ANIMATIONS{ 10000 };
+constexpr int32_t  NUM_ITERATIONS{ 10'000'000 };
+constexpr uint32_t TEXTURE_SIZE{ 4096 };
+constexpr uint32_t FRAME_SIZE{ 32 };
+constexpr uint32_t COLUMNS{ 4 };
+
+using Clock = std::chrono::steady_clock;
+
+void
+Report(const char* name, Clock::time_point start, int64_t operations, uint64_t sink)
+{
+    const double seconds{ std::chrono::duration<double>(Clock::now() - start).count() };
+    std::printf("%-24s %12.0f ops/s  (%.2f ns/op, sink %llu)\n", name, operations / seconds, seconds * 1e9 / operations, static_cast<unsigned long long>(sink));
+}
+
+/**
+ * \brief Same animations as the synthetic editor project, 32x32 frames on 4 columns of a 4096x4096 sprite.
+ * The sections are copied as they are in memory, the benchmark hosts are little endian.
+ */
+std::vector<uint8_t>
+BuildSyntheticExport(const std::vector<std::string>& names)
+{
+    using namespace sprite_uv::binary;
+
+    std::vector<BinaryAnimation> animations{};
+    std::vector<BinaryFrameUv>   frames{};
+    std::vector<uint32_t>        durations{};
+    std::string                  strings{};
+    for (uint32_t i{}; i < names.size(); ++i)
+        {
+            const uint32_t  frameCount{ 1 + i % 16 };
+            const uint32_t  durationMs{ 50 + i % 100 };
+            BinaryAnimation animation{};
+            animation.NameOffset      = static_cast<uint32_t>(strings.size());
+            animation.NameLength      = static_cast<uint32_t>(names[i].size());
+            animation.NameHash        = HashName(names[i]);
+            animation.FirstFrame      = static_cast<uint32_t>(frames.size());
+            animation.FrameCount      = frameCount;
+            animation.Flags           = i % 3 != 0 ? EAnimationFlags::LOOPING : 0u;
+            animation.TotalDurationMs = frameCount * durationMs;
+            animations.push_back(animation);
+            for (uint32_t f{}; f < frameCount; ++f)
+                {
+                    const float x{ static_cast<float>((i % 64) * FRAME_SIZE + (f % COLUMNS) * FRAME_SIZE) / TEXTURE_SIZE };
+                    const float y{ static_cast<float>((i / 64) * FRAME_SIZE + (f / COLUMNS) * FRAME_SIZE) / TEXTURE_SIZE };
+                    const float size{ static_cast<float>(FRAME_SIZE) / TEXTURE_SIZE };
+                    frames.push_back({ x, y, x + size, y + size });
+                    durations.push_back(durationMs);
+                }
+            strings += names[i];
+            strings += '\0';
+        }
+
+    const auto                     animationCount{ static_cast<uint32_t>(animations.size()) };
+    const auto                     frameCount{ static_cast<uint32_t>(frames.size()) };
+    const auto                     lookupCapacity{ LookupCapacityFor(animationCount) };
+    std::vector<BinaryLookupEntry> lookup(lookupCapacity, BinaryLookupEntry{ 0, EMPTY_LOOKUP_INDEX });
+    for (uint32_t i{}; i < animationCount; ++i)
+        {
+            uint32_t slot{ animations[i].NameHash & (lookupCapacity - 1) };
+            while (lookup[slot].AnimationIndex != EMPTY_LOOKUP_INDEX)
+                {
+                    slot = (slot + 1) & (lookupCapacity - 1);
+                }
+            lookup[slot] = { animations[i].NameHash, i };
+        }
+
+    BinaryHeader header{};
+    std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+    header.Version           = VERSION;
+    header.TextureWidth      = TEXTURE_SIZE;
+    header.TextureHeight     = TEXTURE_SIZE;
+    header.AnimationCount    = animationCount;
+    header.FrameCount        = frameCount;
+    header.LookupCapacity    = lookupCapacity;
+    header.AnimationsOffset  = AlignUp(sizeof(BinaryHeader));
+    header.FramesOffset      = AlignUp(header.AnimationsOffset + animationCount * sizeof(BinaryAnimation));
+    header.DurationsOffset   = AlignUp(header.FramesOffset + frameCount * sizeof(BinaryFrameUv));
+    header.LookupOffset      = AlignUp(header.DurationsOffset + frameCount * sizeof(uint32_t));
+    header.StringTableOffset = AlignUp(header.LookupOffset + lookupCapacity * sizeof(BinaryLookupEntry));
+    header.StringTableSize   = static_cast<uint32_t>(strings.size());
+    header.FileSize          = AlignUp(header.StringTableOffset + header.StringTableSize);
+
+    std::vector<uint8_t> buffer(header.FileSize, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + header.AnimationsOffset, animations.data(), animations.size() * sizeof(BinaryAnimation));
+    std::memcpy(buffer.data() + header.FramesOffset, frames.data(), frames.size() * sizeof(BinaryFrameUv));
+    std::memcpy(buffer.data() + header.DurationsOffset, durations.data(), durations.size() * sizeof(uint32_t));
+    std::memcpy(buffer.data() + header.LookupOffset, lookup.data(), lookup.size() * sizeof(BinaryLookupEntry));
+    std::memcpy(buffer.data() + header.StringTableOffset, strings.data(), strings.size());
+    return buffer;
+}
+}
+
+int
+main()
+{
+    std::vector<std::string> names{};
+    for (int32_t i{}; i < NUM_ANIMATIONS; ++i)
+        {
+            names.push_back("Animation_" + std::to_string(i));
+        }
+
+    const auto bytes{ BuildSyntheticExport(names) };
+    const auto path{ std::filesystem::temp_directory_path() / "runtime_benchmark.uvb" };
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    sprite_uv::MappedFile file{};
+    if (!file.Open(path.string().c_str()))
+        {
+            std::printf("Failed to map %s\n", path.string().c_str());
+            return 1;
+        }
+    const auto set{ sprite_uv::AnimationSet::FromMemory(file.Data(), file.Size()) };
+    if (!set.has_value())
+        {
+            std::printf("Invalid export\n");
+            return 1;
+        }
+    std::printf("%d animations, %zu bytes\n", NUM_ANIMATIONS, file.Size());
+
+    std::vector<uint32_t> hashes{};
+    for (const auto& name : names)
+        {
+            hashes.push_back(sprite_uv::HashName(name));
+        }
+
+    {
+        uint64_t   sink{};
+        const auto start{ Clock::now() };
+        for (int32_t i{}; i < NUM_ITERATIONS; ++i)
+            {
+                sink += set->Find(names[i % NUM_ANIMATIONS])->FirstFrame;
+            }
+        Report("Find(name)", start, NUM_ITERATIONS, sink);
+    }
+
+    {
+        uint64_t   sink{};
+        const auto start{ Clock::now() };
+        for (int32_t i{}; i < NUM_ITERATIONS; ++i)
+            {
+                sink += set->FindByHash(hashes[i % NUM_ANIMATIONS])->FirstFrame;
+            }
+        Report("FindByHash(hash)", start, NUM_ITERATIONS, sink);
+    }
+
+    {
+        const auto animations{ set->GetAnimations() };
+        uint64_t   sink{};
+        const auto start{ Clock::now() };
+        for (int32_t i{}; i < NUM_ITERATIONS; ++i)
+            {
+                sink += static_cast<uint64_t>(set->Sample(animations[i % NUM_ANIMATIONS], i).U0 * 4096.f);
+            }
+        Report("Sample(animation, t)", start, NUM_ITERATIONS, sink);
+    }
+
+    file.Close();
+    std::filesystem::remove(path);
+    return 0;
+}
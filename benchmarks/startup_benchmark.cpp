@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Time to first frame of the editor, launched as a process per run since the startup is what is measured.
+// The first run starts from an empty cache directory thus rasterizes the font, the next ones upload the cached atlas.
+// Needs a display like the editor itself.
+namespace
+{
+constexpr int32_t DEFAULT_NUM_RUNS{ 10 };
+
+struct StartupRun
+{
+    double Window{};
+    double Font{};
+    double FirstFrame{};
+    double Deferred{};
+    bool   FontCached{};
+};
+
+std::optional<StartupRun>
+LaunchEditor(const std::filesystem::path& cacheDirectory, const std::filesystem::path& reportPath)
+{
+    std::error_code errorCode{};
+    std::filesystem::remove(reportPath, errorCode);
+    const std::string command{ "\"" SPRITE_UV_EDITOR_PATH "\" --image-cache \"" + cacheDirectory.string() + "\" --startup-report \"" + reportPath.string() + "\"" };
+    if (std::system(command.c_str()) != 0)
+        {
+            return {};
+        }
+
+    std::ifstream fileStream{ reportPath };
+    const auto    report{ nlohmann::json::parse(fileStream, nullptr, false) };
+    if (report.is_discarded())
+        {
+            return {};
+        }
+    StartupRun run{};
+    run.Window     = report.value("window_ms", 0.0);
+    run.Font       = report.value("font_ms", 0.0);
+    run.FirstFrame = report.value("first_frame_ms", 0.0);
+    run.Deferred   = report.value("deferred_ms", 0.0);
+    run.FontCached = report.value("font_cached", false);
+    return run;
+}
+
+void
+Print(const char* name, const StartupRun& run)
+{
+    std::printf("%-10s first frame %8.2f ms  (window %7.2f ms, font %6.2f ms %s, deferred %6.2f ms)\n", name, run.FirstFrame, run.Window, run.Font,
+                run.FontCached ? "cached" : "rasterized", run.Deferred);
+}
+}
+
+int
+main(int argc, char** argv)
+{
+    const int32_t   numRuns{ argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_NUM_RUNS };
+    const auto      workDirectory{ std::filesystem::temp_directory_path() / "sprite_uv_startup_benchmark" };
+    const auto      cacheDirectory{ workDirectory / "cache" };
+    const auto      reportPath{ workDirectory / "startup.json" };
+    std::error_code errorCode{};
+    std::filesystem::remove_all(workDirectory, errorCode);
+    std::filesystem::create_directories(workDirectory, errorCode);
+
+    const auto coldRun{ LaunchEditor(cacheDirectory, reportPath) };
+    if (!coldRun.has_value())
+        {
+            std::printf("Failed to launch %s\n", SPRITE_UV_EDITOR_PATH);
+            return 1;
+        }
+    Print("cold", coldRun.value());
+
+    std::vector<StartupRun> warmRuns{};
+    for (int32_t i{}; i < numRuns; ++i)
+        {
+            if (const auto run{ LaunchEditor(cacheDirectory, reportPath) }; run.has_value())
+                {
+                    warmRuns.push_back(run.value());
+                }
+        }
+    if (warmRuns.empty())
+        {
+            std::printf("No warm run succeeded\n");
+            return 1;
+        }
+    std::sort(warmRuns.begin(), warmRuns.end(), [](const StartupRun& a, const StartupRun& b) { return a.FirstFrame < b.FirstFrame; });
+    Print("warm min", warmRuns.front());
+    Print("warm med", warmRuns[warmRuns.size() / 2]);
+    Print("warm max", warmRuns.back());
+
+    std::filesystem::remove_all(workDirectory, errorCode);
+    return 0;
+}
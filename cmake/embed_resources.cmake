@@ -0,0 +1,43 @@
+# -------------------------------------------------
+# Generates a C++ source holding the content files as byte arrays, run at build time:
+# cmake -DCONTENT_DIR=<dir> -DRESOURCES=<path|path|...> -DOUTPUT=<file.cpp> -P embed_resources.cmake
+# The paths are relative to CONTENT_DIR and are the names the editor looks the resources up with.
+# -------------------------------------------------
+string(REPLACE "|" ";" RESOURCES "${RESOURCES}")
+
+set(arrays "")
+set(entries "")
+set(index 0)
+foreach(resource IN LISTS RESOURCES)
+    file(READ "${CONTENT_DIR}/${resource}" hex HEX)
+    file(SIZE "${CONTENT_DIR}/${resource}" size)
+    # 32 bytes per line
+    string(REGEX REPLACE "(................................................................)" "\\1\n" hex "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," hex "${hex}")
+    string(APPEND arrays "// ${resource}\nconst uint8_t RESOURCE_${index}[]{\n${hex}\n};\n\n")
+    string(APPEND entries "    { \"${resource}\", RESOURCE_${index}, ${size} },\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+set(content "// Generated from the content folder by cmake/embed_resources.cmake, do not edit
+#include \"embedded_resources.hpp\"
+
+namespace
+{
+${arrays}}
+
+namespace resources
+{
+extern const Resource EMBEDDED_RESOURCES[]{
+${entries}};
+extern const size_t NUM_EMBEDDED_RESOURCES{ ${index} };
+}
+")
+
+# Rewritten only when it changes, so touching a resource without changing it does not rebuild the editor
+if (EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+endif()
+if (NOT previous STREQUAL content)
+    file(WRITE "${OUTPUT}" "${content}")
+endif()
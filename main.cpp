@@ -26,23 +26,65 @@ SOFTWARE.
 #define RAYGUI_IMPLEMENTATION
 #endif
 
+#include "raylib.h"
+
+#include "input.hpp"
+
+// raygui reads the input straight from raylib, redirected for its implementation so replayed sessions drive the widgets too
+#define GetMousePosition input::GetMousePosition
+#define GetMouseWheelMove input::GetMouseWheelMove
+#define GetMouseWheelMoveV input::GetMouseWheelMoveV
+#define IsMouseButtonDown input::IsMouseButtonDown
+#define IsMouseButtonPressed input::IsMouseButtonPressed
+#define IsMouseButtonReleased input::IsMouseButtonReleased
+#define IsKeyDown input::IsKeyDown
+#define IsKeyPressed input::IsKeyPressed
+#define IsKeyPressedRepeat input::IsKeyPressedRepeat
+#define GetKeyPressed input::GetKeyPressed
+#define GetCharPressed input::GetCharPressed
 #include "raygui.h"
+#undef GetMousePosition
+#undef GetMouseWheelMove
+#undef GetMouseWheelMoveV
+#undef IsMouseButtonDown
+#undef IsMouseButtonPressed
+#undef IsMouseButtonReleased
+#undef IsKeyDown
+#undef IsKeyPressed
+#undef IsKeyPressedRepeat
+#undef GetKeyPressed
+#undef GetCharPressed
+
 #include "rlgl.h"
 
 #include "app.hpp"
+#include "batch.hpp"
 #include "definitions.hpp"
 #include "drawing.hpp"
+#include "export.hpp"
 #include "geometry.hpp"
+#include "hot_reload.hpp"
+#include "image_cache.hpp"
+#include "memory_stats.hpp"
+#include "profiler.hpp"
 #include "project.hpp"
+#include "server.hpp"
+#include "text_layout.hpp"
+#include "texture_cache.hpp"
+#include "uv_remap.hpp"
+#include "validation.hpp"
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 
@@ -64,10 +106,24 @@ EModalType ActiveModal{ EModalType::NONE };
  */
 View defaultView{};
 View view{};
+/**
+ * \brief Drives all the animation previews.
+ */
+AnimationClock animationClock{};
 /**
  * \brief Current loaded project - must always be valid ptr.
  */
 std::unique_ptr<Project> CP{ std::make_unique<Project>() };
+/**
+ * \brief Set by the value and text boxes drawn in edit mode during the GUI pass.
+ * The keyboard shortcuts run before the GUI thus read the state of the previous frame.
+ */
+bool GuiBoxInEditMode{ false };
+/**
+ * \brief Frame checks of the current project, only the edited animations are checked again.
+ * Must be reset along with the project.
+ */
+FrameValidator frameValidator{};
 
 #pragma region Helpers
 void
@@ -76,10 +132,14 @@ ResetViewToDefault()
     view = defaultView;
 }
 
+/**
+ * \brief The raygui GetTextWidth of a label without icon plus padding, laid out once per font and style.
+ */
 float
-GetStringWidth(const std::string& str)
+GetStringWidth(std::string_view str)
 {
-    return static_cast<float>(GetTextWidth(str.c_str()) + PAD);
+    const TextRun& run{ TextLayoutCache::Shared().GetRun(GuiGetFont(), static_cast<float>(GuiGetStyle(DEFAULT, TEXT_SIZE)), static_cast<float>(GuiGetStyle(DEFAULT, TEXT_SPACING)), str) };
+    return static_cast<float>(static_cast<int>(run.Advance) + PAD);
 }
 
 bool
@@ -91,23 +151,39 @@ NumericBox(Rectangle rect, char* const name, int* value, int min, int max, bool&
     rect.x += textW;
     rect.width -= textW;
 
-    // Add plus/minus buttons
+    // Typing in the value box is one edit however long it takes
+    if (active)
+        {
+            CP->UpdateTransaction(input::GetTime());
+            GuiBoxInEditMode = true;
+        }
+
+    // Add plus/minus buttons, repeated clicks on the same box coalesce into one undo step
     if (GuiButton({ rect.x + rect.width - 30, rect.y, 30, rect.height / 2.f }, "+"))
         {
+            // Opened before the edit, it commits the edit of another widget first
+            CP->BeginTransaction(value, input::GetTime());
             *value = std::min(*value + step, max);
-            CP->CommitNewAction();
             return true;
         }
     if (GuiButton({ rect.x + rect.width - 30, rect.y + rect.height / 2.f, 30, rect.height / 2.f }, "-"))
         {
+            CP->BeginTransaction(value, input::GetTime());
             *value = std::max(*value - step, min);
-            CP->CommitNewAction();
             return true;
         }
     if (GuiValueBox({ rect.x, rect.y, rect.width - 30, rect.height }, name, value, std::min(min, max), std::max(min, max), active))
         {
             active = !active;
-            CP->CommitNewAction();
+            if (active)
+                {
+                    CP->BeginTransaction(value, input::GetTime());
+                }
+            else
+                {
+                    CP->CommitTransaction();
+                }
+            GuiBoxInEditMode = GuiBoxInEditMode || active;
             return true;
         }
 
@@ -120,9 +196,11 @@ StringBox(Rectangle rect, char* const name, int strSize, bool& active)
     if (GuiTextBox({ rect.x, rect.y, rect.width, rect.height }, name, strSize, active))
         {
             active = !active;
+            GuiBoxInEditMode = GuiBoxInEditMode || active;
             return true;
         }
 
+    GuiBoxInEditMode = GuiBoxInEditMode || active;
     return false;
 }
 
@@ -133,6 +211,263 @@ TextRect(Rectangle rect, const char* const str)
     GuiDrawText(str, { rect.x + 10, rect.y + rect.height * .5f, GetStringWidth(str), 0.f }, 1, DARKGRAY);
 }
 
+bool
+IsControlDown()
+{
+    return input::IsKeyDown(KEY_LEFT_CONTROL) || input::IsKeyDown(KEY_RIGHT_CONTROL);
+}
+
+bool
+IsShiftDown()
+{
+    return input::IsKeyDown(KEY_LEFT_SHIFT) || input::IsKeyDown(KEY_RIGHT_SHIFT);
+}
+
+/**
+ * \brief A click on the list or the gallery: ctrl toggles the animation, shift extends from the active one, a plain click selects only it.
+ */
+void
+ClickAnimation(int32_t listIndex)
+{
+    if (IsControlDown())
+        {
+            CP->ToggleSelected(listIndex);
+        }
+    else if (IsShiftDown())
+        {
+            CP->SelectRange(listIndex);
+        }
+    else
+        {
+            CP->SelectOnly(listIndex);
+        }
+}
+
+/**
+ * \brief Selects the animations of the page whose rect touches the image space rect.
+ */
+void
+SelectAnimationsInRect(Rectangle imageRect, int32_t page, bool keepSelection)
+{
+    std::vector<int32_t> hits{};
+    for (int32_t i{}; i < static_cast<int32_t>(CP->ImmutableTransientAnimations.size()); ++i)
+        {
+            const auto* spriteSheet{ std::get_if<SpritesheetUv>(&CP->ImmutableTransientAnimations[i]->second.Data) };
+            if (spriteSheet && spriteSheet->Property_Page.Value == page && CheckCollisionRecs(imageRect, to::Rectangle_(spriteSheet->Uv)))
+                {
+                    hits.push_back(i);
+                }
+        }
+    if (hits.empty())
+        {
+            return;
+        }
+    if (!keepSelection)
+        {
+            CP->SelectOnly(hits.front());
+        }
+    CP->AddToSelection(hits);
+}
+
+/**
+ * \brief The page shown on the canvas, the one of the selected animation.
+ */
+int32_t
+GetSelectedAnimationPage()
+{
+    const auto& animations{ CP->ImmutableTransientAnimations };
+    if (CP->ListState.activeIndex < 0 || CP->ListState.activeIndex >= static_cast<int32_t>(animations.size()))
+        {
+            return 0;
+        }
+    const auto& animationData{ animations[CP->ListState.activeIndex]->second };
+    return std::holds_alternative<SpritesheetUv>(animationData.Data) ? std::get<SpritesheetUv>(animationData.Data).Property_Page.Value : 0;
+}
+
+/**
+ * \brief Feeds the current animations to the frame validator, cheap when nothing changed.
+ * Only page 0 has CPU pixels, the empty frame checks of the other pages are skipped.
+ */
+void
+UpdateFrameValidator()
+{
+    PROFILE_SCOPE("Validation");
+    static std::vector<std::string_view> names{};
+    static std::vector<FrameLayout>      layouts{};
+    names.assign(CP->ImmutableTransientAnimationNames.begin(), CP->ImmutableTransientAnimationNames.end());
+    layouts.clear();
+    layouts.reserve(CP->ImmutableTransientAnimations.size());
+    for (const auto it : CP->ImmutableTransientAnimations)
+        {
+            const auto* spriteSheet{ std::get_if<SpritesheetUv>(&it->second.Data) };
+            layouts.push_back(spriteSheet ? FrameLayout{ spriteSheet->Uv, spriteSheet->Property_NumOfFrames.Value, spriteSheet->Property_Columns.Value, spriteSheet->Property_Page.Value }
+                                          : FrameLayout{});
+        }
+
+    std::vector<PagePixels> pagePixels{};
+    if (CP->SpriteImage.has_value())
+        {
+            pagePixels.push_back({ static_cast<const uint8_t*>(CP->SpriteImage->data), CP->SpriteImage->width, CP->SpriteImage->height });
+        }
+    frameValidator.Update(names, layouts, CP->GetPageSizes(), pagePixels, CP->SpriteImageVersion);
+}
+
+/**
+ * \brief Outlines the frames of the page with issues, culled to the canvas viewport.
+ */
+void
+DrawFrameAnnotations(int32_t page)
+{
+    PROFILE_SCOPE("Frame annotations");
+    const Rectangle viewport{ 0, 0, static_cast<float>(input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH), static_cast<float>(input::GetRenderHeight()) };
+    for (const FrameAnnotation& annotation : frameValidator.GetAnnotations())
+        {
+            if (annotation.Page != page)
+                {
+                    continue;
+                }
+            const Rectangle rect{ view.TransformRect(to::Rectangle_(annotation.Bounds)) };
+            if (!CheckCollisionRecs(rect, viewport))
+                {
+                    continue;
+                }
+            switch (annotation.Issue)
+                {
+                    case EFrameIssue::OUTSIDE_PAGE: DrawRectangleLinesEx(rect, 2.f, RED); break;
+                    case EFrameIssue::OVERLAP: DrawRectangleLinesEx(rect, 2.f, ORANGE); break;
+                    case EFrameIssue::EMPTY: DrawRectangleLinesEx(rect, 1.f, LIGHTGRAY); break;
+                }
+        }
+}
+
+/**
+ * \brief Catches the name index up with the interned names, the new names are measured once per font and style.
+ */
+void
+SyncAnimationNameIndex()
+{
+    const size_t numOfSymbols{ CP->AnimationNames.GetNumSymbols() };
+    while (CP->AnimationNameIndex.GetSize() < numOfSymbols)
+        {
+            CP->AnimationNameIndex.Add(CP->AnimationNames.GetView({ static_cast<uint32_t>(CP->AnimationNameIndex.GetSize()) }));
+        }
+
+    // The widths follow the GUI font and style, the names would flood the layout cache thus they are kept here
+    TextLayoutCache& textCache{ TextLayoutCache::Shared() };
+    static uint32_t  widthsGeneration{ textCache.GetGeneration() };
+    if (widthsGeneration != textCache.GetGeneration())
+        {
+            widthsGeneration = textCache.GetGeneration();
+            CP->AnimationNameWidths.clear();
+        }
+    const Font  font{ GuiGetFont() };
+    const float fontSize{ static_cast<float>(GuiGetStyle(DEFAULT, TEXT_SIZE)) };
+    const float spacing{ static_cast<float>(GuiGetStyle(DEFAULT, TEXT_SPACING)) };
+    for (size_t id{ CP->AnimationNameWidths.size() }; id < numOfSymbols; ++id)
+        {
+            const TextRun run{ textCache.LayoutUncached(font, fontSize, spacing, CP->AnimationNames.GetView({ static_cast<uint32_t>(id) })) };
+            CP->AnimationNameWidths.push_back(static_cast<float>(static_cast<int>(run.Advance) + PAD));
+        }
+}
+
+/**
+ * \brief The list indices of the animations matching the list filter, in list order.
+ */
+const std::vector<int32_t>&
+FilterAnimationList()
+{
+    static std::vector<int32_t> rows{};
+    static std::vector<uint8_t> matched{};
+    const int32_t               numOfItems{ static_cast<int32_t>(CP->ImmutableTransientAnimations.size()) };
+    rows.clear();
+    if (CP->ListState.Filter[0] == '\0')
+        {
+            rows.resize(numOfItems);
+            std::iota(rows.begin(), rows.end(), 0);
+            return rows;
+        }
+
+    // The index knows every name ever interned, the renamed and deleted ones are dropped here
+    matched.assign(CP->AnimationNames.GetNumSymbols(), 0);
+    for (const uint32_t id : CP->AnimationNameIndex.Search(CP->ListState.Filter))
+        {
+            matched[id] = 1;
+        }
+    for (int32_t i{}; i < numOfItems; ++i)
+        {
+            if (matched[CP->ImmutableTransientAnimations[i]->first.Id])
+                {
+                    rows.push_back(i);
+                }
+        }
+    return rows;
+}
+
+/**
+ * \brief Draws only the rows of the animation list in view, the rows are list indices.
+ * The hovered row becomes the focus index, the clicks are resolved by the caller.
+ */
+void
+DrawAnimationList(Rectangle bounds, const std::vector<int32_t>& rows, ListSelection& state)
+{
+    const float   itemH{ static_cast<float>(GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT)) };
+    const float   itemSpacing{ static_cast<float>(GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING)) };
+    const float   border{ static_cast<float>(GuiGetStyle(DEFAULT, BORDER_WIDTH)) };
+    const int32_t numOfRows{ static_cast<int32_t>(rows.size()) };
+    const int32_t visibleRows{ std::max(1, static_cast<int32_t>((bounds.height - border * 2) / (itemH + itemSpacing))) };
+    const int32_t maxScroll{ std::max(0, numOfRows - visibleRows) };
+    const float   scrollBarW{ maxScroll > 0 ? static_cast<float>(GuiGetStyle(LISTVIEW, SCROLLBAR_WIDTH)) : 0.f };
+    const bool    hovered{ !GuiIsLocked() && CheckCollisionPointRec(input::GetMousePosition(), bounds) };
+    if (hovered)
+        {
+            state.scrollIndex -= static_cast<int32_t>(input::GetMouseWheelMove());
+        }
+    state.scrollIndex = std::clamp(state.scrollIndex, 0, maxScroll);
+
+    GuiDrawRectangle(bounds, static_cast<int>(border), GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_NORMAL)), GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+    state.focusIndex = -1;
+    const int32_t lastRow{ std::min(numOfRows, state.scrollIndex + visibleRows) };
+    for (int32_t row{ state.scrollIndex }; row < lastRow; ++row)
+        {
+            const int32_t   index{ rows[row] };
+            const Rectangle itemRect{ bounds.x + border + itemSpacing, bounds.y + border + itemSpacing + (row - state.scrollIndex) * (itemH + itemSpacing),
+                                      bounds.width - (border + itemSpacing) * 2 - scrollBarW, itemH };
+            const bool      focused{ hovered && CheckCollisionPointRec(input::GetMousePosition(), itemRect) };
+            state.focusIndex = focused ? index : state.focusIndex;
+
+            // The active row is drawn pressed, the other selected rows are tinted, the style colors come in normal, focused, pressed triples
+            const int32_t itemState{ index == state.activeIndex ? STATE_PRESSED : focused ? STATE_FOCUSED : STATE_NORMAL };
+            if (itemState != STATE_NORMAL)
+                {
+                    GuiDrawRectangle(itemRect, 1, GetColor(GuiGetStyle(LISTVIEW, BORDER_COLOR_NORMAL + itemState * 3)), GetColor(GuiGetStyle(LISTVIEW, BASE_COLOR_NORMAL + itemState * 3)));
+                }
+            else if (CP->IsSelected(index))
+                {
+                    DrawRectangleRec(itemRect, Fade(SKYBLUE, .4f));
+                }
+            GuiDrawText(CP->ImmutableTransientAnimationNames[index], itemRect, GuiGetStyle(LISTVIEW, TEXT_ALIGNMENT), GetColor(GuiGetStyle(LISTVIEW, TEXT_COLOR_NORMAL + itemState * 3)));
+        }
+
+    if (maxScroll > 0)
+        {
+            const Rectangle scrollBarRect{ bounds.x + bounds.width - border - scrollBarW, bounds.y + border, scrollBarW, bounds.height - border * 2 };
+            state.scrollIndex = GuiScrollBar(scrollBarRect, state.scrollIndex, 0, maxScroll);
+        }
+}
+
+const char*
+ToString(EPageResidency residency)
+{
+    switch (residency)
+        {
+            case EPageResidency::NOT_LOADED: return "-";
+            case EPageResidency::LOADING: return "loading";
+            case EPageResidency::RESIDENT: return "resident";
+            case EPageResidency::FAILED: return "failed";
+        }
+    return "";
+}
+
 template<typename T>
 void
 RoundTo(T& value, int grid, bool round)
@@ -141,8 +476,202 @@ RoundTo(T& value, int grid, bool round)
         value = std::round(value / std::max(1, grid)) * grid;
 }
 
+
+/**
+ * \brief The command line options, every option takes a value.
+ */
+struct CommandLine
+{
+    std::string             RecordPath{};
+    std::string             ReplayPath{};
+    std::string             TimingsPath{ "replay_timings.csv" };
+    /**
+     * \brief Batch mode when it has inputs, no window is opened.
+     */
+    batch::Options          Batch{};
+    /**
+     * \brief Server mode when it has a socket path, --jobs sizes both modes.
+     */
+    server::Options         Server{};
+    /**
+     * \brief The decoded image cache, the user cache directory by default. A zero budget disables it.
+     */
+    std::string             ImageCacheDirectory{};
+    std::optional<uint64_t> ImageCacheBudgetBytes{};
+    /**
+     * \brief The startup timings are written there after the first frame, then the editor quits.
+     */
+    std::string             StartupReportPath{};
+    /**
+     * \brief Filter of the mip levels of the sprite and the pages, none uploads them without.
+     */
+    EMipFilter              MipFilter{ EMipFilter::BOX };
+    bool                    Valid{ true };
+};
+
+CommandLine
+ParseCommandLine(int argc, char** argv)
+{
+    CommandLine commandLine{};
+    for (int32_t i{ 1 }; i < argc; i += 2)
+        {
+            const std::string_view option{ argv[i] };
+            if (i + 1 == argc)
+                {
+                    std::cout << "Missing value for option " << option << std::endl;
+                    commandLine.Valid = false;
+                }
+            else if (option == "--record")
+                {
+                    commandLine.RecordPath = argv[i + 1];
+                }
+            else if (option == "--replay")
+                {
+                    commandLine.ReplayPath = argv[i + 1];
+                }
+            else if (option == "--timings")
+                {
+                    commandLine.TimingsPath = argv[i + 1];
+                }
+            else if (option == "--batch")
+                {
+                    commandLine.Batch.Inputs.emplace_back(argv[i + 1]);
+                }
+            else if (option == "--export")
+                {
+                    const auto exports{ batch::ParseExportFormats(argv[i + 1]) };
+                    if (!exports.has_value())
+                        {
+                            std::cout << "Unknown export format in " << argv[i + 1] << ", expected json, binary, header, compact, bc1, bc3 or indexed, bc1 and bc3 are exclusive" << std::endl;
+                            commandLine.Valid = false;
+                        }
+                    commandLine.Batch.Exports = exports.value_or(0);
+                }
+            else if (option == "--jobs")
+                {
+                    commandLine.Batch.NumThreads  = static_cast<size_t>(std::max(0, std::atoi(argv[i + 1])));
+                    commandLine.Server.NumThreads = commandLine.Batch.NumThreads;
+                }
+            else if (option == "--serve")
+                {
+                    commandLine.Server.SocketPath = argv[i + 1];
+                }
+            else if (option == "--report")
+                {
+                    commandLine.Batch.ReportPath = argv[i + 1];
+                }
+            else if (option == "--cache")
+                {
+                    commandLine.Batch.CachePath = argv[i + 1];
+                }
+            else if (option == "--image-cache")
+                {
+                    commandLine.ImageCacheDirectory = argv[i + 1];
+                }
+            else if (option == "--image-cache-mb")
+                {
+                    commandLine.ImageCacheBudgetBytes = static_cast<uint64_t>(std::max(0, std::atoi(argv[i + 1]))) * 1024 * 1024;
+                }
+            else if (option == "--startup-report")
+                {
+                    commandLine.StartupReportPath = argv[i + 1];
+                }
+            else if (option == "--mip-filter")
+                {
+                    const std::string_view filter{ argv[i + 1] };
+                    if (filter == "none")
+                        {
+                            commandLine.MipFilter = EMipFilter::NONE;
+                        }
+                    else if (filter == "box")
+                        {
+                            commandLine.MipFilter = EMipFilter::BOX;
+                        }
+                    else if (filter == "lanczos")
+                        {
+                            commandLine.MipFilter = EMipFilter::LANCZOS;
+                        }
+                    else
+                        {
+                            std::cout << "Unknown mip filter " << filter << ", expected none, box or lanczos" << std::endl;
+                            commandLine.Valid = false;
+                        }
+                }
+            else
+                {
+                    std::cout << "Unknown option " << option << std::endl;
+                    commandLine.Valid = false;
+                }
+        }
+    return commandLine;
+}
 #pragma endregion Helpers
 
+#if defined(SPRITE_UV_PROFILER)
+/**
+ * \brief Render batch owned by the editor so its draw calls can be counted before each flush.
+ */
+rlRenderBatch         profilerRenderBatch{};
+profiler::RenderStats frameRenderStats{};
+
+/**
+ * \brief Must be called right before the batch gets flushed (scissor changes, EndDrawing).
+ * Flushes raylib does by itself when the batch is full are not seen.
+ */
+void
+CountRenderBatch()
+{
+    for (int32_t i{}; i < profilerRenderBatch.drawCounter; ++i)
+        {
+            if (profilerRenderBatch.draws[i].vertexCount > 0)
+                {
+                    ++frameRenderStats.DrawCalls;
+                    frameRenderStats.Vertices += profilerRenderBatch.draws[i].vertexCount;
+                }
+        }
+}
+#define PROFILE_COUNT_RENDER_BATCH() CountRenderBatch()
+#else
+#define PROFILE_COUNT_RENDER_BATCH() ((void)0)
+#endif
+
+/**
+ * \brief Nearest filtering while a texel covers at least a screen pixel, trilinear over the mip levels when zoomed out.
+ * The filter applies to the draws already batched with the texture, the batch is flushed first when it changes.
+ */
+void
+SetTextureFilterForScale(const Texture2D& texture, float scale)
+{
+    const int32_t filter{ scale < 1.f && texture.mipmaps > 1 ? TEXTURE_FILTER_TRILINEAR : TEXTURE_FILTER_POINT };
+    if (GetTextureFilter(texture) == filter)
+        {
+            return;
+        }
+    PROFILE_COUNT_RENDER_BATCH();
+    rlDrawRenderBatchActive();
+    SetTrackedTextureFilter(texture, filter);
+}
+
+#pragma region Memory
+constexpr double      MEMORY_REFRESH_SECONDS{ .5 };
+constexpr double      MEMORY_LOG_SECONDS{ 60. };
+constexpr const char* MEMORY_LOG_PATH{ "sprite_uv_memory.jsonl" };
+
+MemoryReport
+CollectMemoryReport(const App& app, const HotReloader& hotReloader)
+{
+    MemoryReport report{};
+    app.ReportMemory(report);
+    CP->ReportMemory(report);
+    hotReloader.ReportMemory(report);
+    report.Add("gui/text_layout", TextLayoutCache::Shared().GetBytes(), static_cast<int64_t>(TextLayoutCache::Shared().GetNumRuns()));
+#if defined(SPRITE_UV_PROFILER)
+    report.Add("profiler/rings", profiler::GetBufferBytes());
+#endif
+    return report;
+}
+#pragma endregion Memory
+
 void
 DrawSpritesheetUvProperties(Rectangle rect, SpritesheetUv& p)
 {
@@ -156,6 +685,7 @@ DrawSpritesheetUvProperties(Rectangle rect, SpritesheetUv& p)
     static char lblFrames[]        = "Frames: ";
     static char lblColumns[]       = "Columns: ";
     static char lblFrameDuration[] = "Frame duration ms: ";
+    static char lblPage[]          = "Page: ";
 
     // Draw UV Rect
     {
@@ -201,100 +731,35 @@ DrawSpritesheetUvProperties(Rectangle rect, SpritesheetUv& p)
     (void)(NumericBox(rect, lblFrameDuration, &p.Property_FrameDurationMs.Value, 0, INT32_MAX, p.Property_FrameDurationMs.ActiveBox));
     rect.y += 30 + PAD;
 
-    if (CP->SpriteTexture.has_value())
+    // Texture page
+    (void)(NumericBox(rect, lblPage, &p.Property_Page.Value, 0, CP->GetNumPages() - 1, p.Property_Page.ActiveBox));
+    rect.y += 30 + PAD;
+
+    if (const Texture2D* pageTexture{ CP->AcquirePageTexture(p.Property_Page.Value) })
         {
             // Draw preview animation frame
             const Rectangle previewRect{ rect.x, rect.y, rect.width, rect.width };
-
-            Rectangle spriteRect{ previewRect };
-            // Make the sprite rect fit inside preview rect maintaining aspect ratio
-            if (p.Uv.w > p.Uv.h)
-                {
-                    const auto spriteAspectRatio = p.Uv.h / (float)p.Uv.w;
-                    spriteRect.width             = previewRect.width;
-                    spriteRect.height            = previewRect.width * spriteAspectRatio;
-                }
-            else
-                {
-                    const auto spriteAspectRatio = p.Uv.w / (float)p.Uv.h;
-                    spriteRect.height            = previewRect.height;
-                    spriteRect.width             = previewRect.height * spriteAspectRatio;
-                }
-            // Center the sprite
-            {
-                spriteRect.x += (previewRect.width - spriteRect.width) * .5f;
-                spriteRect.y += (previewRect.height - spriteRect.height) * .5f;
-            }
+            const Rectangle spriteRect{ FitRectKeepAspect(previewRect, p.Uv.w, p.Uv.h) };
 
             // Draw preview background
             DrawRectangleRec(previewRect, WHITE);
             DrawRectangleLinesEx(previewRect, 1.f, DARKGRAY);
 
-            const Vec2 uvOffset{ (p.CurrentFrameIndex.Value % p.Property_Columns.Value) * p.Uv.w, (p.CurrentFrameIndex.Value / p.Property_Columns.Value) * p.Uv.h };
-
-            const Vec2 uvTopLeft{ p.Uv.x + uvOffset.x, p.Uv.y + uvOffset.y };
-
-            const Vec2 uvBottomRight{ uvTopLeft.x + p.Uv.w, uvTopLeft.y + p.Uv.h };
-
             DrawRectangleRec(spriteRect, GRAY);
+            SetTextureFilterForScale(*pageTexture, p.Uv.w > 0 ? spriteRect.width / p.Uv.w : 1.f);
 
             const Vector2 uvScale{
-                static_cast<float>(CP->SpriteTexture->width),
-                static_cast<float>(CP->SpriteTexture->height),
+                static_cast<float>(pageTexture->width),
+                static_cast<float>(pageTexture->height),
             };
 
-            // Draw the UV rect
-            rlSetTexture(CP->SpriteTexture->id);
-            // rlSetBlendMode(BLEND_ALPHA);
+            // Draw the UV rect of the frame at the current clock time
+            rlSetTexture(pageTexture->id);
             rlBegin(RL_QUADS);
-
-            rlTexCoord2f(uvTopLeft.x / uvScale.x, uvTopLeft.y / uvScale.y);
-            rlColor4f(1.f, 1.f, 1.f, 1.f);
-            rlVertex2f(spriteRect.x, spriteRect.y);
-
-            rlTexCoord2f(uvTopLeft.x / uvScale.x, uvBottomRight.y / uvScale.y);
-            rlVertex2f(spriteRect.x, spriteRect.y + spriteRect.height);
-
-            rlTexCoord2f(uvBottomRight.x / uvScale.x, uvBottomRight.y / uvScale.y);
-            rlVertex2f(spriteRect.x + spriteRect.width, spriteRect.y + spriteRect.height);
-
-            rlTexCoord2f(uvBottomRight.x / uvScale.x, uvTopLeft.y / uvScale.y);
-            rlVertex2f(spriteRect.x + spriteRect.width, spriteRect.y);
-
+            PushTexturedQuad(spriteRect, p.GetFrameRect(p.GetFrameIndexAt(animationClock.GetElapsedMs())), uvScale);
             rlEnd();
             rlSetTexture(0);
         }
-
-    {
-        // Advance animation frame
-        const int64_t currentTimeMs = (int64_t)(GetTime() * 1000.0);
-        ;
-        if (p.Property_FrameDurationMs.Value > 0 && p.Property_NumOfFrames.Value > 1)
-            {
-                if (p.StartTimeMs == 0)
-                    {
-                        p.StartTimeMs = currentTimeMs;
-                    }
-                const int64_t elapsedMs     = currentTimeMs - p.StartTimeMs;
-                const int32_t frameAdvances = static_cast<int32_t>(elapsedMs / p.Property_FrameDurationMs.Value);
-                if (frameAdvances > 0)
-                    {
-                        p.CurrentFrameIndex.Value += frameAdvances;
-                        if (p.Looping)
-                            {
-                                p.CurrentFrameIndex.Value %= p.Property_NumOfFrames.Value;
-                            }
-                        else
-                            {
-                                if (p.CurrentFrameIndex.Value >= p.Property_NumOfFrames.Value)
-                                    {
-                                        p.CurrentFrameIndex.Value = p.Property_NumOfFrames.Value - 1;
-                                    }
-                            }
-                        p.StartTimeMs += frameAdvances * p.Property_FrameDurationMs.Value;
-                    }
-            }
-    }
 }
 
 void
@@ -302,7 +767,7 @@ DrawKeyframeProperties(Rectangle rect, KeyframeUv& p)
 {
     // Draw UV Rect
     constexpr std::string_view err{ "KEYFRAME not Supported yet!" };
-    DrawText(err.data(), rect.x + rect.width / 2.f - GetStringWidth(err.data()) / 2.f, rect.y, GuiGetStyle(DEFAULT, TEXT_SIZE), RED);
+    DrawTextCached(err.data(), rect.x + rect.width / 2.f - GetStringWidth(err.data()) / 2.f, rect.y, GuiGetStyle(DEFAULT, TEXT_SIZE), RED);
 }
 
 void
@@ -317,18 +782,83 @@ DrawPropertiesIfValidPtr(Rectangle rect, AnimationData* p)
         {
             DrawSpritesheetUvProperties(rect, std::get<SpritesheetUv>(p->Data));
         }
-    else if (std::holds_alternative<KeyframeUv>(p->Data))
+    else if (std::holds_alternative<KeyframeUv>(p->Data))
+        {
+            DrawKeyframeProperties(rect, std::get<KeyframeUv>(p->Data));
+        }
+    else
+        {
+            assert(false && "Unknown property variant!");
+        }
+}
+
+/**
+ * \brief Bulk edits of the selected animations, each button is a single pass over the selection.
+ */
+void
+DrawSelectionProperties(Rectangle rect)
+{
+    rect.height = 30;
+
+    static char     lblOffsetX[]  = "Offset X: ";
+    static char     lblOffsetY[]  = "Offset Y: ";
+    static char     lblScale[]    = "Scale %: ";
+    static char     lblDuration[] = "Frame duration ms: ";
+    static Property offsetX{};
+    static Property offsetY{};
+    static Property scalePercent{ 100 };
+    static Property durationMs{ 100 };
+
+    const double time{ input::GetTime() };
+    const float  halfW{ (rect.width - PAD) / 2.f };
+
+    // Translate
+    (void)(NumericBox(rect, lblOffsetX, &offsetX.Value, -INT32_MAX, INT32_MAX, offsetX.ActiveBox));
+    rect.y += 30 + PAD;
+    (void)(NumericBox(rect, lblOffsetY, &offsetY.Value, -INT32_MAX, INT32_MAX, offsetY.ActiveBox));
+    rect.y += 30 + PAD;
+    if (GuiButton(rect, "Translate"))
+        {
+            CP->TranslateSelection(offsetX.Value, offsetY.Value, time);
+        }
+    rect.y += 30 + PAD * 3;
+
+    // Scale
+    (void)(NumericBox(rect, lblScale, &scalePercent.Value, 1, 10000, scalePercent.ActiveBox));
+    rect.y += 30 + PAD;
+    if (GuiButton(rect, "Scale"))
+        {
+            CP->ScaleSelection(scalePercent.Value / 100.f, time);
+        }
+    rect.y += 30 + PAD * 3;
+
+    // Frame duration
+    (void)(NumericBox(rect, lblDuration, &durationMs.Value, 0, INT32_MAX, durationMs.ActiveBox));
+    rect.y += 30 + PAD;
+    if (GuiButton(rect, "Set frame duration"))
+        {
+            CP->SetSelectionFrameDuration(durationMs.Value, time);
+        }
+    rect.y += 30 + PAD * 3;
+
+    // Looping
+    if (GuiButton({ rect.x, rect.y, halfW, rect.height }, "Loop"))
+        {
+            CP->SetSelectionLooping(true, time);
+        }
+    if (GuiButton({ rect.x + halfW + PAD, rect.y, halfW, rect.height }, "Play once"))
         {
-            DrawKeyframeProperties(rect, std::get<KeyframeUv>(p->Data));
+            CP->SetSelectionLooping(false, time);
         }
-    else
+    rect.y += 30 + PAD * 3;
+
+    if (GuiButton(rect, "Delete selected"))
         {
-            assert(false && "Unknown property variant!");
+            ActiveModal = EModalType::CONFIRM_DELETE;
         }
 }
 
-Rectangle panelView   = { 0 };
-Vector2   panelScroll = { 0, 0 };
+Rectangle panelView = { 0 };
 
 using ANIMATION_NAME_T = char[32 + 1];
 ANIMATION_NAME_T NewAnimationName{ "Animation_0" };
@@ -381,58 +911,250 @@ DrawGrid(Rectangle bounds, float spacing, Color color)
         }
 }
 
+constexpr float GALLERY_TILE_SIZE{ 160.f };
+constexpr float GALLERY_LABEL_HEIGHT{ 20.f };
+Rectangle       galleryView{};
+Vector2         galleryScroll{};
+
+/**
+ * \brief Draws every spritesheet animation playing at the same time in a scrollable grid.
+ * Only the visible rows are visited and the sprite quads are submitted in one batch per texture page.
+ * \return The index of the clicked animation, -1 if none.
+ */
+int32_t
+DrawAnimationGallery(Rectangle bounds, int64_t elapsedMs)
+{
+    PROFILE_SCOPE("Gallery");
+    constexpr float SCROLLBAR_MARGIN{ 20.f };
+    const auto&     names{ CP->ImmutableTransientAnimationNames };
+    const float     tileW{ GALLERY_TILE_SIZE + PAD };
+    const float     tileH{ GALLERY_TILE_SIZE + GALLERY_LABEL_HEIGHT + PAD };
+    const int32_t   columns{ std::max(1, static_cast<int32_t>((bounds.width - SCROLLBAR_MARGIN - PAD) / tileW)) };
+    const int32_t   rows{ (static_cast<int32_t>(names.size()) + columns - 1) / columns };
+
+    const Rectangle contentRect{ bounds.x, bounds.y, bounds.width - SCROLLBAR_MARGIN, rows * tileH + PAD };
+    GuiScrollPanel(bounds, NULL, contentRect, &galleryScroll, &galleryView);
+
+    if (!CP->SpriteTexture.has_value() || names.empty())
+        {
+            return -1;
+        }
+
+    // Cull whole rows outside the scroll view
+    const int32_t firstRow{ std::clamp(static_cast<int32_t>(-galleryScroll.y / tileH), 0, rows) };
+    const int32_t lastRow{ std::clamp(static_cast<int32_t>((-galleryScroll.y + galleryView.height) / tileH) + 1, 0, rows) };
+    const int32_t firstIndex{ firstRow * columns };
+    const int32_t lastIndex{ std::min(lastRow * columns, static_cast<int32_t>(names.size())) };
+
+    const auto tileRect = [&](int32_t i) -> Rectangle {
+        return { galleryView.x + galleryScroll.x + PAD + (i % columns) * tileW, galleryView.y + galleryScroll.y + PAD + (i / columns) * tileH, GALLERY_TILE_SIZE, GALLERY_TILE_SIZE };
+    };
+
+    int32_t clickedIndex{ -1 };
+    PROFILE_COUNT_RENDER_BATCH();
+    BeginScissorMode(galleryView.x, galleryView.y, galleryView.width, galleryView.height);
+
+    // Backgrounds first, they use a different texture thus would break the sprite batch
+    for (int32_t i{ firstIndex }; i < lastIndex; ++i)
+        {
+            const Rectangle tile{ tileRect(i) };
+            DrawRectangleRec(tile, i == CP->ListState.activeIndex ? SKYBLUE : CP->IsSelected(i) ? Fade(SKYBLUE, .5f) : LIGHTGRAY);
+            if (input::IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(input::GetMousePosition(), galleryView) && CheckCollisionPointRec(input::GetMousePosition(), tile))
+                {
+                    clickedIndex = i;
+                }
+        }
+
+    // The visible frames of each page in one batch, pages without visible frames are not touched and may be evicted
+    std::vector<const SpritesheetUv*> visibleSpriteSheets(lastIndex - firstIndex, nullptr);
+    for (int32_t i{ firstIndex }; i < lastIndex; ++i)
+        {
+            const auto& animationData{ CP->ImmutableTransientAnimations[i]->second };
+            if (std::holds_alternative<SpritesheetUv>(animationData.Data))
+                {
+                    visibleSpriteSheets[i - firstIndex] = &std::get<SpritesheetUv>(animationData.Data);
+                }
+        }
+    for (int32_t page{}; page < CP->GetNumPages(); ++page)
+        {
+            const auto onPage = [page](const SpritesheetUv* spriteSheet) { return spriteSheet && spriteSheet->Property_Page.Value == page; };
+            if (std::none_of(visibleSpriteSheets.begin(), visibleSpriteSheets.end(), onPage))
+                {
+                    continue;
+                }
+            const Texture2D* pageTexture{ CP->AcquirePageTexture(page) };
+            if (!pageTexture)
+                {
+                    continue;
+                }
+
+            // One filter per page, trilinear unless every thumbnail of the page is magnified
+            float minScale{ std::numeric_limits<float>::max() };
+            for (int32_t i{ firstIndex }; i < lastIndex; ++i)
+                {
+                    const SpritesheetUv* spriteSheet{ visibleSpriteSheets[i - firstIndex] };
+                    if (onPage(spriteSheet) && spriteSheet->Uv.w > 0)
+                        {
+                            minScale = std::min(minScale, FitRectKeepAspect(tileRect(i), spriteSheet->Uv.w, spriteSheet->Uv.h).width / spriteSheet->Uv.w);
+                        }
+                }
+            SetTextureFilterForScale(*pageTexture, minScale);
+
+            const Vector2 uvScale{ static_cast<float>(pageTexture->width), static_cast<float>(pageTexture->height) };
+            rlCheckRenderBatchLimit((lastIndex - firstIndex) * 4);
+            rlSetTexture(pageTexture->id);
+            rlBegin(RL_QUADS);
+            for (int32_t i{ firstIndex }; i < lastIndex; ++i)
+                {
+                    const SpritesheetUv* spriteSheet{ visibleSpriteSheets[i - firstIndex] };
+                    if (onPage(spriteSheet))
+                        {
+                            PushTexturedQuad(FitRectKeepAspect(tileRect(i), spriteSheet->Uv.w, spriteSheet->Uv.h), spriteSheet->GetFrameRect(spriteSheet->GetFrameIndexAt(elapsedMs)), uvScale);
+                        }
+                }
+            rlEnd();
+            rlSetTexture(0);
+        }
+
+    for (int32_t i{ firstIndex }; i < lastIndex; ++i)
+        {
+            const Rectangle tile{ tileRect(i) };
+            GuiDrawText(names[i], { tile.x, tile.y + tile.height, tile.width, GALLERY_LABEL_HEIGHT }, TEXT_ALIGN_CENTER, DARKGRAY);
+        }
+
+    PROFILE_COUNT_RENDER_BATCH();
+    EndScissorMode();
+
+    return clickedIndex;
+}
+
 int
-main()
+main(int argc, char** argv)
 {
-    App app(1600, 900, "Sprite Sheet UV Editor");
+    // Replays run headless and unthrottled with the recorded render size
+    const CommandLine commandLine{ ParseCommandLine(argc, argv) };
+    if (!commandLine.Valid)
+        {
+            return batch::EExitCode::USAGE;
+        }
+    // Asset pipelines run without display
+    if (!commandLine.Batch.Inputs.empty())
+        {
+            return batch::Run(commandLine.Batch);
+        }
+    if (!commandLine.Server.SocketPath.empty())
+        {
+            return server::Run(commandLine.Server);
+        }
+    if (!commandLine.ReplayPath.empty())
+        {
+            if (const auto replayError{ input::StartReplay(commandLine.ReplayPath) }; replayError.has_value())
+                {
+                    std::cout << replayError.value() << std::endl;
+                    return 1;
+                }
+        }
+    const bool headless{ input::IsReplaying() };
+    if (!commandLine.ImageCacheDirectory.empty())
+        {
+            ImageCache::Shared().SetDirectory(commandLine.ImageCacheDirectory);
+        }
+    if (commandLine.ImageCacheBudgetBytes.has_value())
+        {
+            ImageCache::Shared().SetBudgetBytes(commandLine.ImageCacheBudgetBytes.value());
+        }
+    SetMipFilter(commandLine.MipFilter);
+
+    App app(headless ? input::GetRenderWidth() : 1600, headless ? input::GetRenderHeight() : 900, "Sprite Sheet UV Editor", headless);
+    if (!commandLine.RecordPath.empty())
+        {
+            app.LastError = input::StartRecording(commandLine.RecordPath);
+        }
     if (app.GetFont().texture.id)
         {
             GuiSetFont(app.GetFont());
         }
     GuiSetStyle(DEFAULT, TEXT_SIZE, 16);
+    // The labels are laid out again with the font and the style
+    TextLayoutCache::Shared().Clear();
 
     // Set the zoom to fit the image on the max size
     {
         defaultView.pan = { 1, PAD * 2 + 30 };
         defaultView.fitZoom =
-        View::ZoomFitIntoRect(DEFAULT_CANVAS_WIDTH, DEFAULT_CANVAS_HEIGHT, { 0, 0, GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
+        View::ZoomFitIntoRect(DEFAULT_CANVAS_WIDTH, DEFAULT_CANVAS_HEIGHT, { 0, 0, input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, input::GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
         defaultView.SetZoomFactor(defaultView.fitZoom);
         defaultView.prevZoom = defaultView.zoom;
         assert(defaultView.fitZoom > 0.f);
     }
 
-    while (app.ShouldRun())
+    // Picks up the sprite and project file changes made by other programs
+    HotReloader hotReloader{};
+
+    // Walking the undo history is not free, the report is refreshed at a low rate
+    MemoryReport memoryReport{};
+    double       memoryReportTime{ std::numeric_limits<double>::lowest() };
+    double       memoryLogTime{ std::numeric_limits<double>::lowest() };
+
+#if defined(SPRITE_UV_PROFILER)
+    profilerRenderBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    rlSetRenderBatchActive(&profilerRenderBatch);
+#endif
+
+    while (app.ShouldRun() && input::BeginFrame())
         {
+#if defined(SPRITE_UV_PROFILER)
+            profiler::BeginFrame();
+            frameRenderStats = {};
+#endif
+            animationClock.Tick(input::GetTime());
 
-            const int32_t CANVAS_WIDTH{ CP->SpriteTexture.has_value() ? CP->SpriteTexture->width : DEFAULT_CANVAS_WIDTH };
-            const int32_t CANVAS_HEIGHT{ CP->SpriteTexture.has_value() ? CP->SpriteTexture->height : DEFAULT_CANVAS_HEIGHT };
+            // The canvas shows the page of the selected animation
+            const int32_t viewedPage{ GetSelectedAnimationPage() };
+            const Vec2    viewedPageSize{ CP->GetPageSize(viewedPage) };
+            const int32_t CANVAS_WIDTH{ viewedPageSize.x > 0 ? viewedPageSize.x : DEFAULT_CANVAS_WIDTH };
+            const int32_t CANVAS_HEIGHT{ viewedPageSize.y > 0 ? viewedPageSize.y : DEFAULT_CANVAS_HEIGHT };
 
 #pragma region Events
             {
+                PROFILE_SCOPE("Events");
+
+                if (auto reloadError{ hotReloader.Update(*CP) }; reloadError.has_value())
+                    {
+                        app.LastError = std::move(reloadError);
+                    }
+                if (auto remapReport{ hotReloader.TakeRemapReport() }; remapReport.has_value())
+                    {
+                        app.LastReport = std::move(remapReport);
+                    }
+
+                // Upload the pages decoded in the background and evict the ones out of budget
+                CP->PageTextures.Update();
+
                 // Handle window resize viewport
                 if (IsWindowResized())
                     {
                         // Update fit zoom on window resize
                         defaultView.fitZoom =
-                        view.ZoomFitIntoRect(CANVAS_WIDTH, CANVAS_HEIGHT, { 0, 0, GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
+                        view.ZoomFitIntoRect(CANVAS_WIDTH, CANVAS_HEIGHT, { 0, 0, input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, input::GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
                     }
 
                 // Mouse panning (middle button)
-                if (IsMouseButtonDown(MOUSE_BUTTON_MIDDLE))
+                if (input::IsMouseButtonDown(MOUSE_BUTTON_MIDDLE))
                     {
                         // GetMouseDelta returns movement in screen space; pan is in screen space too.
-                        const Vector2 d = GetMouseDelta();
+                        const Vector2 d = input::GetMouseDelta();
                         view.pan.x += d.x;
                         view.pan.y += d.y;
                         view.SafelyClampPan();
                     }
-                else if (!CP->ListState.ShowList) // Mouse wheel zoom (when list not shown)
+                else if (!CP->ListState.ShowList && !app.ShowGallery) // Mouse wheel zoom (when list and gallery not shown)
                     {
-                        const float wheelMove = GetMouseWheelMove();
+                        const float wheelMove = input::GetMouseWheelMove();
                         if (wheelMove != 0.0f)
                             {
                                 // Current mouse position in screen coords
-                                const Vector2 mouse = GetMousePosition();
+                                const Vector2 mouse = input::GetMousePosition();
 
                                 // Zoom factor before change
                                 const float prevZoomFactor = view.GetZoomFactor();
@@ -466,8 +1188,8 @@ main()
                                     // Viewport area for the canvas (exclude right panel and top toolbar/occlusion)
                                     const float viewportX = 0.f;
                                     const float viewportY = defaultView.pan.y; // keep top offset consistent with default
-                                    const float viewportW = static_cast<float>(GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH);
-                                    const float viewportH = static_cast<float>(GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y - viewportY);
+                                    const float viewportW = static_cast<float>(input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH);
+                                    const float viewportH = static_cast<float>(input::GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y - viewportY);
 
                                     const float canvasScaledW = CANVAS_WIDTH * appliedZoom;
                                     const float canvasScaledH = CANVAS_HEIGHT * appliedZoom;
@@ -500,26 +1222,81 @@ main()
                         view.prevZoom = view.zoom;
                     }
 
-                if (IsKeyDown(KEY_LEFT_CONTROL))
+                if (input::IsKeyDown(KEY_LEFT_CONTROL))
                     {
                         // Reset view
-                        if (IsKeyPressed(KEY_ZERO) || IsKeyPressed(KEY_KP_0))
+                        if (input::IsKeyPressed(KEY_ZERO) || input::IsKeyPressed(KEY_KP_0))
                             {
                                 ResetViewToDefault();
                             }
-                        else if (IsKeyPressed(KEY_Z))
+                        else if (input::IsKeyPressed(KEY_Z))
                             {
                                 CP->UndoAction();
                             }
-                        else if (IsKeyPressed(KEY_Y))
+                        else if (input::IsKeyPressed(KEY_Y))
                             {
                                 CP->RedoAction();
                             }
-                        else if (IsKeyDown(KEY_S))
+                        else if (input::IsKeyDown(KEY_S))
                             {
                                 CP->SaveToFile();
                             }
                     }
+
+                // Arrows move the selection by a pixel, by a grid cell when snapping, unless they move the cursor of a focused box
+                if (ActiveModal == EModalType::NONE && !CP->ListState.ShowList && !GuiBoxInEditMode && CP->GetNumSelected() > 0)
+                    {
+                        const auto    arrow = [](int32_t key) { return input::IsKeyPressed(key) || input::IsKeyPressedRepeat(key) ? 1 : 0; };
+                        const int32_t step{ app.SnapToGrid ? std::max(1, app.GridSize) : 1 };
+                        const int32_t dx{ (arrow(KEY_RIGHT) - arrow(KEY_LEFT)) * step };
+                        const int32_t dy{ (arrow(KEY_DOWN) - arrow(KEY_UP)) * step };
+                        if (dx != 0 || dy != 0)
+                            {
+                                CP->TranslateSelection(dx, dy, input::GetTime());
+                            }
+                    }
+
+                if (input::IsKeyPressed(KEY_F5))
+                    {
+                        app.ShowMemoryPanel = !app.ShowMemoryPanel;
+                    }
+                else if (input::IsKeyPressed(KEY_F6))
+                    {
+                        // The first report is logged right away
+                        app.LogMemory = !app.LogMemory;
+                        memoryLogTime = std::numeric_limits<double>::lowest();
+                    }
+                const bool logMemoryNow{ app.LogMemory && input::GetTime() - memoryLogTime >= MEMORY_LOG_SECONDS };
+                if (logMemoryNow || (app.ShowMemoryPanel && input::GetTime() - memoryReportTime >= MEMORY_REFRESH_SECONDS))
+                    {
+                        memoryReport     = CollectMemoryReport(app, hotReloader);
+                        memoryReportTime = input::GetTime();
+                    }
+                if (logMemoryNow)
+                    {
+                        memoryLogTime = input::GetTime();
+                        if (auto logError{ AppendMemoryReport(MEMORY_LOG_PATH, memoryReport, memoryLogTime) }; logError.has_value())
+                            {
+                                app.LastError = std::move(logError);
+                                app.LogMemory = false;
+                            }
+                    }
+
+#if defined(SPRITE_UV_PROFILER)
+                if (input::IsKeyPressed(KEY_F3))
+                    {
+                        app.ShowProfiler = !app.ShowProfiler;
+                    }
+                else if (input::IsKeyPressed(KEY_F4))
+                    {
+                        constexpr const char* TRACE_PATH{ "sprite_uv_trace.json" };
+                        app.LastError = profiler::WriteChromeTrace(TRACE_PATH);
+                        if (!app.LastError.has_value())
+                            {
+                                app.LastReport = std::string{ "Trace written to " } + TRACE_PATH;
+                            }
+                    }
+#endif
             }
 #pragma endregion Events
 
@@ -529,6 +1306,17 @@ main()
 
             // Each frame rebuild the animation names vector
             CP->RebuildAnimationNamesVectorAndRefreshPropertyPanel(CP->ListState.activeIndex);
+            UpdateFrameValidator();
+            // Bursts of edits become an undo step once they settle
+            CP->CommitIdleTransaction(input::GetTime());
+
+            // Restart the previews when the selection changes so that non looping animations play from the first frame
+            static int32_t previousActiveIndex{ CP->ListState.activeIndex };
+            if (previousActiveIndex != CP->ListState.activeIndex)
+                {
+                    previousActiveIndex = CP->ListState.activeIndex;
+                    animationClock.Restart();
+                }
 
             const bool hasValidSelectedAnimation{ CP->ListState.activeIndex > -1 && !CP->ImmutableTransientAnimationNames.empty() &&
                 CP->ListState.activeIndex < CP->ImmutableTransientAnimationNames.size() };
@@ -537,6 +1325,7 @@ main()
             const float     zoomFactor = view.GetZoomFactor();
             const Rectangle canvasRect{ static_cast<float>(view.pan.x), static_cast<float>(view.pan.y), CANVAS_WIDTH * zoomFactor, CANVAS_HEIGHT * zoomFactor };
 
+            PROFILE_BEGIN(canvasZone, "Canvas");
             // Draw checkered background
             if (app.CheckerBoardTexture.id)
                 {
@@ -545,15 +1334,23 @@ main()
                     DrawTexturePro(app.CheckerBoardTexture, canvasRect, canvasRect, {}, 0, WHITE);
                 }
 
-            // Draw sprite texture if has one
-            if (CP->SpriteTexture.has_value())
+            // Draw the page texture if has one
+            if (const Texture2D* pageTexture{ CP->AcquirePageTexture(viewedPage) })
+                {
+                    SetTextureFilterForScale(*pageTexture, zoomFactor);
+                    DrawTextureEx(*pageTexture, to::Vector2_(view.pan), 0, zoomFactor, WHITE);
+                }
+            else if (CP->GetPageResidency(viewedPage) == EPageResidency::LOADING)
                 {
-                    DrawTextureEx(CP->SpriteTexture.value(), to::Vector2_(view.pan), 0, zoomFactor, WHITE);
+                    DrawTextCached("Loading page...", view.pan.x + PAD, view.pan.y + PAD, 20, WHITE);
                 }
 
+            PROFILE_END(canvasZone);
+
             // Draw grid only if snapping is enabled
             if (app.SnapToGrid)
                 {
+                    PROFILE_SCOPE("Grid");
                     const auto gridRect{ Rectangle{
                     static_cast<float>(view.pan.x),
                     static_cast<float>(view.pan.y),
@@ -583,10 +1380,37 @@ main()
                 DrawLineEx(to::Vector2_(view.pan), to::Vector2_({ (int)view.pan.x, AXIS_LEN }), 2.f, GREEN);
             }
 
-            // Draw the selected animation
-            if (hasValidSelectedAnimation)
+            // Outline the selected animations of the viewed page, culled to the canvas viewport
+            if (!app.ShowGallery && CP->GetNumSelected() > 1)
+                {
+                    PROFILE_SCOPE("Selection");
+                    const Rectangle viewport{ 0, 0, static_cast<float>(input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH), static_cast<float>(input::GetRenderHeight()) };
+                    for (const auto it : CP->SelectedAnimations)
+                        {
+                            const auto* spriteSheet{ std::get_if<SpritesheetUv>(&it->second.Data) };
+                            if (!spriteSheet || spriteSheet->Property_Page.Value != viewedPage)
+                                {
+                                    continue;
+                                }
+                            const Rectangle rect{ view.TransformRect(to::Rectangle_(spriteSheet->Uv)) };
+                            if (CheckCollisionRecs(rect, viewport))
+                                {
+                                    DrawRectangleLinesEx(rect, 2.f, ORANGE);
+                                }
+                        }
+                }
+
+            if (!app.ShowGallery)
+                {
+                    DrawFrameAnnotations(viewedPage);
+                }
+
+            // Draw the selected animation, the gallery covers the canvas
+            bool cancelDrag{};
+            if (hasValidSelectedAnimation && !app.ShowGallery)
                 {
-                    auto& animationVariant = CP->AnimationNameToSpritesheet.at(CP->ImmutableTransientAnimationNames[CP->ListState.activeIndex]);
+                    PROFILE_SCOPE("Overlays");
+                    auto& animationVariant = CP->ImmutableTransientAnimations[CP->ListState.activeIndex]->second;
                     if (std::holds_alternative<SpritesheetUv>(animationVariant.Data))
                         {
                             auto& spriteSheet = std::get<SpritesheetUv>(animationVariant.Data);
@@ -595,10 +1419,7 @@ main()
 
                             for (int32_t i{ 1 }; i < spriteSheet.Property_NumOfFrames.Value; ++i)
                                 {
-                                    Rectangle frameUv{ to::Rectangle_(spriteSheet.Uv) };
-                                    frameUv.x += (i % spriteSheet.Property_Columns.Value) * frameUv.width;
-                                    frameUv.y += (i / spriteSheet.Property_Columns.Value) * frameUv.height;
-                                    DrawUVRectDashed(frameUv, view);
+                                    DrawUVRectDashed(to::Rectangle_(spriteSheet.GetFrameRect(i)), view);
                                 }
 
                             // DrawRectangleRec(spriteSheet.Uv, RED);
@@ -607,11 +1428,22 @@ main()
                             constexpr float baseControlExtent{ 5.f };
                             const auto      controlExtent{ baseControlExtent };
                             const int32_t   focusedControlPoints{ DrawUvRectControlsGetControlIndex(to::Rectangle_(spriteSheet.Uv), view, controlExtent) };
-                            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+                            if (spriteSheet.DraggingControlIndex != EControlIndex::NONE && input::IsMouseButtonPressed(MOUSE_RIGHT_BUTTON))
+                                {
+                                    // Right click aborts the drag, the rect is restored once the sprite sheet is no longer referenced
+                                    spriteSheet.DraggingControlIndex = EControlIndex::NONE;
+                                    cancelDrag                       = true;
+                                }
+                            else if (input::IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !IsShiftDown())
                                 {
                                     spriteSheet.DraggingControlIndex = focusedControlPoints;
+                                    if (focusedControlPoints != EControlIndex::NONE)
+                                        {
+                                            // The whole drag is a single undo step, the intermediate rects are never serialized
+                                            CP->BeginTransaction(&spriteSheet, input::GetTime());
+                                        }
                                 }
-                            else if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON) && spriteSheet.DraggingControlIndex != EControlIndex::NONE)
+                            else if (input::IsMouseButtonReleased(MOUSE_LEFT_BUTTON) && spriteSheet.DraggingControlIndex != EControlIndex::NONE)
                                 {
                                     spriteSheet.DraggingControlIndex = EControlIndex::NONE;
 
@@ -629,13 +1461,17 @@ main()
                                         }
                                     spriteSheet.Uv.h = std::max(app.SnapToGrid ? g : 1, spriteSheet.Uv.h);
 
-                                    CP->CommitNewAction();
+                                    CP->CommitTransaction();
+                                }
+                            else if (spriteSheet.DraggingControlIndex != EControlIndex::NONE)
+                                {
+                                    CP->UpdateTransaction(input::GetTime());
                                 }
 
                             // Get mouse pos in image space
                             Vec2 mousePos{};
                             {
-                                auto rayMousePos{ GetMousePosition() };
+                                auto rayMousePos{ input::GetMousePosition() };
                                 // Correct mapping: image = (screen - pan) / zoomFactor
                                 rayMousePos.x = (rayMousePos.x - view.pan.x) / zoomFactor;
                                 rayMousePos.y = (rayMousePos.y - view.pan.y) / zoomFactor;
@@ -689,11 +1525,46 @@ main()
                             spriteSheet.DeltaMousePos = mousePos;
                         }
                 }
+            if (cancelDrag)
+                {
+                    CP->CancelTransaction();
+                }
+
+            // Shift drag on the canvas selects the animations of the viewed page touched by the marquee, ctrl keeps the current selection
+            static std::optional<Vector2> marqueeStart{};
+            if (!app.ShowGallery && ActiveModal == EModalType::NONE && !CP->ListState.ShowList)
+                {
+                    const Vector2 mouse{ input::GetMousePosition() };
+                    const Vector2 mouseImage{ (mouse.x - view.pan.x) / zoomFactor, (mouse.y - view.pan.y) / zoomFactor };
+                    if (IsShiftDown() && input::IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && mouse.x < input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH && mouse.y > 50)
+                        {
+                            marqueeStart = mouseImage;
+                        }
+                    if (marqueeStart.has_value())
+                        {
+                            const Rectangle marquee{ std::min(marqueeStart->x, mouseImage.x),
+                                std::min(marqueeStart->y, mouseImage.y),
+                                std::abs(marqueeStart->x - mouseImage.x),
+                                std::abs(marqueeStart->y - mouseImage.y) };
+                            DrawRectangleLinesEx(view.TransformRect(marquee), 1.f, ORANGE);
+                            if (input::IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
+                                {
+                                    SelectAnimationsInRect(marquee, viewedPage, IsControlDown());
+                                    marqueeStart.reset();
+                                }
+                        }
+                }
+            else
+                {
+                    marqueeStart.reset();
+                }
 #pragma region GUI
+            PROFILE_BEGIN(guiZone, "GUI");
+            GuiBoxInEditMode = false;
 
             const char* animationNameOrPlaceholder{ !hasValidSelectedAnimation ? "No animation" : CP->ImmutableTransientAnimationNames[CP->ListState.activeIndex] };
 
-            DrawRectangle(0, 0, GetRenderWidth(), 50, DARKGRAY);
+            DrawRectangle(0, 0, input::GetRenderWidth(), 50, DARKGRAY);
             float TITLE_X_OFFSET{ PAD };
 
             if (ActiveModal != EModalType::NONE)
@@ -701,6 +1572,17 @@ main()
                     GuiLock();
                 }
 
+            // Gallery covers the canvas area
+            if (app.ShowGallery)
+                {
+                    const Rectangle galleryBounds{ 0, 50, input::GetRenderWidth() - 380.f, input::GetRenderHeight() - 50.f - 16.f };
+                    const int32_t   clickedIndex{ DrawAnimationGallery(galleryBounds, animationClock.GetElapsedMs()) };
+                    if (clickedIndex > -1 && ActiveModal == EModalType::NONE && !CP->ListState.ShowList)
+                        {
+                            ClickAnimation(clickedIndex);
+                        }
+                }
+
             const bool unsavedChanges{ CP->HasUnsavedChanges() };
             // Open sprite button
             const Rectangle openButtonRect{ TITLE_X_OFFSET, PAD, GetStringWidth("Open sprite") * 1.f + PAD, 30 };
@@ -724,14 +1606,15 @@ main()
                                 auto newProject{ std::make_unique<Project>() };
                                 if (newProject->LoadFromFile(newImagePath))
                                     {
-                                        CP = std::move(newProject);
+                                        CP             = std::move(newProject);
+                                        frameValidator = {};
 
                                         // Reset view
                                         {
                                             // Set the zoom to fit the new image on the max size
                                             defaultView.fitZoom = view.ZoomFitIntoRect(CP->SpriteTexture->width,
                                             CP->SpriteTexture->height,
-                                            { 0, 0, GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
+                                            { 0, 0, input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH, input::GetRenderHeight() - VIEWPORT_GUI_OCCLUSION_Y });
                                             defaultView.SetZoomFactor(defaultView.fitZoom);
 
                                             ResetViewToDefault();
@@ -759,6 +1642,66 @@ main()
             GuiSetState(STATE_NORMAL);
             TITLE_X_OFFSET += saveButtonRect.width + PAD;
 
+            // Export button
+            if (CP->SpritePath.empty())
+                {
+                    GuiSetState(STATE_DISABLED);
+                }
+
+            const Rectangle exportButtonRect{ TITLE_X_OFFSET, PAD, GetStringWidth("Export") * 1.f + PAD, 30 };
+            if (GuiButton(exportButtonRect, "Export"))
+                {
+                    ActiveModal = EModalType::EXPORT;
+                }
+            GuiSetState(STATE_NORMAL);
+            TITLE_X_OFFSET += exportButtonRect.width + PAD;
+
+            // Remap UVs button, matches the animations of a previous version of the sprite to the current one
+            if (!CP->SpriteImage.has_value())
+                {
+                    GuiSetState(STATE_DISABLED);
+                }
+
+            const Rectangle remapButtonRect{ TITLE_X_OFFSET, PAD, GetStringWidth("Remap UVs") * 1.f + PAD, 30 };
+            if (GuiButton(remapButtonRect, "Remap UVs"))
+                {
+                    std::string previousImagePath{};
+                    if (app.OpenFileDialog(previousImagePath, { "*.png", "*.jpg", "*.jpeg", "*.bmp", "*.tga", "*.gif" }))
+                        {
+                            const RgbaImage previousImage{ LoadRgbaImage(previousImagePath) };
+                            if (previousImage.Get().data)
+                                {
+                                    const UvRemapReport report{ FindRemappedUvs(previousImage.Get(), CP->SpriteImage.value(), CollectUvRemapInput(*CP)) };
+                                    ApplyUvRemap(*CP, report);
+                                    app.LastReport = report.ToString();
+                                }
+                            else
+                                {
+                                    app.LastError = "Failed to load image!";
+                                }
+                        }
+                }
+            GuiSetState(STATE_NORMAL);
+            TITLE_X_OFFSET += remapButtonRect.width + PAD;
+
+            // Add page button, an extra atlas page the animations can point at
+            if (CP->SpritePath.empty())
+                {
+                    GuiSetState(STATE_DISABLED);
+                }
+
+            const Rectangle addPageButtonRect{ TITLE_X_OFFSET, PAD, GetStringWidth("Add page") * 1.f + PAD, 30 };
+            if (GuiButton(addPageButtonRect, "Add page"))
+                {
+                    std::string pageImagePath{};
+                    if (app.OpenFileDialog(pageImagePath, { "*.png", "*.jpg", "*.jpeg", "*.bmp", "*.tga", "*.gif" }))
+                        {
+                            app.LastError = CP->AddPage(pageImagePath);
+                        }
+                }
+            GuiSetState(STATE_NORMAL);
+            TITLE_X_OFFSET += addPageButtonRect.width + PAD;
+
             // Draw grid size
             {
                 const Rectangle rect{ TITLE_X_OFFSET, PAD, GetStringWidth("Grid size") + 80.f, 30 };
@@ -786,6 +1729,17 @@ main()
                 TITLE_X_OFFSET += fitViewRect.width + PAD;
             }
 
+            {
+                // Toggle the gallery of all the animations
+                const Rectangle galleryRect{ TITLE_X_OFFSET, PAD, GetStringWidth("Gallery") * 1.f + PAD, 30 };
+                if (GuiButton(galleryRect, app.ShowGallery ? "Canvas" : "Gallery"))
+                    {
+                        app.ShowGallery = !app.ShowGallery;
+                        animationClock.Restart();
+                    }
+                TITLE_X_OFFSET += galleryRect.width + PAD;
+            }
+
             {
                 // Create new animation
 
@@ -815,34 +1769,52 @@ main()
                 const Rectangle animNameRect{ TITLE_X_OFFSET, PAD, nameW, 30 };
                 if (GuiButton(animNameRect, animationNameOrPlaceholder))
                     {
-                        CP->ListState.ShowList = !CP->ListState.ShowList;
+                        // Typing right away searches
+                        CP->ListState.ShowList       = !CP->ListState.ShowList;
+                        CP->ListState.FilterEditMode = CP->ListState.ShowList;
                     }
-                const auto scrollHeight{ std::clamp(CP->ImmutableTransientAnimationNames.size() * 50.f, 100.f, 500.f) };
-                const auto maxStringW{ std::accumulate(
-                CP->ImmutableTransientAnimationNames.begin(), CP->ImmutableTransientAnimationNames.end(), nameW, [](float acc, const char* name) { return std::max(acc, GetStringWidth(name)); }) };
 
                 if (CP->ListState.ShowList)
                     {
+                        PROFILE_SCOPE("Animation list");
                         const ListSelection prevState{ CP->ListState };
 
-                        const Rectangle panelScrollRect{ TITLE_X_OFFSET - PAD, PAD + 30, maxStringW + PAD * 2, scrollHeight };
-                        const Rectangle animListRect{ TITLE_X_OFFSET - PAD, PAD + 30, maxStringW + PAD * 2, scrollHeight };
-                        GuiScrollPanel(panelScrollRect, NULL, animListRect, &panelScroll, &panelView);
-                        BeginScissorMode(panelView.x, panelView.y, panelView.width, panelView.height);
-                        GuiListViewEx(animListRect,
-                        CP->ImmutableTransientAnimationNames.data(),
-                        CP->ImmutableTransientAnimationNames.size(),
-                        &CP->ListState.scrollIndex,
-                        &CP->ListState.activeIndex,
-                        &CP->ListState.focusIndex);
-                        // Clamp into range
-                        CP->ListState.activeIndex = std::clamp(CP->ListState.activeIndex, -1, static_cast<int32_t>(CP->ImmutableTransientAnimationNames.size()) - 1);
-                        EndScissorMode();
-
-                        if (CP->ListState.activeIndex != prevState.activeIndex)
+                        // The widths are cached per name, the list is as wide as the widest animation
+                        SyncAnimationNameIndex();
+                        float maxStringW{ nameW };
+                        for (const auto it : CP->ImmutableTransientAnimations)
                             {
+                                maxStringW = std::max(maxStringW, CP->AnimationNameWidths[it->first.Id]);
+                            }
+
+                        const Rectangle filterRect{ TITLE_X_OFFSET - PAD, PAD + 30, maxStringW + PAD * 2, 30 };
+                        (void)(StringBox(filterRect, CP->ListState.Filter, sizeof(CP->ListState.Filter), CP->ListState.FilterEditMode));
+                        if (CP->ListState.Filter != std::string_view{ prevState.Filter })
+                            {
+                                CP->ListState.scrollIndex = 0;
+                            }
+
+                        const std::vector<int32_t>& rows{ FilterAnimationList() };
+                        const float                 itemH{ static_cast<float>(GuiGetStyle(LISTVIEW, LIST_ITEMS_HEIGHT) + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING)) };
+                        const float                 scrollHeight{ std::clamp(rows.size() * itemH + GuiGetStyle(LISTVIEW, LIST_ITEMS_SPACING), 100.f, 500.f) };
+                        panelView = { filterRect.x, filterRect.y + filterRect.height, filterRect.width, scrollHeight };
+                        DrawAnimationList(panelView, rows, CP->ListState);
+
+                        // Enter leaves the search box, it picks the first match
+                        if (prevState.FilterEditMode && !CP->ListState.FilterEditMode && input::IsKeyPressed(KEY_ENTER) && !rows.empty())
+                            {
+                                ClickAnimation(rows.front());
                                 CP->ListState.ShowList = false;
                             }
+                        // The clicks are resolved here, the list only tracks the hovered row
+                        else if (ActiveModal == EModalType::NONE && CP->ListState.focusIndex >= 0 && input::IsMouseButtonReleased(MOUSE_LEFT_BUTTON) &&
+                                 CheckCollisionPointRec(input::GetMousePosition(), panelView))
+                            {
+                                // Stay open while building a selection
+                                const bool buildingSelection{ IsControlDown() || IsShiftDown() };
+                                ClickAnimation(CP->ListState.focusIndex);
+                                CP->ListState.ShowList = buildingSelection;
+                            }
                     }
                 TITLE_X_OFFSET += animNameRect.width + PAD;
             }
@@ -850,39 +1822,77 @@ main()
             // Property panel
             {
                 constexpr float RIGHTPANEL_W{ 380.f };
-                const float     RIGHTPANEL_X{ GetRenderWidth() - RIGHTPANEL_W };
+                const float     RIGHTPANEL_X{ input::GetRenderWidth() - RIGHTPANEL_W };
                 float           RIGHTPANEL_Y{ 50.f };
-                GuiDrawRectangle({ RIGHTPANEL_X, RIGHTPANEL_Y, RIGHTPANEL_W, GetRenderHeight() - RIGHTPANEL_Y }, 1, GRAY, DARKGRAY);
+                GuiDrawRectangle({ RIGHTPANEL_X, RIGHTPANEL_Y, RIGHTPANEL_W, input::GetRenderHeight() - RIGHTPANEL_Y }, 1, GRAY, DARKGRAY);
 
-                GuiDrawText(animationNameOrPlaceholder, { RIGHTPANEL_X, RIGHTPANEL_Y, RIGHTPANEL_W, 30 }, TEXT_ALIGN_CENTER, LIGHTGRAY);
-                RIGHTPANEL_Y += 30 + PAD;
+                if (CP->GetNumSelected() > 1)
+                    {
+                        const std::string title{ std::to_string(CP->GetNumSelected()) + " animations selected" };
+                        GuiDrawText(title.c_str(), { RIGHTPANEL_X, RIGHTPANEL_Y, RIGHTPANEL_W, 30 }, TEXT_ALIGN_CENTER, LIGHTGRAY);
+                        RIGHTPANEL_Y += 30 + PAD;
+                        DrawSelectionProperties(Rectangle{ RIGHTPANEL_X + PAD, RIGHTPANEL_Y, RIGHTPANEL_W - PAD * 2.f, input::GetRenderHeight() - RIGHTPANEL_Y });
+                    }
+                else
+                    {
+                        GuiDrawText(animationNameOrPlaceholder, { RIGHTPANEL_X, RIGHTPANEL_Y, RIGHTPANEL_W, 30 }, TEXT_ALIGN_CENTER, LIGHTGRAY);
+                        RIGHTPANEL_Y += 30 + PAD;
+                    }
                 // Draw properties only if selected
-                if (hasValidSelectedAnimation)
+                if (hasValidSelectedAnimation && CP->GetNumSelected() <= 1)
                     {
-                        DrawPropertiesIfValidPtr(Rectangle{ RIGHTPANEL_X + PAD, RIGHTPANEL_Y, RIGHTPANEL_W - PAD * 2.f, GetRenderHeight() - RIGHTPANEL_Y }, CP->PropertyPanel);
+                        DrawPropertiesIfValidPtr(Rectangle{ RIGHTPANEL_X + PAD, RIGHTPANEL_Y, RIGHTPANEL_W - PAD * 2.f, input::GetRenderHeight() - RIGHTPANEL_Y }, CP->PropertyPanel);
                     }
             }
 
             // Draw error string messagebox
             if (app.LastError.has_value())
                 {
-                    const auto result = GuiMessageBox(Rectangle{ 0, 0, (float)GetRenderWidth(), (float)GetRenderHeight() }, "Error", app.LastError->c_str(), "OK");
+                    const auto result = GuiMessageBox(Rectangle{ 0, 0, (float)input::GetRenderWidth(), (float)input::GetRenderHeight() }, "Error", app.LastError->c_str(), "OK");
                     if (result > 0)
                         {
                             app.LastError.reset();
                         }
                 }
+            else if (app.LastReport.has_value())
+                {
+                    const auto result = GuiMessageBox(Rectangle{ 0, 0, (float)input::GetRenderWidth(), (float)input::GetRenderHeight() }, "Report", app.LastReport->c_str(), "OK");
+                    if (result > 0)
+                        {
+                            app.LastReport.reset();
+                        }
+                }
 
             // Draw filename bottom left window
             {
-                DrawRectangle(0, GetRenderHeight() - 16, GetRenderWidth(), 16, DARKGRAY);
+                DrawRectangle(0, input::GetRenderHeight() - 16, input::GetRenderWidth(), 16, DARKGRAY);
                 if (CP->SpritePath.empty())
                     {
-                        DrawText("UNDO:CTRL+Z  REDO:CTRL+Y  SAVE:CTRL+S CENTER VIEW:CTRL+0", 10, GetRenderHeight() - 16, 16, WHITE);
+                        DrawTextCached("UNDO:CTRL+Z  REDO:CTRL+Y  SAVE:CTRL+S CENTER VIEW:CTRL+0", 10, input::GetRenderHeight() - 16, 16, WHITE);
                     }
                 else
                     {
-                        DrawText(CP->SpritePath.c_str(), 10, GetRenderHeight() - 16, 16, WHITE);
+                        DrawTextCached(CP->SpritePath.c_str(), 10, input::GetRenderHeight() - 16, 16, WHITE);
+
+                        // Frame issues next to the path, red when they block the export
+                        if (const auto& issues{ frameValidator.GetIssues() }; !issues.empty())
+                            {
+                                const bool  hasFatal{ std::any_of(issues.begin(), issues.end(), [](const ValidationIssue& issue) { return issue.Severity == EValidationSeverity::FATAL; }) };
+                                const char* label{ TextFormat("%zu frame issue%s", issues.size(), issues.size() == 1 ? "" : "s") };
+                                DrawTextCached(label, 10 + MeasureTextCached(CP->SpritePath.c_str(), 16) + 20, input::GetRenderHeight() - 16, 16, hasFatal ? RED : ORANGE);
+                            }
+
+                        // Page residency bottom right
+                        if (CP->GetNumPages() > 1)
+                            {
+                                std::string residency{};
+                                for (int32_t page{}; page < CP->GetNumPages(); ++page)
+                                    {
+                                        residency += "P" + std::to_string(page) + ":" + ToString(CP->GetPageResidency(page)) + "  ";
+                                    }
+                                residency += TextFormat("GPU %lld/%lld MB", static_cast<long long>(CP->PageTextures.GetResidentBytes() >> 20), static_cast<long long>(CP->PageTextures.GetBudgetBytes() >> 20));
+                                DrawTextCached(residency.c_str(), input::GetRenderWidth() - MeasureTextCached(residency.c_str(), 16) - 10, input::GetRenderHeight() - 16, 16, WHITE);
+                            }
                     }
             }
 
@@ -893,8 +1903,8 @@ main()
             {
                 Rectangle msgRect{ 0, 0, 600, 300 };
                 // Center the rect to the screen
-                msgRect.x = GetRenderWidth() / 2.f - msgRect.width / 2.f;
-                msgRect.y = GetRenderHeight() / 2.f - msgRect.height / 2.f;
+                msgRect.x = input::GetRenderWidth() / 2.f - msgRect.width / 2.f;
+                msgRect.y = input::GetRenderHeight() / 2.f - msgRect.height / 2.f;
 
                 if (ActiveModal == EModalType::CREATE_ANIMATION)
                     {
@@ -906,30 +1916,27 @@ main()
                         // Input box for animationNameOrPlaceholder
                         TextRect({ msgRect.x + PAD, msgRect.y + PAD + 30, msgRect.width - PAD * 2, 30 }, "Animation name:");
                         (void)(StringBox({ msgRect.x + PAD, msgRect.y + PAD + 60, msgRect.width - PAD * 2, 30 }, NewAnimationName, sizeof(NewAnimationName), NewAnimationEditMode));
-                        bool alreadyExists{ false };
-                        if (const auto found{ CP->AnimationNameToSpritesheet.find(NewAnimationName) }; found != CP->AnimationNameToSpritesheet.end())
-                            {
-                                alreadyExists = true;
-                            }
+                        const bool alreadyExists{ CP->HasAnimation(NewAnimationName) };
 
                         if (alreadyExists)
                             {
-                                DrawText("An animation with this name already exists!", msgRect.x + PAD, msgRect.y + PAD + 100, 16, RED);
+                                DrawTextCached("An animation with this name already exists!", msgRect.x + PAD, msgRect.y + PAD + 100, 16, RED);
                             }
                         else if (!NewAnimationName[0])
                             {
-                                DrawText("Must have at least one char!", msgRect.x + PAD, msgRect.y + PAD + 100, 16, RED);
+                                DrawTextCached("Must have at least one char!", msgRect.x + PAD, msgRect.y + PAD + 100, 16, RED);
                             }
                         else if (GuiButton({ msgRect.x + PAD, msgRect.y + msgRect.height - 30 - PAD, 100, 30 }, "Create"))
                             {
                                 ActiveModal = EModalType::NONE;
                                 // Create the animation
                                 SpritesheetUv spriteSheet{};
-                                spriteSheet.Uv = { 0, 0, app.GridSize, app.GridSize };
+                                spriteSheet.Uv                  = { 0, 0, app.GridSize, app.GridSize };
+                                spriteSheet.Property_Page.Value = viewedPage;
 
                                 AnimationData animData{ std::move(spriteSheet) };
-                                CP->AnimationNameToSpritesheet.emplace(std::string(NewAnimationName), std::move(animData));
-                                CP->ListState.activeIndex = CP->AnimationNameToSpritesheet.size() - 1;
+                                // Only the new animation is selected, the next bulk operation must not reach the previous selection
+                                CP->SelectOnly(CP->AddAnimation(NewAnimationName, std::move(animData)));
 
                                 CP->CommitNewAction();
                             }
@@ -943,17 +1950,57 @@ main()
                     {
                         assert(!CP->ImmutableTransientAnimationNames.empty());
                         std::string tmp{ "Delete " };
-                        tmp += CP->ImmutableTransientAnimationNames[CP->ListState.activeIndex];
+                        if (CP->GetNumSelected() > 1)
+                            {
+                                tmp += std::to_string(CP->GetNumSelected()) + " animations";
+                            }
+                        else
+                            {
+                                tmp += CP->ImmutableTransientAnimationNames[CP->ListState.activeIndex];
+                            }
 
                         if (GuiMessageBox(msgRect, "Confirm delete", tmp.c_str(), "Cancel;Delete") == 2)
                             {
                                 ActiveModal = EModalType::NONE;
 
-                                CP->AnimationNameToSpritesheet.erase(CP->ImmutableTransientAnimationNames[CP->ListState.activeIndex]);
-                                CP->ListState.activeIndex = -1;
-                                CP->RebuildAnimationNamesVectorAndRefreshPropertyPanel(CP->ListState.activeIndex);
+                                // The active animation is part of the selection
+                                CP->DeleteSelection();
+                            }
+                    }
+                else if (ActiveModal == EModalType::EXPORT)
+                    {
+                        if (const auto result = GuiMessageBox(msgRect, "Export", "Choose the export format", "Cancel;Binary;C++ header;DDS BC1;DDS BC3;Indexed PNG"); result >= 0)
+                            {
+                                ActiveModal = EModalType::NONE;
+                                switch (result)
+                                    {
+                                        case 2: // Binary
+                                            app.LastError = ExportBinary(*CP);
+                                            break;
+                                        case 3: // constexpr C++ header
+                                            app.LastError = ExportCppHeader(*CP);
+                                            break;
+                                        case 4: // Block compressed pages
+                                            app.LastError = ExportDds(*CP, EBlockFormat::BC1);
+                                            break;
+                                        case 5:
+                                            app.LastError = ExportDds(*CP, EBlockFormat::BC3);
+                                            break;
+                                        case 6: // 8 bit palette pages
+                                            {
+                                                uint64_t savedBytes{};
+                                                app.LastError = ExportIndexed(*CP, savedBytes);
+                                                if (!app.LastError.has_value())
+                                                    {
+                                                        app.LastReport = "Indexed export saves " + std::to_string(savedBytes / 1024) + " KiB of texture memory";
+                                                    }
+                                                break;
+                                            }
 
-                                CP->CommitNewAction();
+                                        case 1: // Cancel, just continue
+                                        default: // Cancel
+                                            break;
+                                    }
                             }
                     }
                 else if (ActiveModal == EModalType::CONFIRM_DISCARD_CHANGES)
@@ -969,8 +2016,9 @@ main()
                                             ActiveModal = EModalType::OPEN_FILE_DIALOG;
                                             break;
                                         case 2: // Discard, reset project
-                                            CP          = std::make_unique<Project>();
-                                            ActiveModal = EModalType::OPEN_FILE_DIALOG;
+                                            CP             = std::make_unique<Project>();
+                                            frameValidator = {};
+                                            ActiveModal    = EModalType::OPEN_FILE_DIALOG;
                                             break;
 
                                         case 1: // Cancel, just continue
@@ -980,12 +2028,61 @@ main()
                             }
                     }
             }
+            PROFILE_END(guiZone);
+
+#if defined(SPRITE_UV_PROFILER)
+            if (app.ShowProfiler)
+                {
+                    DrawProfilerOverlay({ PAD, 50.f + PAD });
+                }
+#endif
+            if (app.ShowMemoryPanel)
+                {
+                    DrawMemoryPanel({ input::GetRenderWidth() - VIEWPORT_GUI_RIGHT_PANEL_WIDTH - MEMORY_PANEL_WIDTH - PAD, 50.f + PAD }, memoryReport, ImageCache::Shared().GetStats(),
+                                    app.LogMemory ? MEMORY_LOG_PATH : nullptr);
+                }
 #pragma endregion GUI
 
-            EndDrawing();
+            PROFILE_COUNT_RENDER_BATCH();
+            {
+                PROFILE_SCOPE("EndDrawing");
+                EndDrawing();
+            }
+            TextLayoutCache::Shared().EndFrame();
+#if defined(SPRITE_UV_PROFILER)
+            frameRenderStats.TextMeasurements = TextLayoutCache::Shared().GetFrameMeasurements();
+            profiler::EndFrame(frameRenderStats);
+#endif
+            app.OnFrameEnd();
+            if (!commandLine.StartupReportPath.empty())
+                {
+                    if (const auto reportError{ app.WriteStartupReport(commandLine.StartupReportPath) }; reportError.has_value())
+                        {
+                            std::cout << reportError.value() << std::endl;
+                        }
+                    break;
+                }
 
 #pragma endregion Drawing
         }
 
+    input::StopRecording();
+    if (headless)
+        {
+            const auto& frameTimesMs{ input::GetReplayFrameTimesMs() };
+            std::cout << input::SummarizeFrameTimes(frameTimesMs).ToString() << std::endl;
+            if (const auto timingsError{ input::WriteFrameTimesCsv(commandLine.TimingsPath, frameTimesMs) }; timingsError.has_value())
+                {
+                    std::cout << timingsError.value() << std::endl;
+                }
+        }
+
+    // Release the project GPU resources while the window still exists
+    CP.reset();
+#if defined(SPRITE_UV_PROFILER)
+    rlSetRenderBatchActive(nullptr);
+    rlUnloadRenderBatch(profilerRenderBatch);
+#endif
+
     return 0;
 }
@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/** Binary runtime export layout, every value is little endian and every section starts 16 bytes aligned.
+ *
+ *  BinaryHeader
+ *  BinaryAnimation[AnimationCount]
+ *  BinaryFrameUv[FrameCount]        normalized by the size of the animation texture page
+ *  uint32_t[FrameCount]             frame durations in ms
+ *  BinaryLookupEntry[LookupCapacity] open addressing table, linear probing on the name hash
+ *  char[StringTableSize]            null terminated animation names
+ */
+namespace sprite_uv::binary
+{
+
+constexpr char     MAGIC[4]{ 'S', 'U', 'V', 'A' };
+constexpr uint32_t VERSION{ 1 };
+constexpr uint32_t ALIGNMENT{ 16 };
+constexpr uint32_t EMPTY_LOOKUP_INDEX{ 0xFFFFFFFFu };
+
+enum EAnimationFlags : uint32_t
+{
+    LOOPING = 1 << 0,
+};
+
+struct BinaryHeader
+{
+    char     Magic[4];
+    uint32_t Version;
+    uint32_t FileSize;
+    uint32_t TextureWidth; // Of page 0
+    uint32_t TextureHeight;
+    uint32_t AnimationCount;
+    uint32_t FrameCount;
+    uint32_t LookupCapacity;
+    uint32_t AnimationsOffset;
+    uint32_t FramesOffset;
+    uint32_t DurationsOffset;
+    uint32_t LookupOffset;
+    uint32_t StringTableOffset;
+    uint32_t StringTableSize;
+    uint32_t Reserved[2];
+};
+
+struct BinaryAnimation
+{
+    uint32_t NameOffset; // Relative to the string table
+    uint32_t NameLength;
+    uint32_t NameHash;
+    uint32_t FirstFrame;
+    uint32_t FrameCount;
+    uint32_t Flags;
+    uint32_t TotalDurationMs;
+    uint32_t Page; // Texture page, 0 is the main sprite
+};
+
+struct BinaryFrameUv
+{
+    float U0, V0, U1, V1;
+};
+
+struct BinaryLookupEntry
+{
+    uint32_t NameHash;
+    uint32_t AnimationIndex;
+};
+
+static_assert(sizeof(BinaryHeader) % ALIGNMENT == 0);
+static_assert(sizeof(BinaryAnimation) % ALIGNMENT == 0);
+static_assert(sizeof(BinaryFrameUv) == ALIGNMENT);
+static_assert(sizeof(BinaryLookupEntry) == 8);
+
+constexpr uint32_t
+AlignUp(uint32_t value)
+{
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/**
+ * \brief 32 bit FNV-1a, cheap and good enough for animation names.
+ */
+constexpr uint32_t
+HashName(std::string_view name)
+{
+    uint32_t hash{ 2166136261u };
+    for (const char c : name)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+    return hash;
+}
+
+/**
+ * \brief Smallest power of two holding the names with a load factor of at most 50%.
+ */
+constexpr uint32_t
+LookupCapacityFor(uint32_t animationCount)
+{
+    uint32_t capacity{ 2 };
+    while (capacity < animationCount * 2)
+        {
+            capacity <<= 1;
+        }
+    return capacity;
+}
+
+}
@@ -0,0 +1,364 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+// Header only, zero copy reader of the binary runtime export (.uvb).
+// Nothing is parsed or allocated: the views point straight into the loaded/mapped bytes.
+// The file is little endian, as every platform the editor targets.
+
+#include "binary_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sprite_uv
+{
+
+using binary::BinaryAnimation;
+using binary::BinaryFrameUv;
+
+/**
+ * \brief Minimal read only span, std::span is C++20.
+ */
+template<typename T>
+class Span
+{
+  public:
+    constexpr Span() = default;
+    constexpr Span(const T* data, size_t size) : _data{ data }, _size{ size } {}
+
+    constexpr const T* begin() const { return _data; }
+    constexpr const T* end() const { return _data + _size; }
+    constexpr const T* data() const { return _data; }
+    constexpr size_t   size() const { return _size; }
+    constexpr bool     empty() const { return _size == 0; }
+    constexpr const T& operator[](size_t index) const { return _data[index]; }
+
+  private:
+    const T* _data{};
+    size_t   _size{};
+};
+
+/**
+ * \brief Compile time name hash, lets the caller precompute the lookup key: `set.FindByHash(sprite_uv::HashName("Idle"))`.
+ */
+constexpr uint32_t
+HashName(std::string_view name)
+{
+    return binary::HashName(name);
+}
+
+/**
+ * \brief View over an exported animation set, the memory must outlive the view.
+ */
+class AnimationSet
+{
+  public:
+    AnimationSet() = default;
+
+    /**
+     * \brief Validates the header, the section bounds and every animation record once so the lookups and samples never read out of the file.
+     * No copy is made.
+     */
+    static std::optional<AnimationSet> FromMemory(const void* data, size_t size)
+    {
+        using namespace binary;
+
+        const auto* bytes{ static_cast<const uint8_t*>(data) };
+        if (!bytes || size < sizeof(BinaryHeader) || reinterpret_cast<uintptr_t>(bytes) % alignof(BinaryHeader) != 0)
+            {
+                return {};
+            }
+
+        const auto* header{ reinterpret_cast<const BinaryHeader*>(bytes) };
+        if (std::memcmp(header->Magic, MAGIC, sizeof(MAGIC)) != 0 || header->Version != VERSION || header->FileSize > size)
+            {
+                return {};
+            }
+
+        const auto inBounds = [&](uint32_t offset, uint64_t count, uint64_t elementSize) {
+            return offset % ALIGNMENT == 0 && offset + count * elementSize <= header->FileSize;
+        };
+        if (!inBounds(header->AnimationsOffset, header->AnimationCount, sizeof(BinaryAnimation)) || !inBounds(header->FramesOffset, header->FrameCount, sizeof(BinaryFrameUv)) ||
+            !inBounds(header->DurationsOffset, header->FrameCount, sizeof(uint32_t)) || !inBounds(header->LookupOffset, header->LookupCapacity, sizeof(BinaryLookupEntry)) ||
+            !inBounds(header->StringTableOffset, header->StringTableSize, 1) || header->LookupCapacity == 0 || (header->LookupCapacity & (header->LookupCapacity - 1)) != 0 ||
+            static_cast<uint64_t>(header->AnimationCount) * 2 > header->LookupCapacity)
+            {
+                return {};
+            }
+
+        // The frames and the null terminated name of every animation must be inside their sections
+        const auto* animations{ reinterpret_cast<const BinaryAnimation*>(bytes + header->AnimationsOffset) };
+        const auto* strings{ reinterpret_cast<const char*>(bytes + header->StringTableOffset) };
+        for (uint32_t i{}; i < header->AnimationCount; ++i)
+            {
+                const BinaryAnimation& animation{ animations[i] };
+                if (animation.FrameCount == 0 || static_cast<uint64_t>(animation.FirstFrame) + animation.FrameCount > header->FrameCount ||
+                    static_cast<uint64_t>(animation.NameOffset) + animation.NameLength >= header->StringTableSize || strings[animation.NameOffset + animation.NameLength] != '\0')
+                    {
+                        return {};
+                    }
+            }
+
+        AnimationSet set{};
+        set._header     = header;
+        set._animations = { animations, header->AnimationCount };
+        set._frames     = { reinterpret_cast<const BinaryFrameUv*>(bytes + header->FramesOffset), header->FrameCount };
+        set._durations  = { reinterpret_cast<const uint32_t*>(bytes + header->DurationsOffset), header->FrameCount };
+        set._lookup     = { reinterpret_cast<const BinaryLookupEntry*>(bytes + header->LookupOffset), header->LookupCapacity };
+        set._strings    = strings;
+        return set;
+    }
+
+    uint32_t                    GetTextureWidth() const { return _header->TextureWidth; }
+    uint32_t                    GetTextureHeight() const { return _header->TextureHeight; }
+    Span<BinaryAnimation>       GetAnimations() const { return _animations; }
+    Span<BinaryFrameUv>         GetFrames(const BinaryAnimation& animation) const { return { _frames.data() + animation.FirstFrame, animation.FrameCount }; }
+    Span<uint32_t>              GetDurations(const BinaryAnimation& animation) const { return { _durations.data() + animation.FirstFrame, animation.FrameCount }; }
+    std::string_view            GetName(const BinaryAnimation& animation) const { return { _strings + animation.NameOffset, animation.NameLength }; }
+    const char*                 GetNameCStr(const BinaryAnimation& animation) const { return _strings + animation.NameOffset; }
+    static constexpr bool       IsLooping(const BinaryAnimation& animation) { return animation.Flags & binary::EAnimationFlags::LOOPING; }
+    static constexpr uint32_t   GetPage(const BinaryAnimation& animation) { return animation.Page; }
+
+    /**
+     * \brief O(1) lookup on a precomputed hash, does not compare the names thus a colliding unknown name may return another animation.
+     */
+    const BinaryAnimation* FindByHash(uint32_t nameHash) const
+    {
+        return Probe(nameHash, [](const BinaryAnimation&) { return true; });
+    }
+
+    /**
+     * \brief O(1) lookup by name, the name is compared to resolve hash collisions.
+     */
+    const BinaryAnimation* Find(std::string_view name) const
+    {
+        return Probe(HashName(name), [&](const BinaryAnimation& animation) { return GetName(animation) == name; });
+    }
+
+    /**
+     * \brief Frame index at the time since the animation started, non looping animations stop on the last frame.
+     */
+    uint32_t SampleFrameIndex(const BinaryAnimation& animation, int64_t timeMs) const
+    {
+        if (animation.FrameCount <= 1 || animation.TotalDurationMs == 0 || timeMs <= 0)
+            {
+                return 0;
+            }
+
+        const uint64_t time{ static_cast<uint64_t>(timeMs) };
+        if (!IsLooping(animation) && time >= animation.TotalDurationMs)
+            {
+                return animation.FrameCount - 1;
+            }
+
+        const uint64_t  localTime{ time % animation.TotalDurationMs };
+        const uint32_t* durations{ _durations.data() + animation.FirstFrame };
+        // Spritesheets share the same duration on every frame
+        if (static_cast<uint64_t>(durations[0]) * animation.FrameCount == animation.TotalDurationMs)
+            {
+                return static_cast<uint32_t>(localTime / durations[0]);
+            }
+
+        uint64_t elapsed{};
+        for (uint32_t i{}; i < animation.FrameCount; ++i)
+            {
+                elapsed += durations[i];
+                if (localTime < elapsed)
+                    {
+                        return i;
+                    }
+            }
+        return animation.FrameCount - 1;
+    }
+
+    /**
+     * \brief The normalized UV of the frame shown at the given time.
+     */
+    const BinaryFrameUv& Sample(const BinaryAnimation& animation, int64_t timeMs) const { return _frames[animation.FirstFrame + SampleFrameIndex(animation, timeMs)]; }
+
+  private:
+    template<typename Predicate>
+    const BinaryAnimation* Probe(uint32_t nameHash, Predicate&& matches) const
+    {
+        // Linear probing, the load factor is at most 50% but a corrupt table may have no empty slot, every slot is visited at most once
+        const uint32_t mask{ static_cast<uint32_t>(_lookup.size()) - 1 };
+        uint32_t       slot{ nameHash & mask };
+        for (uint32_t probes{}; probes < _lookup.size(); ++probes, slot = (slot + 1) & mask)
+            {
+                const auto& entry{ _lookup[slot] };
+                if (entry.AnimationIndex == binary::EMPTY_LOOKUP_INDEX)
+                    {
+                        return nullptr;
+                    }
+                if (entry.NameHash == nameHash && entry.AnimationIndex < _animations.size() && matches(_animations[entry.AnimationIndex]))
+                    {
+                        return &_animations[entry.AnimationIndex];
+                    }
+            }
+        return nullptr;
+    }
+
+    const binary::BinaryHeader*     _header{};
+    Span<BinaryAnimation>           _animations{};
+    Span<BinaryFrameUv>             _frames{};
+    Span<uint32_t>                  _durations{};
+    Span<binary::BinaryLookupEntry> _lookup{};
+    const char*                     _strings{};
+};
+
+/**
+ * \brief Read only memory mapped file, the mapping is page aligned thus satisfies the export alignment.
+ */
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+            {
+                Close();
+                std::swap(_data, other._data);
+                std::swap(_size, other._size);
+#if defined(_WIN32)
+                std::swap(_file, other._file);
+                std::swap(_mapping, other._mapping);
+#endif
+            }
+        return *this;
+    }
+    ~MappedFile() { Close(); }
+
+    bool Open(const char* path)
+    {
+        Close();
+#if defined(_WIN32)
+        _file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(_file, &fileSize) || fileSize.QuadPart == 0)
+            {
+                Close();
+                return false;
+            }
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!_mapping)
+            {
+                Close();
+                return false;
+            }
+        _data = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+        _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        const int fd{ ::open(path, O_RDONLY) };
+        if (fd < 0)
+            {
+                return false;
+            }
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+        void* mapped{ ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+            {
+                return false;
+            }
+        _data = mapped;
+        _size = static_cast<size_t>(fileStat.st_size);
+#endif
+        return _data != nullptr;
+    }
+
+    void Close()
+    {
+#if defined(_WIN32)
+        if (_data)
+            {
+                UnmapViewOfFile(_data);
+            }
+        if (_mapping)
+            {
+                CloseHandle(_mapping);
+            }
+        if (_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(_file);
+            }
+        _mapping = nullptr;
+        _file    = INVALID_HANDLE_VALUE;
+#else
+        if (_data)
+            {
+                ::munmap(const_cast<void*>(_data), _size);
+            }
+#endif
+        _data = nullptr;
+        _size = 0;
+    }
+
+    const void* Data() const { return _data; }
+    size_t      Size() const { return _size; }
+
+  private:
+    const void* _data{};
+    size_t      _size{};
+#if defined(_WIN32)
+    HANDLE _file{ INVALID_HANDLE_VALUE };
+    HANDLE _mapping{};
+#endif
+};
+
+}
@@ -24,22 +24,76 @@ SOFTWARE.
 
 #include "app.hpp"
 
+#include "embedded_resources.hpp"
+#include "font_cache.hpp"
+#include "image_cache.hpp"
+#include "input.hpp"
+#include "memory_stats.hpp"
+
 #include "tinyfiledialogs.h"
 
+#include <nlohmann/json.hpp>
+
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 
-App::App(int32_t width, int32_t height, const char* title)
+namespace
+{
+// Initialized with the other globals before main, the closest to the process start without platform calls
+const auto processStart{ std::chrono::steady_clock::now() };
+
+double
+GetMillisecondsSince(std::chrono::steady_clock::time_point start)
 {
-    SetConfigFlags(FLAG_WINDOW_MAXIMIZED | FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT);
-    InitWindow(1600, 900, title);
-
-    SetTargetFPS(GetMonitorRefreshRate(0));
-    // Combine the current path with the icons folder
-    const std::filesystem::path currentPath{ std::filesystem::current_path() };
-    const auto                  iconsFolderPath{ currentPath / "icons" };
-    const auto                  iconPath{ iconsFolderPath / "uvEdit.png" };
-    Image                       icon = LoadImage(iconPath.string().c_str());
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+App::App(int32_t width, int32_t height, const char* title, bool headless)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    SetConfigFlags(headless ? FLAG_WINDOW_HIDDEN : FLAG_WINDOW_MAXIMIZED | FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT);
+    InitWindow(width, height, title);
+
+    SetTargetFPS(headless ? 0 : GetMonitorRefreshRate(0));
+    startupTimings.WindowMilliseconds = GetMillisecondsSince(start);
+
+    // The only resource the first frame needs, rasterized once then uploaded from the cache directory of the decoded images
+    start = std::chrono::steady_clock::now();
+    if (const auto* fontResource{ resources::Find("fonts/Roboto-Bold.ttf") })
+        {
+            fontRoboto = LoadFontCached(fontResource->Data, fontResource->Size, 16, 250, ImageCache::Shared().GetDirectory(), &startupTimings.FontFromCache);
+        }
+    if (!fontRoboto.texture.id || fontRoboto.texture.id == GetFontDefault().texture.id)
+        {
+            std::cout << "Failed to load Roboto font, falling back to default font." << std::endl;
+            fontRoboto = {};
+        }
+    startupTimings.FontMilliseconds = GetMillisecondsSince(start);
+}
+
+void
+App::OnFrameEnd()
+{
+    if (firstFrameDone)
+        {
+            return;
+        }
+    firstFrameDone                        = true;
+    startupTimings.FirstFrameMilliseconds = GetMillisecondsSince(processStart);
+
+    const auto start{ std::chrono::steady_clock::now() };
+    LoadDeferredResources();
+    startupTimings.DeferredMilliseconds = GetMillisecondsSince(start);
+}
+
+void
+App::LoadDeferredResources()
+{
+    const auto* iconResource{ resources::Find("icons/uvEdit.png") };
+    Image       icon = iconResource ? LoadImageFromMemory(".png", iconResource->Data, static_cast<int32_t>(iconResource->Size)) : Image{};
     if (icon.data)
         {
             SetWindowIcon(icon);
@@ -50,24 +104,35 @@ App::App(int32_t width, int32_t height, const char* title)
             std::cout << "Failed to load window icon!" << std::endl;
         }
 
-    const auto fontsFolderPath{ currentPath / "fonts" };
-    const auto fontPath{ fontsFolderPath / "Roboto-Bold.ttf" };
-    fontRoboto = LoadFontEx(fontPath.string().c_str(), 16, nullptr, 250);
-    if (!fontRoboto.texture.id)
-        {
-            std::cout << "Failed to load Roboto font, falling back to default font." << std::endl;
-        }
-
     // Create the checkerboard texture
     const int32_t CHECKER_SIZE{ 16 };
     Image         checkerImage = GenImageChecked(CHECKER_SIZE * 2, CHECKER_SIZE * 2, CHECKER_SIZE, CHECKER_SIZE, Color{ 130, 130, 130, 255 }, Color{ 160, 160, 160, 255 });
     CheckerBoardTexture        = LoadTextureFromImage(checkerImage);
+    UnloadImage(checkerImage);
     if (CheckerBoardTexture.id == 0)
         {
             std::cout << "Failed to create checkerboard texture!" << std::endl;
         }
 }
 
+std::optional<std::string>
+App::WriteStartupReport(const std::string& path) const
+{
+    nlohmann::ordered_json report{};
+    report["window_ms"]      = startupTimings.WindowMilliseconds;
+    report["font_ms"]        = startupTimings.FontMilliseconds;
+    report["font_cached"]    = startupTimings.FontFromCache;
+    report["first_frame_ms"] = startupTimings.FirstFrameMilliseconds;
+    report["deferred_ms"]    = startupTimings.DeferredMilliseconds;
+
+    std::ofstream fileStream{ path };
+    if (!fileStream || !(fileStream << report.dump(4) << std::endl))
+        {
+            return "Failed to write the startup report to " + path;
+        }
+    return {};
+}
+
 App::~App()
 {
     if (fontRoboto.texture.id)
@@ -81,6 +146,21 @@ App::~App()
     CloseWindow();
 }
 
+void
+App::ReportMemory(MemoryReport& report) const
+{
+    report.AddTexture("gpu/checkerboard", CheckerBoardTexture);
+    report.AddTexture("gpu/font_atlas", fontRoboto.texture);
+    // Glyph metrics stay on the CPU for the glyph lookup, the font cache drops the glyph images
+    int64_t glyphBytes{ static_cast<int64_t>(fontRoboto.glyphCount) * static_cast<int64_t>(sizeof(GlyphInfo) + sizeof(Rectangle)) };
+    for (int32_t i{}; fontRoboto.glyphs && i < fontRoboto.glyphCount; ++i)
+        {
+            const Image& glyphImage{ fontRoboto.glyphs[i].image };
+            glyphBytes += glyphImage.data ? GetPixelDataSize(glyphImage.width, glyphImage.height, glyphImage.format) : 0;
+        }
+    report.Add("cpu/font_glyphs", glyphBytes, fontRoboto.glyphCount);
+}
+
 bool
 App::ShouldRun() const
 {
@@ -90,11 +170,17 @@ App::ShouldRun() const
 bool
 App::OpenFileDialog(std::string& filePath, const std::vector<std::string>& extension) const
 {
+    if (input::IsReplaying())
+        {
+            return input::TakeReplayedDialogResult(filePath);
+        }
+
     std::vector<const char*> extensions;
     extensions.reserve(extension.size());
     std::transform(extension.begin(), extension.end(), std::back_inserter(extensions), [](const std::string& str) { return str.c_str(); });
 
     const char* result{ tinyfd_openFileDialog("Select a file", NULL, extension.size(), extensions.data(), nullptr, 0) };
+    input::RecordDialogResult(result);
     if (result)
         {
             filePath = std::string(result);
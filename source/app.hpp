@@ -32,6 +32,20 @@ SOFTWARE.
 
 #include "raylib.h"
 
+class MemoryReport;
+
+/**
+ * \brief Milliseconds spent on the way to the first frame, the first frame is measured from the process start.
+ */
+struct StartupTimings
+{
+    double WindowMilliseconds{};
+    double FontMilliseconds{};
+    double FirstFrameMilliseconds{};
+    double DeferredMilliseconds{};
+    bool   FontFromCache{};
+};
+
 class App final
 {
   public:
@@ -39,17 +53,42 @@ class App final
     bool                       GridSizeInputActive{}; // Gui box active state
     bool                       DrawGrid{ true };
     bool                       SnapToGrid{ true };
+    bool                       ShowGallery{};
+    bool                       ShowMemoryPanel{};
+    bool                       LogMemory{};
+#if defined(SPRITE_UV_PROFILER)
+    bool ShowProfiler{};
+#endif
     std::optional<std::string> LastError{};
+    std::optional<std::string> LastReport{};
+    /**
+     * \brief Created after the first frame, not drawn before.
+     */
     Texture2D                  CheckerBoardTexture{};
 
-    App(int32_t width, int32_t height, const char* title);
+    /**
+     * \brief A headless app has a hidden fixed size window and no frame rate limit, used to replay recorded sessions.
+     */
+    App(int32_t width, int32_t height, const char* title, bool headless = false);
     ~App();
     bool ShouldRun() const;
+    /**
+     * \brief Called after every EndDrawing, the first call records the first frame and loads the resources that are not needed to draw it.
+     */
+    void OnFrameEnd();
+
+    const StartupTimings& GetStartupTimings() const { return startupTimings; }
+    std::optional<std::string> WriteStartupReport(const std::string& path) const;
 
     Font GetFont() const { return fontRoboto; }
+    void ReportMemory(MemoryReport& report) const;
 
     bool OpenFileDialog(std::string& filePath, const std::vector<std::string>& extension) const;
 
   private:
-    Font fontRoboto{};
+    void LoadDeferredResources();
+
+    Font           fontRoboto{};
+    StartupTimings startupTimings{};
+    bool           firstFrameDone{};
 };
@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * \brief Counts what reaches the heap, the upstream of the arenas.
+ */
+class CountingResource final : public std::pmr::memory_resource
+{
+  public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) : _upstream{ upstream } {}
+
+    int64_t GetBytes() const { return _bytes; }
+    int64_t GetAllocations() const { return _allocations; }
+
+  private:
+    std::pmr::memory_resource* _upstream{};
+    int64_t                    _bytes{};
+    int64_t                    _allocations{};
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        void* memory{ _upstream->allocate(bytes, alignment) };
+        _bytes += static_cast<int64_t>(bytes);
+        ++_allocations;
+        return memory;
+    }
+
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override
+    {
+        _upstream->deallocate(memory, bytes, alignment);
+        _bytes -= static_cast<int64_t>(bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+/**
+ * \brief Monotonic arena: allocations are a pointer bump inside big blocks, nothing is freed until Release drops everything at once.
+ * Not thread safe, single owner.
+ */
+class Arena final
+{
+  public:
+    explicit Arena(size_t initialBytes = 16 * 1024) : _resource{ initialBytes, &_upstream } {}
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    std::pmr::memory_resource* Get() { return &_resource; }
+    /**
+     * \brief Every object allocated from the arena must be destroyed or cleared first.
+     */
+    void Release() { _resource.release(); }
+
+    /**
+     * \brief The bytes of the blocks currently held.
+     */
+    int64_t GetReservedBytes() const { return _upstream.GetBytes(); }
+    /**
+     * \brief The number of blocks requested since the creation.
+     */
+    int64_t GetNumBlockAllocations() const { return _upstream.GetAllocations(); }
+
+  private:
+    // Declared first, outlives the resource that returns its blocks to it
+    CountingResource                    _upstream{};
+    std::pmr::monotonic_buffer_resource _resource;
+};
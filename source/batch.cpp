@@ -0,0 +1,791 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "batch.hpp"
+
+#include "content_hash.hpp"
+#include "export.hpp"
+#include "export_cache.hpp"
+#include "texture_cache.hpp"
+#include "texture_compression.hpp"
+#include "thread_pool.hpp"
+
+#include "raylib.h"
+
+#include <sprite_uv/binary_format.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace batch
+{
+namespace
+{
+// The formats of the open sprite dialog
+constexpr std::string_view SPRITE_EXTENSIONS[]{ ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif" };
+
+bool
+IsSpritePath(const std::filesystem::path& path)
+{
+    std::string extension{ path.extension().string() };
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    // The indexed exports are not sprites of their own
+    if (path.stem().extension() == ".indexed")
+        {
+            return false;
+        }
+    return std::find(std::begin(SPRITE_EXTENSIONS), std::end(SPRITE_EXTENSIONS), extension) != std::end(SPRITE_EXTENSIONS);
+}
+
+/**
+ * \brief The project file is named after the sprite, the sprite is found back by trying the supported extensions.
+ */
+std::optional<std::filesystem::path>
+FindSpriteOfProject(const std::filesystem::path& projectPath)
+{
+    for (const auto extension : SPRITE_EXTENSIONS)
+        {
+            auto spritePath{ std::filesystem::path{ projectPath }.replace_extension(extension) };
+            if (std::filesystem::is_regular_file(spritePath))
+                {
+                    return spritePath;
+                }
+        }
+    return {};
+}
+
+const char*
+ToString(EStatus status)
+{
+    switch (status)
+        {
+            case EStatus::OK: return "ok";
+            case EStatus::INVALID: return "invalid";
+            case EStatus::FAILED: return "failed";
+        }
+    return "";
+}
+
+// The formats having outputs of their own, the json export rewrites the project file
+constexpr uint32_t OUTPUT_FORMATS[]{ EExportFormat::BINARY, EExportFormat::HEADER, EExportFormat::COMPACT, EExportFormat::BC1, EExportFormat::BC3, EExportFormat::INDEXED };
+
+struct ExportTarget
+{
+    std::filesystem::path Path{};
+    uint32_t              Format{};
+    /**
+     * \brief The compressed page, -1 for the exports of the animations.
+     */
+    int32_t               Page{ -1 };
+};
+
+std::vector<ExportTarget>
+GetExportTargets(const LoadedProject& project, uint32_t format)
+{
+    const auto& spritePath{ project.SpritePath };
+    switch (format)
+        {
+            case EExportFormat::BINARY: return { { GetBinaryExportPath(spritePath), format } };
+            case EExportFormat::HEADER: return { { GetCppHeaderExportPath(spritePath), format } };
+            case EExportFormat::COMPACT: return { { spritePath.parent_path() / (spritePath.stem().string() + ".min.json"), format } };
+            case EExportFormat::BC1:
+            case EExportFormat::BC3:
+                {
+                    std::vector<ExportTarget> targets{};
+                    for (size_t page{}; page < project.PagePaths.size(); ++page)
+                        {
+                            targets.push_back({ GetDdsExportPath(project.PagePaths[page]), format, static_cast<int32_t>(page) });
+                        }
+                    return targets;
+                }
+            case EExportFormat::INDEXED:
+                {
+                    std::vector<ExportTarget> targets{};
+                    for (size_t page{}; page < project.PagePaths.size(); ++page)
+                        {
+                            targets.push_back({ GetIndexedExportPath(project.PagePaths[page]), format, static_cast<int32_t>(page) });
+                        }
+                    return targets;
+                }
+        }
+    return {};
+}
+
+/**
+ * \brief The bytes of the output.
+ * \param outSavedBytes The texture memory saved by an indexed page, left untouched by the other formats.
+ * \return The error string if a page can not be decoded.
+ */
+std::optional<std::string>
+BuildExport(const LoadedProject& project, const ExportTarget& target, std::string& outData, uint64_t& outSavedBytes)
+{
+    switch (target.Format)
+        {
+            case EExportFormat::BINARY:
+                {
+                    const auto buffer{ BuildBinaryExport(project.Json, project.PageSizes) };
+                    if (buffer.empty())
+                        {
+                            return "An animation lasts longer than the binary export can hold";
+                        }
+                    outData.assign(buffer.begin(), buffer.end());
+                    return {};
+                }
+            case EExportFormat::HEADER: outData = BuildCppHeaderExport(project.Json, project.PageSizes, GetCppHeaderNamespace(project.SpritePath)); return {};
+            case EExportFormat::COMPACT: outData = project.Json.dump(); return {};
+            case EExportFormat::BC1:
+            case EExportFormat::BC3:
+                {
+                    std::vector<uint8_t> file{};
+                    const auto           format{ target.Format == EExportFormat::BC1 ? EBlockFormat::BC1 : EBlockFormat::BC3 };
+                    if (auto buildError{ BuildDdsExport(project.PagePaths[target.Page], format, file) }; buildError.has_value())
+                        {
+                            return buildError;
+                        }
+                    outData.assign(file.begin(), file.end());
+                    return {};
+                }
+            case EExportFormat::INDEXED:
+                {
+                    std::vector<uint8_t> file{};
+                    if (auto buildError{ BuildIndexedExport(project.PagePaths[target.Page], file, outSavedBytes) }; buildError.has_value())
+                        {
+                            return buildError;
+                        }
+                    outData.assign(file.begin(), file.end());
+                    return {};
+                }
+        }
+    return {};
+}
+
+template<typename T>
+const T*
+FindByPath(const std::vector<T>& files, const std::string& path)
+{
+    const auto it{ std::find_if(files.begin(), files.end(), [&path](const T& file) { return file.Path == path; }) };
+    return it != files.end() ? &*it : nullptr;
+}
+
+/**
+ * \brief The requested outputs of a cached project, the json export counts as one.
+ */
+size_t
+CountOutputs(const ExportCache::Entry& entry, uint32_t exports)
+{
+    const auto numOutputs{ std::count_if(entry.Outputs.begin(), entry.Outputs.end(), [exports](const ExportCache::Output& output) { return (exports & output.Format) != 0; }) };
+    return static_cast<size_t>(numOutputs) + ((exports & EExportFormat::JSON) ? 1 : 0);
+}
+
+/**
+ * \brief Hash of everything the output depends on, an output written under the same key holds the same bytes.
+ */
+uint64_t
+ComputeExportKey(const ExportTarget& target, std::string_view state, const std::vector<uint64_t>& pageHashes, const std::filesystem::path& spritePath)
+{
+    ContentHasher hasher{};
+    hasher.UpdateValue(ExportCache::VERSION);
+    hasher.UpdateValue(sprite_uv::binary::VERSION);
+    hasher.UpdateValue(target.Format);
+    // A compressed page only depends on its image
+    if (target.Page >= 0)
+        {
+            hasher.UpdateValue(pageHashes[target.Page]);
+            return hasher.Digest();
+        }
+    // The only export option, derived from the sprite name
+    if (target.Format == EExportFormat::HEADER)
+        {
+            hasher.Update(GetCppHeaderNamespace(spritePath));
+        }
+    hasher.Update(state);
+    for (const uint64_t pageHash : pageHashes)
+        {
+            hasher.UpdateValue(pageHash);
+        }
+    return hasher.Digest();
+}
+
+/**
+ * \brief Every input and every requested output kept its stamp since the cached run, the project is skipped without being read.
+ */
+bool
+IsUpToDate(const ExportCache::Entry& entry, uint32_t exports)
+{
+    if ((exports & ~entry.Formats) != 0)
+        {
+            return false;
+        }
+    for (const auto& input : entry.Inputs)
+        {
+            if (GetFileStamp(input.Path) != input.Stamp)
+                {
+                    return false;
+                }
+        }
+    for (const auto& output : entry.Outputs)
+        {
+            if ((exports & output.Format) && GetFileStamp(output.Path) != output.Stamp)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+/**
+ * \brief Writes the outputs whose key is not in the cache, then records the project.
+ */
+std::optional<std::string>
+ExportProjectCached(ExportCache&                             cache,
+                    const std::string&                       cacheKey,
+                    const std::optional<ExportCache::Entry>& previous,
+                    const LoadedProject&                     project,
+                    FileStamp                                projectStamp,
+                    uint32_t                                 exports,
+                    ProjectResult&                           result)
+{
+    ExportCache::Entry entry{};
+    entry.Warnings = result.Issues;
+
+    // The hash of an untouched page is reused, only the edited images are read
+    std::vector<uint64_t> pageHashes{};
+    pageHashes.reserve(project.PagePaths.size());
+    for (const auto& pagePath : project.PagePaths)
+        {
+            ExportCache::Input input{ pagePath.string(), GetFileStamp(pagePath), 0 };
+            const auto*        cachedInput{ previous.has_value() ? FindByPath(previous->Inputs, input.Path) : nullptr };
+            input.Hash = cachedInput && cachedInput->Stamp == input.Stamp ? cachedInput->Hash : HashFile(pagePath).value_or(0);
+            pageHashes.push_back(input.Hash);
+            entry.Inputs.push_back(std::move(input));
+        }
+    const std::string state{ project.Json.dump() };
+
+    size_t numHits{};
+    size_t numMisses{};
+    for (const uint32_t format : OUTPUT_FORMATS)
+        {
+            for (const auto& target : GetExportTargets(project, format))
+                {
+                    const std::string outputPath{ target.Path.string() };
+                    const uint64_t    key{ ComputeExportKey(target, state, pageHashes, project.SpritePath) };
+                    const auto*       cachedOutput{ previous.has_value() ? FindByPath(previous->Outputs, outputPath) : nullptr };
+                    if (cachedOutput && (cachedOutput->Format != format || cachedOutput->Key != key))
+                        {
+                            cachedOutput = nullptr;
+                        }
+
+                    if (!(exports & format))
+                        {
+                            // Still valid for a later build requesting it
+                            if (cachedOutput)
+                                {
+                                    entry.Outputs.push_back(*cachedOutput);
+                                }
+                            continue;
+                        }
+                    // An output touched by another tool is kept if its bytes did not change
+                    const FileStamp outputStamp{ GetFileStamp(target.Path) };
+                    if (cachedOutput && (outputStamp == cachedOutput->Stamp || HashFile(target.Path) == cachedOutput->Hash))
+                        {
+                            entry.Outputs.push_back(*cachedOutput);
+                            entry.Outputs.back().Stamp = outputStamp;
+                            result.SavedTextureBytes += cachedOutput->SavedBytes;
+                            ++numHits;
+                            continue;
+                        }
+
+                    // Regenerated, but the same bytes are not written again so the timestamp of the output does not trigger the downstream steps
+                    std::string data{};
+                    uint64_t    savedBytes{};
+                    if (auto buildError{ BuildExport(project, target, data, savedBytes) }; buildError.has_value())
+                        {
+                            return buildError;
+                        }
+                    result.SavedTextureBytes += savedBytes;
+                    const uint64_t dataHash{ HashBytes(data.data(), data.size()) };
+                    if (HashFile(target.Path) == dataHash)
+                        {
+                            entry.Outputs.push_back({ outputPath, format, key, outputStamp, dataHash, savedBytes });
+                            ++numHits;
+                            continue;
+                        }
+                    if (auto writeError{ WriteFileAtomically(target.Path, data.data(), data.size()) }; writeError.has_value())
+                        {
+                            return writeError;
+                        }
+                    result.Outputs.push_back(outputPath);
+                    entry.Outputs.push_back({ outputPath, format, key, GetFileStamp(target.Path), dataHash, savedBytes });
+                    ++numMisses;
+                }
+        }
+    for (const auto& output : entry.Outputs)
+        {
+            entry.Formats |= output.Format;
+        }
+
+    const auto projectPath{ std::filesystem::path{ project.SpritePath }.replace_extension(".json") };
+    const auto formatted{ project.Json.dump(4) };
+    if (formatted == project.Content)
+        {
+            entry.Formats |= EExportFormat::JSON;
+            numHits += (exports & EExportFormat::JSON) ? 1 : 0;
+        }
+    else if (exports & EExportFormat::JSON)
+        {
+            if (auto writeError{ WriteFileAtomically(projectPath, formatted.data(), formatted.size()) }; writeError.has_value())
+                {
+                    return writeError;
+                }
+            result.Outputs.push_back(projectPath.string());
+            entry.Formats |= EExportFormat::JSON;
+            projectStamp = GetFileStamp(projectPath);
+            ++numMisses;
+        }
+    entry.Inputs.insert(entry.Inputs.begin(), { projectPath.string(), projectStamp, 0 });
+
+    result.NumCachedOutputs = numHits;
+    cache.CountHits(numHits);
+    cache.CountMisses(numMisses);
+    cache.Store(cacheKey, std::move(entry));
+    return {};
+}
+
+std::optional<std::string>
+Process(const std::filesystem::path& spritePath, uint32_t exports, ExportCache* cache, ProjectResult& result)
+{
+    // Relative inputs of another working directory still find their entry
+    const std::string                 cacheKey{ std::filesystem::absolute(spritePath).lexically_normal().string() };
+    std::optional<ExportCache::Entry> cached{};
+    if (cache)
+        {
+            cached = cache->Find(cacheKey);
+            if (cached.has_value() && IsUpToDate(cached.value(), exports))
+                {
+                    result.Issues           = std::move(cached->Warnings);
+                    result.NumCachedOutputs = CountOutputs(cached.value(), exports);
+                    for (const auto& output : cached->Outputs)
+                        {
+                            result.SavedTextureBytes += (exports & output.Format) ? output.SavedBytes : 0;
+                        }
+                    cache->CountHits(result.NumCachedOutputs);
+                    return {};
+                }
+        }
+
+    // Stamped before reading, an edit made during the export is detected by the next build
+    const FileStamp projectStamp{ GetFileStamp(std::filesystem::path{ spritePath }.replace_extension(".json")) };
+    LoadedProject   project{};
+    if (auto loadError{ LoadProject(spritePath, project) }; loadError.has_value())
+        {
+            return loadError;
+        }
+    result.Issues = project.Issues;
+    if (HasValidationErrors(result.Issues))
+        {
+            result.Status = EStatus::INVALID;
+            if (cache)
+                {
+                    cache->Erase(cacheKey);
+                }
+            return {};
+        }
+    if (exports & (EExportFormat::BC1 | EExportFormat::BC3))
+        {
+            const auto misaligned{ FindBlockMisalignedAnimations(project.Json) };
+            result.Issues.insert(result.Issues.end(), misaligned.begin(), misaligned.end());
+        }
+    if (!cache)
+        {
+            return ExportProject(project, exports, result.Outputs, &result.SavedTextureBytes);
+        }
+    return ExportProjectCached(*cache, cacheKey, cached, project, projectStamp, exports, result);
+}
+
+nlohmann::ordered_json
+ToJson(const ProjectResult& result)
+{
+    nlohmann::ordered_json j{};
+    j["sprite"]       = result.SpritePath;
+    j["status"]       = ToString(result.Status);
+    j["milliseconds"] = result.Milliseconds;
+    if (!result.Error.empty())
+        {
+            j["error"] = result.Error;
+        }
+    j["issues"] = nlohmann::ordered_json::array();
+    for (const auto& issue : result.Issues)
+        {
+            j["issues"].push_back(issue.ToString());
+        }
+    j["outputs"]        = result.Outputs;
+    j["cached_outputs"] = result.NumCachedOutputs;
+    if (result.SavedTextureBytes > 0)
+        {
+            j["saved_texture_bytes"] = result.SavedTextureBytes;
+        }
+    return j;
+}
+}
+
+std::optional<uint32_t>
+ParseExportFormats(std::string_view list)
+{
+    uint32_t exports{};
+    while (!list.empty())
+        {
+            const size_t           comma{ list.find(',') };
+            const std::string_view format{ list.substr(0, comma) };
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+            if (format == "json")
+                {
+                    exports |= EExportFormat::JSON;
+                }
+            else if (format == "binary")
+                {
+                    exports |= EExportFormat::BINARY;
+                }
+            else if (format == "header")
+                {
+                    exports |= EExportFormat::HEADER;
+                }
+            else if (format == "compact")
+                {
+                    exports |= EExportFormat::COMPACT;
+                }
+            else if (format == "bc1")
+                {
+                    exports |= EExportFormat::BC1;
+                }
+            else if (format == "bc3")
+                {
+                    exports |= EExportFormat::BC3;
+                }
+            else if (format == "indexed")
+                {
+                    exports |= EExportFormat::INDEXED;
+                }
+            else
+                {
+                    return {};
+                }
+        }
+    if ((exports & EExportFormat::BC1) && (exports & EExportFormat::BC3))
+        {
+            return {};
+        }
+    return exports;
+}
+
+std::vector<std::filesystem::path>
+FindProjects(const std::vector<std::string>& inputs, size_t& outNumSkipped)
+{
+    std::vector<std::filesystem::path> sprites{};
+    for (const auto& input : inputs)
+        {
+            std::error_code errorCode{};
+            if (std::filesystem::is_directory(input, errorCode))
+                {
+                    for (auto it{ std::filesystem::recursive_directory_iterator{ input, std::filesystem::directory_options::skip_permission_denied, errorCode } };
+                         it != std::filesystem::recursive_directory_iterator{};
+                         it.increment(errorCode))
+                        {
+                            if (it->is_regular_file(errorCode) && IsSpritePath(it->path()))
+                                {
+                                    sprites.push_back(it->path());
+                                }
+                        }
+                }
+            else if (IsSpritePath(input))
+                {
+                    sprites.emplace_back(input);
+                }
+            else if (const auto spritePath{ FindSpriteOfProject(input) }; spritePath.has_value())
+                {
+                    sprites.push_back(spritePath.value());
+                }
+            else
+                {
+                    ++outNumSkipped;
+                }
+        }
+
+    std::sort(sprites.begin(), sprites.end());
+    sprites.erase(std::unique(sprites.begin(), sprites.end()), sprites.end());
+    // Sprites without project file have nothing to validate nor export
+    const auto withoutProject{ std::remove_if(sprites.begin(), sprites.end(), [](const std::filesystem::path& sprite) {
+        return !std::filesystem::is_regular_file(std::filesystem::path{ sprite }.replace_extension(".json"));
+    }) };
+    outNumSkipped += static_cast<size_t>(std::distance(withoutProject, sprites.end()));
+    sprites.erase(withoutProject, sprites.end());
+    return sprites;
+}
+
+std::optional<std::string>
+LoadProject(const std::filesystem::path& spritePath, LoadedProject& outProject)
+{
+    const auto projectPath{ std::filesystem::path{ spritePath }.replace_extension(".json") };
+    outProject.SpritePath = spritePath;
+    {
+        std::ifstream fileStream{ projectPath, std::ios::binary };
+        if (!fileStream)
+            {
+                return "Failed to open " + projectPath.string();
+            }
+        outProject.Content.assign(std::istreambuf_iterator<char>{ fileStream }, std::istreambuf_iterator<char>{});
+    }
+    outProject.Json = nlohmann::ordered_json::parse(outProject.Content, nullptr, false);
+    if (outProject.Json.is_discarded())
+        {
+            return "Failed to parse " + projectPath.string();
+        }
+
+    // Only the sizes are needed, PNG pages are not decoded
+    const auto& j{ outProject.Json };
+    outProject.PageSizes.assign(1, Vec2{});
+    outProject.PagePaths.assign(1, spritePath);
+    ReadImageSize(spritePath.string(), outProject.PageSizes[0].x, outProject.PageSizes[0].y);
+    if (j.contains("pages") && j.at("pages").is_array())
+        {
+            for (const auto& page : j.at("pages"))
+                {
+                    Vec2& pageSize{ outProject.PageSizes.emplace_back() };
+                    auto& pagePath{ outProject.PagePaths.emplace_back() };
+                    if (page.is_string())
+                        {
+                            pagePath = projectPath.parent_path() / page.get<std::string>();
+                            ReadImageSize(pagePath.string(), pageSize.x, pageSize.y);
+                        }
+                }
+        }
+
+    outProject.Issues = ValidateProjectJson(j, outProject.PageSizes);
+    return {};
+}
+
+std::optional<std::string>
+ExportProject(const LoadedProject& project, uint32_t exports, std::vector<std::string>& outOutputs, uint64_t* outSavedTextureBytes)
+{
+    for (const uint32_t format : OUTPUT_FORMATS)
+        {
+            if (!(exports & format))
+                {
+                    continue;
+                }
+            for (const auto& target : GetExportTargets(project, format))
+                {
+                    std::string data{};
+                    uint64_t    savedBytes{};
+                    if (auto buildError{ BuildExport(project, target, data, savedBytes) }; buildError.has_value())
+                        {
+                            return buildError;
+                        }
+                    if (outSavedTextureBytes)
+                        {
+                            *outSavedTextureBytes += savedBytes;
+                        }
+                    if (auto writeError{ WriteFileAtomically(target.Path, data.data(), data.size()) }; writeError.has_value())
+                        {
+                            return writeError;
+                        }
+                    outOutputs.push_back(target.Path.string());
+                }
+        }
+    if (exports & EExportFormat::JSON)
+        {
+            // Same formatting as Project::SaveToFile, an already formatted file is not touched so its timestamp does not trigger rebuilds
+            const auto formatted{ project.Json.dump(4) };
+            const auto projectPath{ std::filesystem::path{ project.SpritePath }.replace_extension(".json") };
+            if (formatted != project.Content)
+                {
+                    if (auto writeError{ WriteFileAtomically(projectPath, formatted.data(), formatted.size()) }; writeError.has_value())
+                        {
+                            return writeError;
+                        }
+                    outOutputs.push_back(projectPath.string());
+                }
+        }
+    return {};
+}
+
+ProjectResult
+ProcessProject(const std::filesystem::path& spritePath, uint32_t exports, ExportCache* cache)
+{
+    const auto    start{ std::chrono::steady_clock::now() };
+    ProjectResult result{};
+    result.SpritePath = spritePath.string();
+    try
+        {
+            if (auto error{ Process(spritePath, exports, cache, result) }; error.has_value())
+                {
+                    result.Status = EStatus::FAILED;
+                    result.Error  = std::move(error.value());
+                }
+        }
+    catch (const std::exception& e)
+        {
+            result.Status = EStatus::FAILED;
+            result.Error  = e.what();
+        }
+    result.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+int
+Run(const Options& options)
+{
+    // Only the problems, a batch over thousands of sheets must stay readable
+    SetTraceLogLevel(LOG_WARNING);
+
+    for (const auto& input : options.Inputs)
+        {
+            if (std::error_code errorCode{}; !std::filesystem::exists(input, errorCode))
+                {
+                    std::cerr << "No such file or directory: " << input << std::endl;
+                    return EExitCode::USAGE;
+                }
+        }
+
+    size_t     numSkipped{};
+    const auto sprites{ FindProjects(options.Inputs, numSkipped) };
+    if (sprites.empty())
+        {
+            std::cerr << "No project found in the inputs" << std::endl;
+            return EExitCode::USAGE;
+        }
+
+    ExportCache cache{};
+    const bool  useCache{ !options.CachePath.empty() };
+    if (useCache)
+        {
+            if (const auto loadError{ cache.Load(options.CachePath) }; loadError.has_value())
+                {
+                    std::cerr << loadError.value() << ", every project is exported" << std::endl;
+                }
+        }
+
+    const auto                 start{ std::chrono::steady_clock::now() };
+    const size_t               numThreads{ options.NumThreads > 0 ? options.NumThreads : std::max(1u, std::thread::hardware_concurrency()) };
+    std::vector<ProjectResult> results(sprites.size());
+    const auto                 processRange = [&](size_t begin, size_t end) {
+        for (size_t i{ begin }; i < end; ++i)
+            {
+                results[i] = ProcessProject(sprites[i], options.Exports, useCache ? &cache : nullptr);
+            }
+    };
+    if (numThreads == 1)
+        {
+            processRange(0, sprites.size());
+        }
+    else
+        {
+            // The calling thread takes part in the loop
+            ThreadPool pool{ numThreads - 1 };
+            pool.ParallelFor(sprites.size(), processRange);
+        }
+    const double seconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+    size_t   numByStatus[3]{};
+    size_t   numWarnings{};
+    size_t   numOutputs{};
+    uint64_t savedTextureBytes{};
+    for (const auto& result : results)
+        {
+            ++numByStatus[static_cast<size_t>(result.Status)];
+            savedTextureBytes += result.SavedTextureBytes;
+            numWarnings += static_cast<size_t>(std::count_if(result.Issues.begin(), result.Issues.end(), [](const ValidationIssue& issue) {
+                return issue.Severity == EValidationSeverity::WARNING;
+            }));
+            numOutputs += result.Outputs.size();
+            if (result.Status == EStatus::OK)
+                {
+                    continue;
+                }
+            std::cout << ToString(result.Status) << ": " << result.SpritePath << std::endl;
+            if (!result.Error.empty())
+                {
+                    std::cout << "    " << result.Error << std::endl;
+                }
+            for (const auto& issue : result.Issues)
+                {
+                    std::cout << "    " << issue.ToString() << std::endl;
+                }
+        }
+
+    const size_t numOk{ numByStatus[static_cast<size_t>(EStatus::OK)] };
+    const size_t numInvalid{ numByStatus[static_cast<size_t>(EStatus::INVALID)] };
+    const size_t numFailed{ numByStatus[static_cast<size_t>(EStatus::FAILED)] };
+    std::cout << "Processed " << results.size() << " projects in " << seconds << " s on " << numThreads << " threads: " << numOk << " ok, " << numInvalid << " invalid, "
+              << numFailed << " failed, " << numSkipped << " skipped without project, " << numWarnings << " warnings, " << numOutputs << " files written" << std::endl;
+
+    if (options.Exports & EExportFormat::INDEXED)
+        {
+            std::cout << "Indexed pages: " << savedTextureBytes / 1024 << " KiB of texture memory saved against RGBA8" << std::endl;
+        }
+
+    int exitCode{ numInvalid + numFailed > 0 ? EExitCode::FAILURES : EExitCode::SUCCESS };
+    if (useCache)
+        {
+            std::cout << "Export cache: " << cache.GetNumHits() << " hits, " << cache.GetNumMisses() << " misses" << std::endl;
+            if (const auto saveError{ cache.Save(options.CachePath) }; saveError.has_value())
+                {
+                    std::cerr << saveError.value() << std::endl;
+                    exitCode = EExitCode::FAILURES;
+                }
+        }
+    if (!options.ReportPath.empty())
+        {
+            nlohmann::ordered_json report{};
+            report["summary"] = { { "projects", results.size() },
+                { "ok", numOk },
+                { "invalid", numInvalid },
+                { "failed", numFailed },
+                { "skipped", numSkipped },
+                { "warnings", numWarnings },
+                { "outputs", numOutputs },
+                { "cache_hits", cache.GetNumHits() },
+                { "cache_misses", cache.GetNumMisses() },
+                { "saved_texture_bytes", savedTextureBytes },
+                { "threads", numThreads },
+                { "seconds", seconds } };
+            report["projects"] = nlohmann::ordered_json::array();
+            for (const auto& result : results)
+                {
+                    report["projects"].push_back(ToJson(result));
+                }
+            const auto reportContent{ report.dump(2) };
+            if (const auto writeError{ WriteFileAtomically(options.ReportPath, reportContent.data(), reportContent.size()) }; writeError.has_value())
+                {
+                    std::cerr << writeError.value() << std::endl;
+                    exitCode = EExitCode::FAILURES;
+                }
+        }
+    return exitCode;
+}
+
+}
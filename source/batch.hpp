@@ -0,0 +1,179 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "validation.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ExportCache;
+
+// Headless batch processing of sprite sheet projects, no window nor GL context is created.
+namespace batch
+{
+
+enum EExportFormat : uint32_t
+{
+    /**
+     * \brief The project file rewritten with the editor formatting, only written when it changes.
+     */
+    JSON    = 1 << 0,
+    BINARY  = 1 << 1,
+    HEADER  = 1 << 2,
+    /**
+     * \brief The project file without whitespace, <sprite>.min.json.
+     */
+    COMPACT = 1 << 3,
+    /**
+     * \brief Every page block compressed next to its image, <page>.dds.
+     */
+    BC1     = 1 << 4,
+    BC3     = 1 << 5,
+    /**
+     * \brief Every page as an 8 bit palette PNG next to its image, <page>.indexed.png.
+     */
+    INDEXED = 1 << 6,
+};
+
+/**
+ * \brief Suitable for CI: any invalid or failed project fails the run.
+ */
+enum EExitCode : int
+{
+    SUCCESS  = 0,
+    FAILURES = 1,
+    USAGE    = 2,
+};
+
+enum class EStatus : uint8_t
+{
+    OK,
+    /**
+     * \brief Validation errors, nothing is exported.
+     */
+    INVALID,
+    FAILED,
+};
+
+struct Options
+{
+    /**
+     * \brief Sprites, project files or directories searched recursively.
+     */
+    std::vector<std::string> Inputs{};
+    uint32_t                 Exports{};
+    /**
+     * \brief Zero means one per hardware thread.
+     */
+    size_t                   NumThreads{};
+    /**
+     * \brief Optional JSON report of every project.
+     */
+    std::string              ReportPath{};
+    /**
+     * \brief Optional export cache manifest, the projects and outputs unchanged since the last run are skipped.
+     */
+    std::string              CachePath{};
+};
+
+struct ProjectResult
+{
+    std::string                  SpritePath{};
+    EStatus                      Status{ EStatus::OK };
+    std::vector<ValidationIssue> Issues{};
+    /**
+     * \brief The files written, the outputs found up to date in the export cache are only counted.
+     */
+    std::vector<std::string>     Outputs{};
+    size_t                       NumCachedOutputs{};
+    /**
+     * \brief The texture memory saved by the indexed pages against RGBA8, the cached ones included.
+     */
+    uint64_t                     SavedTextureBytes{};
+    std::string                  Error{};
+    double                       Milliseconds{};
+};
+
+/**
+ * \brief A project read from disk and validated, what the exports are built from.
+ */
+struct LoadedProject
+{
+    std::filesystem::path              SpritePath{};
+    /**
+     * \brief The project file as read, the json export only rewrites it when the formatting differs.
+     */
+    std::string                        Content{};
+    nlohmann::ordered_json             Json{};
+    /**
+     * \brief Page 0 is the sprite, an unreadable page keeps a zero size and is reported by the validation.
+     */
+    std::vector<Vec2>                  PageSizes{};
+    std::vector<std::filesystem::path> PagePaths{};
+    std::vector<ValidationIssue>       Issues{};
+};
+
+/**
+ * \brief Parses a comma separated list of json, binary, header, compact, bc1, bc3 and indexed.
+ * \return Empty if a format is unknown or if bc1 and bc3 are both requested, they share the output path.
+ */
+std::optional<uint32_t> ParseExportFormats(std::string_view list);
+
+/**
+ * \brief The sprites having a project file found in the inputs, sorted and unique. The sprites without project are counted in outNumSkipped.
+ */
+std::vector<std::filesystem::path> FindProjects(const std::vector<std::string>& inputs, size_t& outNumSkipped);
+
+/**
+ * \brief Reads, parses and validates the project of the sprite, thread safe.
+ * \return The error string if the project can not be read or parsed, validation issues are not errors.
+ */
+std::optional<std::string> LoadProject(const std::filesystem::path& spritePath, LoadedProject& outProject);
+
+/**
+ * \brief Writes the requested exports of a project without validation errors, the written paths are appended to outOutputs.
+ * \param outSavedTextureBytes Optional, incremented by the texture memory saved by the indexed pages.
+ * \return The error string if a write failed, the following exports are not written.
+ */
+std::optional<std::string> ExportProject(const LoadedProject& project, uint32_t exports, std::vector<std::string>& outOutputs, uint64_t* outSavedTextureBytes = nullptr);
+
+/**
+ * \brief Validates then exports a single project, thread safe.
+ * With a cache, the outputs whose inputs did not change are not regenerated and an untouched project is not even read.
+ */
+ProjectResult ProcessProject(const std::filesystem::path& spritePath, uint32_t exports, ExportCache* cache = nullptr);
+
+/**
+ * \brief Processes every project found in the inputs on a worker pool, prints a summary and writes the report.
+ * \return The process exit code.
+ */
+int Run(const Options& options);
+
+}
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "content_hash.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+namespace
+{
+constexpr uint64_t PRIME_1{ 0x9E3779B185EBCA87ull };
+constexpr uint64_t PRIME_2{ 0xC2B2AE3D27D4EB4Full };
+
+constexpr uint64_t
+RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+constexpr uint64_t
+Mix(uint64_t state, uint64_t word)
+{
+    return RotateLeft(state ^ (word * PRIME_2), 31) * PRIME_1;
+}
+}
+
+void
+ContentHasher::Update(const void* data, size_t size)
+{
+    const auto* bytes{ static_cast<const uint8_t*>(data) };
+    _length += size;
+    for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t))
+        {
+            uint64_t word{};
+            std::memcpy(&word, bytes, sizeof(word));
+            _state = Mix(_state, word);
+        }
+    if (size > 0)
+        {
+            uint64_t tail{};
+            std::memcpy(&tail, bytes, size);
+            // The tail length is mixed in so "a" and "a\0" differ
+            _state = Mix(_state, tail ^ (static_cast<uint64_t>(size) << 56));
+        }
+}
+
+uint64_t
+ContentHasher::Digest() const
+{
+    // Final avalanche, every input bit affects every output bit
+    uint64_t hash{ _state ^ _length };
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint64_t
+HashBytes(const void* data, size_t size)
+{
+    ContentHasher hasher{};
+    hasher.Update(data, size);
+    return hasher.Digest();
+}
+
+FileStamp
+GetFileStamp(const std::filesystem::path& path)
+{
+    std::error_code errorCode{};
+    FileStamp       stamp{};
+    stamp.Time = std::filesystem::last_write_time(path, errorCode);
+    stamp.Size = std::filesystem::file_size(path, errorCode);
+    return stamp;
+}
+
+std::optional<uint64_t>
+HashFile(const std::filesystem::path& path)
+{
+    std::ifstream fileStream{ path, std::ios::binary };
+    if (!fileStream)
+        {
+            return {};
+        }
+
+    // A multiple of 8 bytes, the digest is the same as hashing the whole file at once
+    constexpr size_t        CHUNK_SIZE{ 64 * 1024 };
+    std::unique_ptr<char[]> chunk{ new char[CHUNK_SIZE] };
+    ContentHasher           hasher{};
+    while (fileStream)
+        {
+            fileStream.read(chunk.get(), CHUNK_SIZE);
+            if (const auto numRead{ fileStream.gcount() }; numRead > 0)
+                {
+                    hasher.Update(chunk.get(), static_cast<size_t>(numRead));
+                }
+        }
+    if (fileStream.bad())
+        {
+            return {};
+        }
+    return hasher.Digest();
+}
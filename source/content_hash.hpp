@@ -0,0 +1,82 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * \brief 64 bit hash of file contents used to detect changed inputs, not cryptographic.
+ * Consumes 8 bytes per step, the digest is stable across runs on little endian platforms but depends on how the data is split across Update calls.
+ */
+class ContentHasher final
+{
+  public:
+    void Update(const void* data, size_t size);
+    void Update(std::string_view text) { Update(text.data(), text.size()); }
+
+    template<typename T>
+    void UpdateValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Update(&value, sizeof(T));
+    }
+
+    uint64_t Digest() const;
+
+  private:
+    uint64_t _state{ 0x9E3779B97F4A7C15ull };
+    uint64_t _length{};
+};
+
+/**
+ * \brief Same digest as HashFile on a file holding these bytes.
+ */
+uint64_t HashBytes(const void* data, size_t size);
+
+/**
+ * \brief Cheap change detection done before hashing: a file keeping its time and size is assumed unchanged, as make does.
+ * A missing file gets an invalid stamp, thus a file appearing or disappearing is detected too.
+ */
+struct FileStamp
+{
+    std::filesystem::file_time_type Time{};
+    uintmax_t                       Size{};
+
+    bool operator==(const FileStamp& other) const { return Time == other.Time && Size == other.Size; }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+FileStamp GetFileStamp(const std::filesystem::path& path);
+
+/**
+ * \brief Hashes the whole file in fixed size chunks.
+ * \return Empty if the file can not be read.
+ */
+std::optional<uint64_t> HashFile(const std::filesystem::path& path);
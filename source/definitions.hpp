@@ -41,6 +41,7 @@ enum class EModalType
     CREATE_ANIMATION,
     CONFIRM_DELETE,
     CONFIRM_DISCARD_CHANGES,
+    EXPORT,
     OPEN_FILE_DIALOG, // Used to trigger file dialog from main loop when previous modal chooses to.
 };
 
@@ -54,6 +55,19 @@ enum EControlIndex : int32_t
     CENTER = TOP | BOTTOM | LEFT | RIGHT,
 };
 
+/**
+ * \brief The single clock driving every animation preview, frames are computed from the elapsed time so drawing never mutates the animations.
+ */
+struct AnimationClock
+{
+    int64_t NowMs{};
+    int64_t EpochMs{};
+
+    inline void    Tick(double timeSeconds) { NowMs = static_cast<int64_t>(timeSeconds * 1000.0); }
+    inline void    Restart() { EpochMs = NowMs; }
+    inline int64_t GetElapsedMs() const { return NowMs - EpochMs; }
+};
+
 struct View
 {
     constexpr static uint32_t ZOOM_FRACTBITS{ 8 };
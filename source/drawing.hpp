@@ -25,10 +25,19 @@ SOFTWARE.
 #pragma once
 
 #include "raylib.h"
+#include "rlgl.h"
 
 #include "definitions.hpp"
+#include "image_cache.hpp"
+#include "input.hpp"
+#include "memory_stats.hpp"
+#include "profiler.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
 
 void
 DrawDashedLine(Vector2 start, Vector2 end, float dashLength, float gapLength, float thickness, Color color)
@@ -73,13 +82,59 @@ DrawUVRectDashed(Rectangle rect, View view)
     DrawDashedLine({ rect.x + rect.width, rect.y }, { rect.x + rect.width, rect.y + rect.height }, dashLen, dashGap, thickness, dashColor);
 }
 
+Rectangle
+FitRectKeepAspect(Rectangle bounds, int32_t width, int32_t height)
+{
+    Rectangle fitted{ bounds };
+    // Make the rect fit inside bounds maintaining aspect ratio
+    if (width > height)
+        {
+            fitted.height = bounds.width * (height / static_cast<float>(std::max(width, 1)));
+        }
+    else
+        {
+            fitted.width = bounds.height * (width / static_cast<float>(std::max(height, 1)));
+        }
+    // Center it
+    fitted.x += (bounds.width - fitted.width) * .5f;
+    fitted.y += (bounds.height - fitted.height) * .5f;
+    return fitted;
+}
+
+/**
+ * \brief Pushes a textured quad into the active RL_QUADS batch.
+ * The caller owns rlSetTexture/rlBegin/rlEnd so that many quads sharing the same texture end up in one draw call.
+ */
+void
+PushTexturedQuad(Rectangle dest, Rect src, Vector2 textureSize)
+{
+    const float u0{ src.x / textureSize.x };
+    const float v0{ src.y / textureSize.y };
+    const float u1{ (src.x + src.w) / textureSize.x };
+    const float v1{ (src.y + src.h) / textureSize.y };
+
+    rlColor4ub(255, 255, 255, 255);
+
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(dest.x, dest.y);
+
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(dest.x, dest.y + dest.height);
+
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(dest.x + dest.width, dest.y);
+}
+
 bool
 DrawControl(Vector2 origin, float controlExtent, Color baseColor)
 {
     constexpr Color focusedColor{ BLUE };
     const Rectangle cRect{ origin.x - controlExtent, origin.y - controlExtent, controlExtent * 2.f, controlExtent * 2.f };
 
-    const bool mouseHover = CheckCollisionPointRec(GetMousePosition(), cRect);
+    const bool mouseHover = CheckCollisionPointRec(input::GetMousePosition(), cRect);
 
     DrawRectangleRec(cRect, mouseHover ? focusedColor : baseColor);
 
@@ -135,3 +190,186 @@ DrawUvRectControlsGetControlIndex(Rectangle rect, View view, float controlExtent
 
     return index;
 }
+
+#if defined(SPRITE_UV_PROFILER)
+/**
+ * \brief Frame time graph, the render counts and the slowest scopes of the last frame.
+ */
+void
+DrawProfilerOverlay(Vector2 origin)
+{
+    constexpr float   WIDTH{ 360.f };
+    constexpr float   GRAPH_HEIGHT{ 80.f };
+    constexpr float   GRAPH_MAX_MS{ 50.f };
+    constexpr float   LINE_HEIGHT{ 18.f };
+    constexpr int32_t FONT_SIZE{ 16 };
+    constexpr size_t  MAX_SCOPES{ 10 };
+    constexpr float   MARGIN{ 8.f };
+
+    const auto samples{ profiler::GetFrameSamples() };
+
+    // Sum the scopes of the last frame by name, the names are literals thus compared by content
+    std::vector<std::pair<const char*, int64_t>> scopes{};
+    for (const auto& event : profiler::GetLastFrameEvents())
+        {
+            if (std::strcmp(event.Name, "Frame") == 0)
+                {
+                    continue;
+                }
+            const auto found{ std::find_if(scopes.begin(), scopes.end(), [&](const auto& scope) { return std::strcmp(scope.first, event.Name) == 0; }) };
+            if (found != scopes.end())
+                {
+                    found->second += event.DurationUs;
+                }
+            else
+                {
+                    scopes.emplace_back(event.Name, event.DurationUs);
+                }
+        }
+    std::sort(scopes.begin(), scopes.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    scopes.resize(std::min(scopes.size(), MAX_SCOPES));
+
+    const float height{ MARGIN * 3 + GRAPH_HEIGHT + LINE_HEIGHT * (2 + scopes.size()) };
+    DrawRectangleRec({ origin.x, origin.y, WIDTH + MARGIN * 2, height }, Fade(BLACK, .8f));
+
+    // Frame time graph, the lines mark 60 and 30 fps
+    const Rectangle graph{ origin.x + MARGIN, origin.y + MARGIN, WIDTH, GRAPH_HEIGHT };
+    const float     barWidth{ WIDTH / static_cast<float>(profiler::FRAME_CAPACITY) };
+    for (size_t i{}; i < samples.size(); ++i)
+        {
+            const float ms{ samples[i].DurationUs / 1000.f };
+            const float barHeight{ std::min(ms / GRAPH_MAX_MS, 1.f) * GRAPH_HEIGHT };
+            const Color color{ ms < 1000.f / 60.f ? GREEN : ms < 1000.f / 30.f ? ORANGE : RED };
+            DrawRectangleRec({ graph.x + i * barWidth, graph.y + graph.height - barHeight, std::max(barWidth, 1.f), barHeight }, color);
+        }
+    for (const float targetMs : { 1000.f / 60.f, 1000.f / 30.f })
+        {
+            const float y{ graph.y + graph.height - targetMs / GRAPH_MAX_MS * GRAPH_HEIGHT };
+            DrawLineEx({ graph.x, y }, { graph.x + graph.width, y }, 1.f, Fade(WHITE, .5f));
+        }
+
+    float y{ graph.y + graph.height + MARGIN };
+    if (!samples.empty())
+        {
+            int64_t sumUs{};
+            int64_t maxUs{};
+            for (const auto& sample : samples)
+                {
+                    sumUs += sample.DurationUs;
+                    maxUs = std::max(maxUs, sample.DurationUs);
+                }
+            const auto& last{ samples.back() };
+            DrawText(TextFormat("Frame %.2f ms  avg %.2f  max %.2f", last.DurationUs / 1000.f, sumUs / 1000.f / samples.size(), maxUs / 1000.f), graph.x, y, FONT_SIZE, WHITE);
+            y += LINE_HEIGHT;
+            DrawText(TextFormat("Draw calls %d  Vertices %d  Text layouts %d", last.Render.DrawCalls, last.Render.Vertices, last.Render.TextMeasurements), graph.x, y, FONT_SIZE,
+                     WHITE);
+            y += LINE_HEIGHT;
+        }
+    for (const auto& [name, durationUs] : scopes)
+        {
+            DrawText(name, graph.x, y, FONT_SIZE, LIGHTGRAY);
+            const char* duration{ TextFormat("%.3f ms", durationUs / 1000.f) };
+            DrawText(duration, graph.x + graph.width - MeasureText(duration, FONT_SIZE), y, FONT_SIZE, LIGHTGRAY);
+            y += LINE_HEIGHT;
+        }
+}
+#endif
+
+const char*
+FormatBytes(int64_t bytes)
+{
+    if (bytes >= 1024 * 1024)
+        {
+            return TextFormat("%.2f MB", bytes / (1024.f * 1024.f));
+        }
+    if (bytes >= 1024)
+        {
+            return TextFormat("%.1f KB", bytes / 1024.f);
+        }
+    return TextFormat("%d B", static_cast<int32_t>(bytes));
+}
+
+constexpr float MEMORY_PANEL_WIDTH{ 460.f };
+
+/**
+ * \brief Subsystem totals followed by the biggest entries of the report and the decoded image cache hits.
+ * \param logPath Shown when the reports are being logged, may be null.
+ */
+void
+DrawMemoryPanel(Vector2 origin, const MemoryReport& report, const ImageCache::Stats& imageCacheStats, const char* logPath)
+{
+    constexpr float   LINE_HEIGHT{ 18.f };
+    constexpr int32_t FONT_SIZE{ 16 };
+    constexpr size_t  MAX_ENTRIES{ 16 };
+    constexpr float   MARGIN{ 8.f };
+
+    // The subsystem is the first part of the category
+    std::vector<std::pair<std::string, int64_t>> subsystems{};
+    for (const auto& entry : report.GetEntries())
+        {
+            std::string subsystem{ entry.Category.substr(0, entry.Category.find('/')) };
+            const auto  found{ std::find_if(subsystems.begin(), subsystems.end(), [&](const auto& total) { return total.first == subsystem; }) };
+            if (found != subsystems.end())
+                {
+                    found->second += entry.Bytes;
+                }
+            else
+                {
+                    subsystems.emplace_back(std::move(subsystem), entry.Bytes);
+                }
+        }
+
+    std::vector<const MemoryEntry*> entries{};
+    for (const auto& entry : report.GetEntries())
+        {
+            entries.push_back(&entry);
+        }
+    std::sort(entries.begin(), entries.end(), [](const MemoryEntry* a, const MemoryEntry* b) { return a->Bytes > b->Bytes; });
+    entries.resize(std::min(entries.size(), MAX_ENTRIES));
+
+    const float width{ MEMORY_PANEL_WIDTH - MARGIN * 2 };
+    const float height{ MARGIN * 3 + LINE_HEIGHT * (3 + subsystems.size() + entries.size()) };
+    DrawRectangleRec({ origin.x, origin.y, MEMORY_PANEL_WIDTH, height }, Fade(BLACK, .8f));
+
+    const auto drawRow = [&](float y, const char* left, const char* right, Color color) {
+        DrawText(left, origin.x + MARGIN, y, FONT_SIZE, color);
+        DrawText(right, origin.x + MARGIN + width - MeasureText(right, FONT_SIZE), y, FONT_SIZE, color);
+    };
+
+    float y{ origin.y + MARGIN };
+    drawRow(y, "Memory", FormatBytes(report.GetTotalBytes()), WHITE);
+    y += LINE_HEIGHT;
+    for (const auto& [subsystem, bytes] : subsystems)
+        {
+            drawRow(y, subsystem.c_str(), FormatBytes(bytes), WHITE);
+            y += LINE_HEIGHT;
+        }
+
+    y += MARGIN;
+    for (const MemoryEntry* entry : entries)
+        {
+            std::string label{ entry->Category };
+            if (entry->Count != 1)
+                {
+                    label += " x" + std::to_string(entry->Count);
+                }
+            if (!entry->Detail.empty())
+                {
+                    label += " " + entry->Detail;
+                }
+            // Long paths are cut from the front, the file name is the useful part
+            constexpr size_t MAX_LABEL_LENGTH{ 44 };
+            if (label.size() > MAX_LABEL_LENGTH)
+                {
+                    label = entry->Category + " ..." + label.substr(label.size() - (MAX_LABEL_LENGTH - entry->Category.size() - 4));
+                }
+            drawRow(y, label.c_str(), FormatBytes(entry->Bytes), LIGHTGRAY);
+            y += LINE_HEIGHT;
+        }
+
+    // Time spent mapping the cached images against decoding the missed ones
+    drawRow(y, TextFormat("Image cache %zu hits %.1f ms, %zu misses", imageCacheStats.NumHits, imageCacheStats.HitMilliseconds, imageCacheStats.NumMisses),
+            TextFormat("%.1f ms decoding", imageCacheStats.MissMilliseconds), GRAY);
+    y += LINE_HEIGHT;
+    DrawText(logPath ? TextFormat("F6 stop logging to %s", logPath) : "F6 log to file every minute", origin.x + MARGIN, y, FONT_SIZE, GRAY);
+}
@@ -0,0 +1,374 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "export.hpp"
+
+#include "project.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+#pragma region PNG
+
+// Big endian, as every PNG integer
+void
+AppendU32(std::vector<uint8_t>& buffer, uint32_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t
+ComputeCrc32(const uint8_t* data, size_t size)
+{
+    static const auto table{ [] {
+        std::array<uint32_t, 256> crcs{};
+        for (uint32_t i{}; i < 256; ++i)
+            {
+                uint32_t crc{ i };
+                for (int32_t bit{}; bit < 8; ++bit)
+                    {
+                        crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                    }
+                crcs[i] = crc;
+            }
+        return crcs;
+    }() };
+
+    uint32_t crc{ 0xFFFFFFFFu };
+    for (size_t i{}; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void
+AppendChunk(std::vector<uint8_t>& file, const char type[4], const std::vector<uint8_t>& data)
+{
+    AppendU32(file, static_cast<uint32_t>(data.size()));
+    const size_t typeOffset{ file.size() };
+    file.insert(file.end(), type, type + 4);
+    file.insert(file.end(), data.begin(), data.end());
+    AppendU32(file, ComputeCrc32(file.data() + typeOffset, file.size() - typeOffset));
+}
+
+/**
+ * \brief A zlib stream around the raylib deflate compressor.
+ */
+std::optional<std::vector<uint8_t>>
+Deflate(const std::vector<uint8_t>& data)
+{
+    int32_t  compressedSize{};
+    uint8_t* compressed{ CompressData(data.data(), static_cast<int32_t>(data.size()), &compressedSize) };
+    if (!compressed)
+        {
+            return {};
+        }
+
+    // Deflate with a 32K window, no dictionary, the header being a multiple of 31
+    std::vector<uint8_t> stream{ 0x78, 0x01 };
+    stream.insert(stream.end(), compressed, compressed + compressedSize);
+    MemFree(compressed);
+
+    uint32_t a{ 1 };
+    uint32_t b{};
+    for (const uint8_t byte : data)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+    AppendU32(stream, (b << 16) | a);
+    return stream;
+}
+
+/**
+ * \brief An 8 bit palette PNG, with a tRNS chunk if any palette entry is not opaque.
+ */
+std::optional<std::vector<uint8_t>>
+BuildIndexedPngFile(const IndexedImage& image)
+{
+    std::vector<uint8_t> header{};
+    AppendU32(header, static_cast<uint32_t>(image.Width));
+    AppendU32(header, static_cast<uint32_t>(image.Height));
+    // 8 bits per index, indexed color, deflate, adaptive filtering, no interlacing
+    header.insert(header.end(), { 8, 3, 0, 0, 0 });
+
+    std::vector<uint8_t> palette{};
+    std::vector<uint8_t> alphas{};
+    for (const uint32_t color : image.Palette)
+        {
+            uint8_t bytes[4]{};
+            std::memcpy(bytes, &color, sizeof(bytes));
+            palette.insert(palette.end(), bytes, bytes + 3);
+            alphas.push_back(bytes[3]);
+        }
+    // Missing trailing alphas are opaque
+    while (!alphas.empty() && alphas.back() == 255)
+        {
+            alphas.pop_back();
+        }
+
+    // Every row starts with its filter, none: the indices of pixel art compress well as is
+    std::vector<uint8_t> rows{};
+    rows.reserve((static_cast<size_t>(image.Width) + 1) * image.Height);
+    for (int32_t y{}; y < image.Height; ++y)
+        {
+            const auto row{ image.Indices.begin() + static_cast<ptrdiff_t>(y) * image.Width };
+            rows.push_back(0);
+            rows.insert(rows.end(), row, row + image.Width);
+        }
+    const auto compressedRows{ Deflate(rows) };
+    if (!compressedRows.has_value())
+        {
+            return {};
+        }
+
+    std::vector<uint8_t> file{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    AppendChunk(file, "IHDR", header);
+    AppendChunk(file, "PLTE", palette);
+    if (!alphas.empty())
+        {
+            AppendChunk(file, "tRNS", alphas);
+        }
+    AppendChunk(file, "IDAT", compressedRows.value());
+    AppendChunk(file, "IEND", {});
+    return file;
+}
+
+#pragma endregion
+}
+
+std::optional<std::string>
+WriteFileAtomically(const std::filesystem::path& path, const void* data, size_t size)
+{
+    // Readers see either the previous file or the complete new one, never a partial write.
+    // Unique per call, concurrent writers of one path never share their temporary file
+    static std::atomic<uint64_t> numTemporaries{};
+#if defined(_WIN32)
+    const auto processId{ _getpid() };
+#else
+    const auto processId{ getpid() };
+#endif
+    std::filesystem::path temporaryPath{ path };
+    temporaryPath += ".tmp" + std::to_string(processId) + "." + std::to_string(numTemporaries++);
+    {
+        std::ofstream fileStream{ temporaryPath, std::ios::binary | std::ios::trunc };
+        if (!fileStream)
+            {
+                return "Failed to open " + temporaryPath.string() + " for writing!";
+            }
+        fileStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!fileStream)
+            {
+                fileStream.close();
+                std::error_code removeError{};
+                std::filesystem::remove(temporaryPath, removeError);
+                return "Failed to write " + path.string() + "!";
+            }
+    }
+    std::error_code renameError{};
+    std::filesystem::rename(temporaryPath, path, renameError);
+    if (renameError)
+        {
+            std::error_code removeError{};
+            std::filesystem::remove(temporaryPath, removeError);
+            return "Failed to replace " + path.string() + ": " + renameError.message();
+        }
+    return {};
+}
+
+std::filesystem::path
+GetBinaryExportPath(const std::filesystem::path& spritePath)
+{
+    return std::filesystem::path{ spritePath }.replace_extension(".uvb");
+}
+
+std::filesystem::path
+GetCppHeaderExportPath(const std::filesystem::path& spritePath)
+{
+    return spritePath.parent_path() / (spritePath.stem().string() + "_animations.hpp");
+}
+
+std::filesystem::path
+GetDdsExportPath(const std::filesystem::path& imagePath)
+{
+    return std::filesystem::path{ imagePath }.replace_extension(".dds");
+}
+
+std::filesystem::path
+GetIndexedExportPath(const std::filesystem::path& imagePath)
+{
+    return std::filesystem::path{ imagePath }.replace_extension(".indexed.png");
+}
+
+std::optional<std::string>
+ExportBinary(const Project& project)
+{
+    if (project.SpritePath.empty() || !project.SpriteTexture.has_value())
+        {
+            return "No sprite loaded!";
+        }
+
+    const auto buffer{ BuildBinaryExport(project.SerializeAnimationData(), project.GetPageSizes()) };
+    if (buffer.empty())
+        {
+            return "An animation lasts longer than the binary export can hold!";
+        }
+    return WriteFileAtomically(GetBinaryExportPath(project.SpritePath), buffer.data(), buffer.size());
+}
+
+std::optional<std::string>
+ExportCppHeader(const Project& project)
+{
+    if (project.SpritePath.empty() || !project.SpriteTexture.has_value())
+        {
+            return "No sprite loaded!";
+        }
+
+    const auto header{ BuildCppHeaderExport(project.SerializeAnimationData(), project.GetPageSizes(), GetCppHeaderNamespace(project.SpritePath)) };
+    return WriteFileAtomically(GetCppHeaderExportPath(project.SpritePath), header.data(), header.size());
+}
+
+std::optional<std::string>
+BuildDdsExport(const std::filesystem::path& imagePath, EBlockFormat format, std::vector<uint8_t>& outFile)
+{
+    Image image = LoadImage(imagePath.string().c_str());
+    if (!image.data)
+        {
+            return "Failed to load " + imagePath.string();
+        }
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    outFile = BuildDdsFile(static_cast<const uint8_t*>(image.data), image.width, image.height, format);
+    UnloadImage(image);
+    return {};
+}
+
+std::optional<std::string>
+ExportDds(const Project& project, EBlockFormat format)
+{
+    if (project.SpritePath.empty() || !project.SpriteImage.has_value())
+        {
+            return "No sprite loaded!";
+        }
+
+    // The sprite is already decoded as RGBA8
+    const Image& sprite{ project.SpriteImage.value() };
+    const auto   spriteFile{ BuildDdsFile(static_cast<const uint8_t*>(sprite.data), sprite.width, sprite.height, format) };
+    if (auto writeError{ WriteFileAtomically(GetDdsExportPath(project.SpritePath), spriteFile.data(), spriteFile.size()) }; writeError.has_value())
+        {
+            return writeError;
+        }
+
+    const auto projectDir{ std::filesystem::path{ project.GetProjectFilePath() }.parent_path() };
+    for (const auto& pagePath : project.PagePaths)
+        {
+            std::vector<uint8_t> pageFile{};
+            if (auto buildError{ BuildDdsExport(projectDir / pagePath, format, pageFile) }; buildError.has_value())
+                {
+                    return buildError;
+                }
+            if (auto writeError{ WriteFileAtomically(GetDdsExportPath(projectDir / pagePath), pageFile.data(), pageFile.size()) }; writeError.has_value())
+                {
+                    return writeError;
+                }
+        }
+    return {};
+}
+
+std::optional<std::string>
+BuildIndexedExport(const std::filesystem::path& imagePath, std::vector<uint8_t>& outFile, uint64_t& outSavedBytes)
+{
+    Image image = LoadImage(imagePath.string().c_str());
+    if (!image.data)
+        {
+            return "Failed to load " + imagePath.string();
+        }
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    const IndexedImage indexed{ QuantizeImage(static_cast<const uint8_t*>(image.data), image.width, image.height) };
+    UnloadImage(image);
+
+    auto file{ BuildIndexedPngFile(indexed) };
+    if (!file.has_value())
+        {
+            return "Failed to compress " + imagePath.string();
+        }
+    outFile       = std::move(file.value());
+    outSavedBytes = GetSavedBytes(indexed);
+    return {};
+}
+
+std::optional<std::string>
+ExportIndexed(const Project& project, uint64_t& outSavedBytes)
+{
+    if (project.SpritePath.empty() || !project.SpriteImage.has_value())
+        {
+            return "No sprite loaded!";
+        }
+
+    // The sprite is already decoded as RGBA8
+    const Image&       sprite{ project.SpriteImage.value() };
+    const IndexedImage indexed{ QuantizeImage(static_cast<const uint8_t*>(sprite.data), sprite.width, sprite.height) };
+    const auto         spriteFile{ BuildIndexedPngFile(indexed) };
+    if (!spriteFile.has_value())
+        {
+            return "Failed to compress " + project.SpritePath;
+        }
+    if (auto writeError{ WriteFileAtomically(GetIndexedExportPath(project.SpritePath), spriteFile->data(), spriteFile->size()) }; writeError.has_value())
+        {
+            return writeError;
+        }
+    outSavedBytes = GetSavedBytes(indexed);
+
+    const auto projectDir{ std::filesystem::path{ project.GetProjectFilePath() }.parent_path() };
+    for (const auto& pagePath : project.PagePaths)
+        {
+            std::vector<uint8_t> pageFile{};
+            uint64_t             pageSavedBytes{};
+            if (auto buildError{ BuildIndexedExport(projectDir / pagePath, pageFile, pageSavedBytes) }; buildError.has_value())
+                {
+                    return buildError;
+                }
+            if (auto writeError{ WriteFileAtomically(GetIndexedExportPath(projectDir / pagePath), pageFile.data(), pageFile.size()) }; writeError.has_value())
+                {
+                    return writeError;
+                }
+            outSavedBytes += pageSavedBytes;
+        }
+    return {};
+}
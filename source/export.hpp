@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "export_format.hpp"
+#include "geometry.hpp"
+#include "palette_quantization.hpp"
+#include "texture_compression.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+class Project;
+
+/**
+ * \brief Writes a temporary file next to the destination then renames it over the destination.
+ * \return The error string if failed, the destination is left untouched.
+ */
+std::optional<std::string> WriteFileAtomically(const std::filesystem::path& path, const void* data, size_t size);
+
+// Where the exports of a sprite are written, shared by the editor and the batch mode
+std::filesystem::path GetBinaryExportPath(const std::filesystem::path& spritePath);
+std::filesystem::path GetCppHeaderExportPath(const std::filesystem::path& spritePath);
+// Every page is compressed next to its image
+std::filesystem::path GetDdsExportPath(const std::filesystem::path& imagePath);
+std::filesystem::path GetIndexedExportPath(const std::filesystem::path& imagePath);
+
+/**
+ * \brief Writes the binary runtime export next to the sprite with the .uvb extension.
+ * \return The error string if failed.
+ */
+std::optional<std::string> ExportBinary(const Project& project);
+
+/**
+ * \brief Writes the constexpr C++ header next to the sprite as <name>_animations.hpp.
+ * \return The error string if failed.
+ */
+std::optional<std::string> ExportCppHeader(const Project& project);
+
+/**
+ * \brief Decodes the image then block compresses it into a DDS file.
+ * \return The error string if the image can not be loaded.
+ */
+std::optional<std::string> BuildDdsExport(const std::filesystem::path& imagePath, EBlockFormat format, std::vector<uint8_t>& outFile);
+
+/**
+ * \brief Writes every page of the project as a block compressed DDS next to its image, the sprite is taken from memory.
+ * \return The error string if failed.
+ */
+std::optional<std::string> ExportDds(const Project& project, EBlockFormat format);
+
+/**
+ * \brief Decodes the image then writes it as an 8 bit palette PNG, quantized if it holds more than 256 colors.
+ * \param outSavedBytes The texture memory saved against RGBA8.
+ * \return The error string if the image can not be loaded.
+ */
+std::optional<std::string> BuildIndexedExport(const std::filesystem::path& imagePath, std::vector<uint8_t>& outFile, uint64_t& outSavedBytes);
+
+/**
+ * \brief Writes every page of the project as an indexed PNG next to its image, the sprite is taken from memory.
+ * \param outSavedBytes The texture memory saved against RGBA8 by all the pages.
+ * \return The error string if failed.
+ */
+std::optional<std::string> ExportIndexed(const Project& project, uint64_t& outSavedBytes);
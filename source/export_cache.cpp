@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "export_cache.hpp"
+
+#include "export.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+nlohmann::ordered_json
+ToJson(const FileStamp& stamp)
+{
+    return { stamp.Time.time_since_epoch().count(), stamp.Size };
+}
+
+FileStamp
+StampFromJson(const nlohmann::ordered_json& j)
+{
+    FileStamp stamp{};
+    stamp.Time = std::filesystem::file_time_type{ std::filesystem::file_time_type::duration{ j.at(0).get<std::filesystem::file_time_type::rep>() } };
+    stamp.Size = j.at(1).get<uintmax_t>();
+    return stamp;
+}
+}
+
+std::optional<std::string>
+ExportCache::Load(const std::filesystem::path& manifestPath)
+{
+    std::ifstream fileStream{ manifestPath, std::ios::binary };
+    if (!fileStream)
+        {
+            return {};
+        }
+    const std::string content{ std::istreambuf_iterator<char>{ fileStream }, std::istreambuf_iterator<char>{} };
+    const auto j = nlohmann::ordered_json::parse(content, nullptr, false);
+    if (j.is_discarded() || !j.is_object())
+        {
+            return "Failed to parse the export cache " + manifestPath.string();
+        }
+    if (j.value("version", 0u) != VERSION)
+        {
+            return {};
+        }
+
+    std::map<std::string, Entry> entries{};
+    try
+        {
+            for (const auto& [spritePath, entryJson] : j.at("projects").items())
+                {
+                    Entry& entry{ entries[spritePath] };
+                    entry.Formats = entryJson.at("formats").get<uint32_t>();
+                    for (const auto& inputJson : entryJson.at("inputs"))
+                        {
+                            entry.Inputs.push_back({ inputJson.at("path").get<std::string>(), StampFromJson(inputJson.at("stamp")), inputJson.at("hash").get<uint64_t>() });
+                        }
+                    for (const auto& outputJson : entryJson.at("outputs"))
+                        {
+                            entry.Outputs.push_back({ outputJson.at("path").get<std::string>(),
+                                outputJson.at("format").get<uint32_t>(),
+                                outputJson.at("key").get<uint64_t>(),
+                                StampFromJson(outputJson.at("stamp")),
+                                outputJson.at("hash").get<uint64_t>(),
+                                outputJson.value("saved_bytes", uint64_t{}) });
+                        }
+                    for (const auto& warningJson : entryJson.at("warnings"))
+                        {
+                            entry.Warnings.push_back({ EValidationSeverity::WARNING, warningJson.at("animation").get<std::string>(), warningJson.at("message").get<std::string>() });
+                        }
+                }
+        }
+    catch (const std::exception& e)
+        {
+            return "Invalid export cache " + manifestPath.string() + ": " + e.what();
+        }
+
+    std::lock_guard<std::mutex> lock{ _mutex };
+    _entries = std::move(entries);
+    return {};
+}
+
+std::optional<std::string>
+ExportCache::Save(const std::filesystem::path& manifestPath) const
+{
+    nlohmann::ordered_json j{};
+    j["version"]  = VERSION;
+    j["projects"] = nlohmann::ordered_json::object();
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        for (const auto& [spritePath, entry] : _entries)
+            {
+                if (std::error_code errorCode{}; !std::filesystem::exists(spritePath, errorCode))
+                    {
+                        continue;
+                    }
+
+                nlohmann::ordered_json entryJson{};
+                entryJson["formats"] = entry.Formats;
+                entryJson["inputs"]  = nlohmann::ordered_json::array();
+                for (const auto& input : entry.Inputs)
+                    {
+                        entryJson["inputs"].push_back({ { "path", input.Path }, { "stamp", ToJson(input.Stamp) }, { "hash", input.Hash } });
+                    }
+                entryJson["outputs"] = nlohmann::ordered_json::array();
+                for (const auto& output : entry.Outputs)
+                    {
+                        entryJson["outputs"].push_back({ { "path", output.Path }, { "format", output.Format }, { "key", output.Key }, { "stamp", ToJson(output.Stamp) }, { "hash", output.Hash } });
+                        if (output.SavedBytes > 0)
+                            {
+                                entryJson["outputs"].back()["saved_bytes"] = output.SavedBytes;
+                            }
+                    }
+                entryJson["warnings"] = nlohmann::ordered_json::array();
+                for (const auto& warning : entry.Warnings)
+                    {
+                        entryJson["warnings"].push_back({ { "animation", warning.Animation }, { "message", warning.Message } });
+                    }
+                j["projects"][spritePath] = std::move(entryJson);
+            }
+    }
+
+    const auto content{ j.dump(1) };
+    return WriteFileAtomically(manifestPath, content.data(), content.size());
+}
+
+std::optional<ExportCache::Entry>
+ExportCache::Find(const std::string& spritePath) const
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    if (const auto it{ _entries.find(spritePath) }; it != _entries.end())
+        {
+            return it->second;
+        }
+    return {};
+}
+
+void
+ExportCache::Store(const std::string& spritePath, Entry entry)
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    _entries[spritePath] = std::move(entry);
+}
+
+void
+ExportCache::Erase(const std::string& spritePath)
+{
+    std::lock_guard<std::mutex> lock{ _mutex };
+    _entries.erase(spritePath);
+}
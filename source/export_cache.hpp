@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "content_hash.hpp"
+#include "validation.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Content addressed manifest of the exports written by the batch mode, lets incremental builds skip the unchanged projects.
+ * Every output is keyed by the hash of its inputs: the image bytes, the serialized animations, the exporter version and the export options.
+ * Thread safe, the projects are processed in parallel.
+ */
+class ExportCache final
+{
+  public:
+    /**
+     * \brief Bumped whenever an exporter writes different bytes for the same inputs, invalidates every cached output.
+     */
+    constexpr static uint32_t VERSION{ 1 };
+
+    struct Input
+    {
+        std::string Path{};
+        FileStamp   Stamp{};
+        /**
+         * \brief The content hash, reused while the stamp does not change.
+         */
+        uint64_t    Hash{};
+    };
+
+    struct Output
+    {
+        std::string Path{};
+        /**
+         * \brief The batch::EExportFormat written.
+         */
+        uint32_t    Format{};
+        uint64_t    Key{};
+        /**
+         * \brief When written, an output whose stamp changed since is checked against its content hash.
+         */
+        FileStamp   Stamp{};
+        uint64_t    Hash{};
+        /**
+         * \brief The texture memory saved by an indexed page, reported again when the output is reused.
+         */
+        uint64_t    SavedBytes{};
+    };
+
+    struct Entry
+    {
+        /**
+         * \brief The project file then the pages, page 0 being the sprite.
+         */
+        std::vector<Input>           Inputs{};
+        std::vector<Output>          Outputs{};
+        /**
+         * \brief The formats up to date, the json export has no output of its own since it rewrites the project file.
+         */
+        uint32_t                     Formats{};
+        /**
+         * \brief Reported again when the project is skipped, only valid projects are cached.
+         */
+        std::vector<ValidationIssue> Warnings{};
+    };
+
+    /**
+     * \brief A missing manifest is an empty cache, as is a manifest of another version.
+     * \return The error string if the manifest exists but can not be read.
+     */
+    std::optional<std::string> Load(const std::filesystem::path& manifestPath);
+
+    /**
+     * \brief Written atomically, an interrupted build keeps the previous manifest. The entries of deleted sprites are dropped.
+     * \return The error string if failed.
+     */
+    std::optional<std::string> Save(const std::filesystem::path& manifestPath) const;
+
+    std::optional<Entry> Find(const std::string& spritePath) const;
+    void                 Store(const std::string& spritePath, Entry entry);
+    void                 Erase(const std::string& spritePath);
+
+    void   CountHits(size_t numHits) { _numHits += numHits; }
+    void   CountMisses(size_t numMisses) { _numMisses += numMisses; }
+    size_t GetNumHits() const { return _numHits; }
+    size_t GetNumMisses() const { return _numMisses; }
+
+  private:
+    mutable std::mutex           _mutex{};
+    // Sorted so the manifest diffs well
+    std::map<std::string, Entry> _entries{};
+    std::atomic<size_t>          _numHits{};
+    std::atomic<size_t>          _numMisses{};
+};
@@ -0,0 +1,471 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "export_format.hpp"
+
+#include "arena.hpp"
+#include "frame_layout.hpp"
+
+#include <sprite_uv/binary_format.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <sstream>
+#include <string_view>
+
+namespace
+{
+// Explicit byte order so the file is little endian whatever the host is
+void
+PutU32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+{
+    buffer[offset + 0] = static_cast<uint8_t>(value);
+    buffer[offset + 1] = static_cast<uint8_t>(value >> 8);
+    buffer[offset + 2] = static_cast<uint8_t>(value >> 16);
+    buffer[offset + 3] = static_cast<uint8_t>(value >> 24);
+}
+
+void
+PutF32(std::vector<uint8_t>& buffer, size_t offset, float value)
+{
+    uint32_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutU32(buffer, offset, bits);
+}
+
+struct SpritesheetEntry
+{
+    /**
+     * \brief Points into the json, which must outlive the entry.
+     */
+    std::string_view Name;
+    Rect             Uv;
+    int32_t          Frames;
+    int32_t          Columns;
+    int32_t          DurationMs;
+    bool             Looping;
+    int32_t          Page;
+};
+
+/**
+ * \brief In 64 bits, the product of two int32 overflows.
+ */
+uint64_t
+GetTotalDurationMs(const SpritesheetEntry& entry)
+{
+    return static_cast<uint64_t>(entry.Frames) * static_cast<uint64_t>(entry.DurationMs);
+}
+
+/**
+ * \brief The export temporaries are allocated from an arena dropped at the end of the export.
+ */
+std::pmr::vector<SpritesheetEntry>
+ReadSpritesheetEntries(const nlohmann::ordered_json& j, std::pmr::memory_resource* arena)
+{
+    std::pmr::vector<SpritesheetEntry> entries{ arena };
+    entries.reserve(j.at("animations").size());
+    for (const auto& animJson : j.at("animations"))
+        {
+            if (animJson.at("type").get_ref<const std::string&>() != "Spritesheet")
+                {
+                    continue;
+                }
+            SpritesheetEntry entry{};
+            entry.Name       = animJson.at("name").get_ref<const std::string&>();
+            entry.Uv         = { animJson.at("x").get<int32_t>(), animJson.at("y").get<int32_t>(), animJson.at("width").get<int32_t>(), animJson.at("height").get<int32_t>() };
+            entry.Frames     = std::max(1, animJson.at("frames").get<int32_t>());
+            entry.Columns    = std::max(1, animJson.at("columns").get<int32_t>());
+            entry.DurationMs = std::max(0, animJson.at("durationMs").get<int32_t>());
+            entry.Looping    = animJson.at("looping").get<bool>();
+            entry.Page       = std::max(0, animJson.value("page", 0));
+            entries.push_back(std::move(entry));
+        }
+    return entries;
+}
+
+/**
+ * \brief The size of the page, unknown pages fall back to the sprite size.
+ */
+Vec2
+GetPageSizeOrDefault(const std::vector<Vec2>& pageSizes, int32_t page)
+{
+    const Vec2 size{ static_cast<size_t>(page) < pageSizes.size() ? pageSizes[page] : Vec2{} };
+    if (size.x > 0 && size.y > 0)
+        {
+            return size;
+        }
+    return pageSizes.empty() ? Vec2{ 1, 1 } : Vec2{ std::max(1, pageSizes[0].x), std::max(1, pageSizes[0].y) };
+}
+
+/**
+ * \brief Turns any animation name into a valid, unique C++ identifier.
+ */
+std::string
+ToIdentifier(std::string_view name, std::set<std::string>& used)
+{
+    static const std::set<std::string> keywords{ "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const", "constexpr",
+        "continue", "default", "delete", "do", "double", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+        "long", "mutable", "namespace", "new", "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public", "register", "return", "short", "signed",
+        "sizeof", "static", "struct", "switch", "template", "this", "throw", "true", "try", "typedef", "typename", "union", "unsigned", "using", "virtual", "void",
+        "volatile", "while", "COUNT" };
+
+    std::string identifier{};
+    for (const char c : name)
+        {
+            identifier += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+    if (identifier.empty() || std::isdigit(static_cast<unsigned char>(identifier.front())) || identifier.front() == '_' || keywords.count(identifier))
+        {
+            identifier = "Anim_" + identifier;
+        }
+
+    std::string unique{ identifier };
+    for (int32_t suffix{ 1 }; used.count(unique); ++suffix)
+        {
+            unique = identifier + "_" + std::to_string(suffix);
+        }
+    used.insert(unique);
+    return unique;
+}
+
+/**
+ * \brief Escapes the name for a string literal of the generated header, control characters included.
+ * `?` is escaped so no trigraph can form, a hex escape ends the literal when a hex digit follows since the escape would swallow it.
+ */
+std::string
+EscapeString(std::string_view str)
+{
+    constexpr char HEX_DIGITS[]{ "0123456789ABCDEF" };
+
+    std::string escaped{};
+    bool        afterHexEscape{};
+    for (const char c : str)
+        {
+            const auto byte{ static_cast<unsigned char>(c) };
+            if (afterHexEscape && std::isxdigit(byte))
+                {
+                    escaped += "\" \"";
+                }
+            afterHexEscape = false;
+            switch (c)
+                {
+                    case '"': escaped += "\\\""; break;
+                    case '\\': escaped += "\\\\"; break;
+                    case '?': escaped += "\\?"; break;
+                    case '\n': escaped += "\\n"; break;
+                    case '\t': escaped += "\\t"; break;
+                    case '\r': escaped += "\\r"; break;
+                    default:
+                        {
+                            if (byte < 0x20 || byte == 0x7F)
+                                {
+                                    escaped += "\\x";
+                                    escaped += HEX_DIGITS[byte >> 4];
+                                    escaped += HEX_DIGITS[byte & 0xF];
+                                    afterHexEscape = true;
+                                }
+                            else
+                                {
+                                    escaped += c;
+                                }
+                            break;
+                        }
+                }
+        }
+    return escaped;
+}
+}
+
+std::string
+GetCppHeaderNamespace(const std::filesystem::path& spritePath)
+{
+    std::set<std::string> noReservedNames{};
+    return ToIdentifier(spritePath.stem().string() + "_animations", noReservedNames);
+}
+
+std::vector<uint8_t>
+BuildBinaryExport(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes)
+{
+    using namespace sprite_uv::binary;
+
+    Arena      arena{};
+    const auto entries{ ReadSpritesheetEntries(j, arena.Get()) };
+
+    uint32_t frameCount{};
+    uint32_t stringTableSize{};
+    for (const auto& entry : entries)
+        {
+            if (GetTotalDurationMs(entry) > std::numeric_limits<uint32_t>::max())
+                {
+                    return {};
+                }
+            frameCount += static_cast<uint32_t>(entry.Frames);
+            stringTableSize += static_cast<uint32_t>(entry.Name.size()) + 1;
+        }
+
+    const auto animationCount{ static_cast<uint32_t>(entries.size()) };
+    const auto lookupCapacity{ LookupCapacityFor(animationCount) };
+
+    // Section layout
+    const uint32_t animationsOffset{ AlignUp(sizeof(BinaryHeader)) };
+    const uint32_t framesOffset{ AlignUp(animationsOffset + animationCount * sizeof(BinaryAnimation)) };
+    const uint32_t durationsOffset{ AlignUp(framesOffset + frameCount * sizeof(BinaryFrameUv)) };
+    const uint32_t lookupOffset{ AlignUp(durationsOffset + frameCount * sizeof(uint32_t)) };
+    const uint32_t stringTableOffset{ AlignUp(lookupOffset + lookupCapacity * sizeof(BinaryLookupEntry)) };
+    const uint32_t fileSize{ AlignUp(stringTableOffset + stringTableSize) };
+
+    std::vector<uint8_t> buffer(fileSize, 0);
+
+    // Header
+    std::memcpy(buffer.data() + offsetof(BinaryHeader, Magic), MAGIC, sizeof(MAGIC));
+    PutU32(buffer, offsetof(BinaryHeader, Version), VERSION);
+    PutU32(buffer, offsetof(BinaryHeader, FileSize), fileSize);
+    const Vec2 spriteSize{ GetPageSizeOrDefault(pageSizes, 0) };
+    PutU32(buffer, offsetof(BinaryHeader, TextureWidth), static_cast<uint32_t>(spriteSize.x));
+    PutU32(buffer, offsetof(BinaryHeader, TextureHeight), static_cast<uint32_t>(spriteSize.y));
+    PutU32(buffer, offsetof(BinaryHeader, AnimationCount), animationCount);
+    PutU32(buffer, offsetof(BinaryHeader, FrameCount), frameCount);
+    PutU32(buffer, offsetof(BinaryHeader, LookupCapacity), lookupCapacity);
+    PutU32(buffer, offsetof(BinaryHeader, AnimationsOffset), animationsOffset);
+    PutU32(buffer, offsetof(BinaryHeader, FramesOffset), framesOffset);
+    PutU32(buffer, offsetof(BinaryHeader, DurationsOffset), durationsOffset);
+    PutU32(buffer, offsetof(BinaryHeader, LookupOffset), lookupOffset);
+    PutU32(buffer, offsetof(BinaryHeader, StringTableOffset), stringTableOffset);
+    PutU32(buffer, offsetof(BinaryHeader, StringTableSize), stringTableSize);
+
+    std::pmr::vector<BinaryLookupEntry> lookup(lookupCapacity, BinaryLookupEntry{ 0, EMPTY_LOOKUP_INDEX }, arena.Get());
+
+    uint32_t firstFrame{};
+    uint32_t nameOffset{};
+    for (uint32_t i{}; i < animationCount; ++i)
+        {
+            const auto&    entry{ entries[i] };
+            const uint32_t hash{ HashName(entry.Name) };
+            const Vec2     pageSize{ GetPageSizeOrDefault(pageSizes, entry.Page) };
+            const float    invTexW{ 1.f / static_cast<float>(pageSize.x) };
+            const float    invTexH{ 1.f / static_cast<float>(pageSize.y) };
+
+            const size_t animOffset{ animationsOffset + i * sizeof(BinaryAnimation) };
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, NameOffset), nameOffset);
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, NameLength), static_cast<uint32_t>(entry.Name.size()));
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, NameHash), hash);
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, FirstFrame), firstFrame);
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, FrameCount), static_cast<uint32_t>(entry.Frames));
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, Flags), entry.Looping ? EAnimationFlags::LOOPING : 0u);
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, TotalDurationMs), static_cast<uint32_t>(GetTotalDurationMs(entry)));
+            PutU32(buffer, animOffset + offsetof(BinaryAnimation, Page), static_cast<uint32_t>(entry.Page));
+
+            for (int32_t f{}; f < entry.Frames; ++f)
+                {
+                    const float x{ static_cast<float>(entry.Uv.x + frame::OffsetX(f, entry.Columns, entry.Uv.w)) };
+                    const float y{ static_cast<float>(entry.Uv.y + frame::OffsetY(f, entry.Columns, entry.Uv.h)) };
+
+                    const size_t frameOffset{ framesOffset + (firstFrame + f) * sizeof(BinaryFrameUv) };
+                    PutF32(buffer, frameOffset + offsetof(BinaryFrameUv, U0), x * invTexW);
+                    PutF32(buffer, frameOffset + offsetof(BinaryFrameUv, V0), y * invTexH);
+                    PutF32(buffer, frameOffset + offsetof(BinaryFrameUv, U1), (x + entry.Uv.w) * invTexW);
+                    PutF32(buffer, frameOffset + offsetof(BinaryFrameUv, V1), (y + entry.Uv.h) * invTexH);
+
+                    PutU32(buffer, durationsOffset + (firstFrame + f) * sizeof(uint32_t), static_cast<uint32_t>(entry.DurationMs));
+                }
+
+            // Linear probing, the capacity is always at least twice the count so there is always a free slot
+            uint32_t slot{ hash & (lookupCapacity - 1) };
+            while (lookup[slot].AnimationIndex != EMPTY_LOOKUP_INDEX)
+                {
+                    slot = (slot + 1) & (lookupCapacity - 1);
+                }
+            lookup[slot] = { hash, i };
+
+            // The buffer is zeroed, the terminator is already there
+            std::memcpy(buffer.data() + stringTableOffset + nameOffset, entry.Name.data(), entry.Name.size());
+
+            nameOffset += static_cast<uint32_t>(entry.Name.size()) + 1;
+            firstFrame += static_cast<uint32_t>(entry.Frames);
+        }
+
+    for (uint32_t slot{}; slot < lookupCapacity; ++slot)
+        {
+            const size_t slotOffset{ lookupOffset + slot * sizeof(BinaryLookupEntry) };
+            PutU32(buffer, slotOffset + offsetof(BinaryLookupEntry, NameHash), lookup[slot].NameHash);
+            PutU32(buffer, slotOffset + offsetof(BinaryLookupEntry, AnimationIndex), lookup[slot].AnimationIndex);
+        }
+
+    return buffer;
+}
+
+std::string
+BuildCppHeaderExport(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes, const std::string& namespaceName)
+{
+    Arena      arena{};
+    const auto entries{ ReadSpritesheetEntries(j, arena.Get()) };
+
+    // Every referenced page must have a size entry
+    int32_t numOfPages{ std::max<int32_t>(1, static_cast<int32_t>(pageSizes.size())) };
+    for (const auto& entry : entries)
+        {
+            numOfPages = std::max(numOfPages, entry.Page + 1);
+        }
+    const Vec2 spriteSize{ GetPageSizeOrDefault(pageSizes, 0) };
+
+    std::set<std::string>    usedIdentifiers{};
+    std::vector<std::string> identifiers{};
+    for (const auto& entry : entries)
+        {
+            identifiers.push_back(ToIdentifier(entry.Name, usedIdentifiers));
+        }
+
+    std::ostringstream out{};
+    out << "// Generated by Sprite UV Editor, do not edit.\n"
+           "#pragma once\n\n"
+           "#include <cstdint>\n"
+           "#include <string_view>\n\n"
+        << "namespace " << namespaceName << "\n{\n\n"
+        << "inline constexpr int32_t TEXTURE_WIDTH{ " << spriteSize.x << " };\n"
+        << "inline constexpr int32_t TEXTURE_HEIGHT{ " << spriteSize.y << " };\n"
+        << "inline constexpr int32_t PAGE_COUNT{ " << numOfPages << " };\n"
+        << "inline constexpr int32_t ANIMATION_COUNT{ " << entries.size() << " };\n\n";
+
+    out << "enum class EAnimation : uint32_t\n{\n";
+    for (const auto& identifier : identifiers)
+        {
+            out << "    " << identifier << ",\n";
+        }
+    out << "    COUNT,\n};\n";
+
+    if (entries.empty())
+        {
+            out << "\n}\n";
+            return out.str();
+        }
+
+    out << "\n"
+           "struct Animation\n{\n"
+           "    const char* name;\n"
+           "    int32_t     firstFrame;\n"
+           "    int32_t     frameCount;\n"
+           "    int32_t     frameDurationMs;\n"
+           "    bool        looping;\n"
+           "    int32_t     page;\n"
+           "};\n\n"
+           "struct PageSize\n{\n"
+           "    int32_t width, height;\n"
+           "};\n\n"
+           "struct FrameRect\n{\n"
+           "    int32_t x, y, w, h;\n"
+           "};\n\n"
+           "struct FrameUv\n{\n"
+           "    float u0, v0, u1, v1;\n"
+           "};\n\n";
+
+    out << "inline constexpr PageSize PAGE_SIZES[]{\n";
+    for (int32_t page{}; page < numOfPages; ++page)
+        {
+            const Vec2 pageSize{ GetPageSizeOrDefault(pageSizes, page) };
+            out << "    { " << pageSize.x << ", " << pageSize.y << " },\n";
+        }
+    out << "};\n\n";
+
+    out << "inline constexpr Animation ANIMATIONS[]{\n";
+    int32_t firstFrame{};
+    for (const auto& entry : entries)
+        {
+            out << "    { \"" << EscapeString(entry.Name) << "\", " << firstFrame << ", " << entry.Frames << ", " << entry.DurationMs << ", " << (entry.Looping ? "true" : "false")
+                << ", " << entry.Page << " },\n";
+            firstFrame += entry.Frames;
+        }
+    out << "};\n\n";
+
+    // Pixel rects, same frame layout math as the editor
+    out << "inline constexpr FrameRect FRAME_RECTS[]{\n";
+    for (size_t i{}; i < entries.size(); ++i)
+        {
+            const auto& entry{ entries[i] };
+            out << "    // " << identifiers[i] << "\n";
+            for (int32_t f{}; f < entry.Frames; ++f)
+                {
+                    out << "    { " << entry.Uv.x + frame::OffsetX(f, entry.Columns, entry.Uv.w) << ", " << entry.Uv.y + frame::OffsetY(f, entry.Columns, entry.Uv.h) << ", " << entry.Uv.w
+                        << ", " << entry.Uv.h << " },\n";
+                }
+        }
+    out << "};\n\n";
+
+    out << "constexpr const Animation&\n"
+           "Get(EAnimation animation)\n{\n"
+           "    return ANIMATIONS[static_cast<uint32_t>(animation)];\n"
+           "}\n\n"
+           "/**\n"
+           " * \\brief Compile time lookup by name, returns EAnimation::COUNT if not found.\n"
+           " */\n"
+           "constexpr EAnimation\n"
+           "Find(std::string_view name)\n{\n"
+           "    for (uint32_t i{}; i < static_cast<uint32_t>(ANIMATION_COUNT); ++i)\n"
+           "        {\n"
+           "            if (name == ANIMATIONS[i].name)\n"
+           "                {\n"
+           "                    return static_cast<EAnimation>(i);\n"
+           "                }\n"
+           "        }\n"
+           "    return EAnimation::COUNT;\n"
+           "}\n\n"
+           "/**\n"
+           " * \\brief Frame index at the time since the animation started, non looping animations stop on the last frame.\n"
+           " */\n"
+           "constexpr int32_t\n"
+           "FrameIndexAt(EAnimation animation, int64_t elapsedMs)\n{\n"
+           "    const Animation& a{ Get(animation) };\n"
+           "    if (a.frameCount <= 1 || a.frameDurationMs <= 0 || elapsedMs <= 0)\n"
+           "        {\n"
+           "            return 0;\n"
+           "        }\n"
+           "    const int64_t frameAdvances{ elapsedMs / a.frameDurationMs };\n"
+           "    if (a.looping)\n"
+           "        {\n"
+           "            return static_cast<int32_t>(frameAdvances % a.frameCount);\n"
+           "        }\n"
+           "    return frameAdvances >= a.frameCount ? a.frameCount - 1 : static_cast<int32_t>(frameAdvances);\n"
+           "}\n\n"
+           "constexpr const FrameRect&\n"
+           "GetFrameRect(EAnimation animation, int32_t frameIndex)\n{\n"
+           "    return FRAME_RECTS[Get(animation).firstFrame + frameIndex];\n"
+           "}\n\n"
+           "constexpr FrameUv\n"
+           "GetFrameUv(EAnimation animation, int32_t frameIndex)\n{\n"
+           "    const FrameRect& r{ GetFrameRect(animation, frameIndex) };\n"
+           "    const PageSize&  page{ PAGE_SIZES[Get(animation).page] };\n"
+           "    return { static_cast<float>(r.x) / page.width, static_cast<float>(r.y) / page.height, static_cast<float>(r.x + r.w) / page.width, static_cast<float>(r.y + r.h) / page.height };\n"
+           "}\n\n"
+           "constexpr FrameUv\n"
+           "Sample(EAnimation animation, int64_t elapsedMs)\n{\n"
+           "    return GetFrameUv(animation, FrameIndexAt(animation, elapsedMs));\n"
+           "}\n\n"
+           "}\n";
+
+    return out.str();
+}
@@ -0,0 +1,55 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "geometry_types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// The exports built from the serialized animations, kept free of raylib so they can be tested headless
+
+/**
+ * \brief Builds the binary runtime export (see sprite_uv/binary_format.hpp) from the serialized animations.
+ * Uses the same json written by Project::SaveToFile so both exports always describe the same data.
+ * UVs are normalized by the size of the page of each animation, page 0 being the sprite.
+ * \return Empty if the total duration of an animation does not fit the 32 bits of the format, ValidateProjectJson reports it.
+ */
+std::vector<uint8_t> BuildBinaryExport(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes);
+
+/**
+ * \brief Generates a C++17 header holding the animations as constexpr tables, an enum of names and constexpr sampling helpers.
+ * Frame rects are computed with the editor frame layout so the tables match the other exports.
+ */
+std::string BuildCppHeaderExport(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes, const std::string& namespaceName);
+
+/**
+ * \brief The namespace of the generated header, a valid identifier made from the sprite name.
+ */
+std::string GetCppHeaderNamespace(const std::filesystem::path& spritePath);
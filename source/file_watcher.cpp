@@ -0,0 +1,178 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "file_watcher.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#if !defined(__linux__)
+namespace
+{
+std::filesystem::file_time_type
+GetLastWriteTime(const std::filesystem::path& path)
+{
+    std::error_code error{};
+    const auto      time{ std::filesystem::last_write_time(path, error) };
+    return error ? std::filesystem::file_time_type{} : time;
+}
+}
+#endif
+
+std::filesystem::path
+FileWatcher::Normalize(const std::filesystem::path& path)
+{
+    std::error_code error{};
+    const auto      absolute{ std::filesystem::absolute(path, error) };
+    return (error ? path : absolute).lexically_normal();
+}
+
+#if defined(__linux__)
+
+FileWatcher::FileWatcher() : _inotifyFd{ inotify_init1(IN_NONBLOCK | IN_CLOEXEC) } {}
+
+FileWatcher::~FileWatcher()
+{
+    if (_inotifyFd >= 0)
+        {
+            close(_inotifyFd);
+        }
+}
+
+void
+FileWatcher::Watch(const std::vector<std::string>& filePaths)
+{
+    for (const auto& [wd, directory] : _watchedDirectories)
+        {
+            inotify_rm_watch(_inotifyFd, wd);
+        }
+    _watchedDirectories.clear();
+    _files.clear();
+
+    if (_inotifyFd < 0)
+        {
+            return;
+        }
+
+    for (const auto& filePath : filePaths)
+        {
+            _files.push_back(Normalize(filePath));
+            // Watch the directory, paint tools often save by writing a temporary file and renaming it over the original
+            const auto directory{ _files.back().parent_path() };
+            const int  wd{ inotify_add_watch(_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) };
+            if (wd >= 0)
+                {
+                    _watchedDirectories[wd] = directory;
+                }
+        }
+}
+
+std::vector<std::string>
+FileWatcher::PollChanges()
+{
+    std::vector<std::string> changed{};
+    if (_inotifyFd < 0)
+        {
+            return changed;
+        }
+
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+        {
+            const ssize_t length{ read(_inotifyFd, buffer, sizeof(buffer)) };
+            if (length <= 0)
+                {
+                    break;
+                }
+
+            for (ssize_t offset{}; offset < length;)
+                {
+                    const auto* event{ reinterpret_cast<const inotify_event*>(buffer + offset) };
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                    const auto directory{ _watchedDirectories.find(event->wd) };
+                    if (event->len == 0 || directory == _watchedDirectories.end())
+                        {
+                            continue;
+                        }
+
+                    const auto path{ (directory->second / event->name).lexically_normal() };
+                    if (std::find(_files.begin(), _files.end(), path) != _files.end() && std::find(changed.begin(), changed.end(), path.string()) == changed.end())
+                        {
+                            changed.push_back(path.string());
+                        }
+                }
+        }
+
+    return changed;
+}
+
+#else
+
+FileWatcher::FileWatcher()  = default;
+FileWatcher::~FileWatcher() = default;
+
+void
+FileWatcher::Watch(const std::vector<std::string>& filePaths)
+{
+    _files.clear();
+    _lastWriteTimes.clear();
+    for (const auto& filePath : filePaths)
+        {
+            _files.push_back(Normalize(filePath));
+            _lastWriteTimes.push_back(GetLastWriteTime(_files.back()));
+        }
+    _lastPoll = std::chrono::steady_clock::now();
+}
+
+std::vector<std::string>
+FileWatcher::PollChanges()
+{
+    std::vector<std::string> changed{};
+
+    const auto now{ std::chrono::steady_clock::now() };
+    if (now - _lastPoll < POLL_INTERVAL)
+        {
+            return changed;
+        }
+    _lastPoll = now;
+
+    for (size_t i{}; i < _files.size(); ++i)
+        {
+            const auto writeTime{ GetLastWriteTime(_files[i]) };
+            if (writeTime != _lastWriteTimes[i])
+                {
+                    _lastWriteTimes[i] = writeTime;
+                    changed.push_back(_files[i].string());
+                }
+        }
+
+    return changed;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief Reports files changed on disk by other programs.
+ * Uses inotify on Linux, elsewhere falls back to polling the last write time.
+ */
+class FileWatcher final
+{
+  public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&)            = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * \brief Replaces the watched files, the files do not need to exist yet.
+     */
+    void Watch(const std::vector<std::string>& filePaths);
+    /**
+     * \brief Non blocking, returns every watched file changed since the previous call as normalized absolute paths.
+     */
+    std::vector<std::string> PollChanges();
+
+    static std::filesystem::path Normalize(const std::filesystem::path& path);
+
+  private:
+    std::vector<std::filesystem::path> _files{};
+#if defined(__linux__)
+    int                                            _inotifyFd{ -1 };
+    std::unordered_map<int, std::filesystem::path> _watchedDirectories{};
+#else
+    constexpr static std::chrono::milliseconds   POLL_INTERVAL{ 500 };
+    std::vector<std::filesystem::file_time_type> _lastWriteTimes{};
+    std::chrono::steady_clock::time_point        _lastPoll{};
+#endif
+};
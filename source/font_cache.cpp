@@ -0,0 +1,212 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "font_cache.hpp"
+
+#include "content_hash.hpp"
+#include "export.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr char     FONT_MAGIC[4]{ 'S', 'U', 'V', 'F' };
+constexpr uint32_t FONT_CACHE_VERSION{ 1 };
+// The padding of LoadFontFromMemory
+constexpr int32_t  GLYPH_PADDING{ 4 };
+
+/**
+ * \brief In host byte order, the cache is local to the machine.
+ */
+struct FontHeader
+{
+    char     Magic[4]{};
+    uint32_t Version{};
+    uint64_t Key{};
+    int32_t  BaseSize{};
+    int32_t  GlyphCount{};
+    int32_t  GlyphPadding{};
+    int32_t  AtlasWidth{};
+    int32_t  AtlasHeight{};
+    int32_t  AtlasFormat{};
+};
+
+struct CachedGlyph
+{
+    int32_t Value{};
+    int32_t OffsetX{};
+    int32_t OffsetY{};
+    int32_t AdvanceX{};
+    float   X{};
+    float   Y{};
+    float   Width{};
+    float   Height{};
+};
+
+/**
+ * \brief Everything the rasterization depends on, a raylib update rasterizes again.
+ */
+uint64_t
+ComputeFontKey(const uint8_t* fileData, size_t fileSize, int32_t fontSize, int32_t numGlyphs)
+{
+    ContentHasher hasher{};
+    hasher.UpdateValue(FONT_CACHE_VERSION);
+    hasher.Update(RAYLIB_VERSION);
+    hasher.UpdateValue(fontSize);
+    hasher.UpdateValue(numGlyphs);
+    hasher.Update(fileData, fileSize);
+    return hasher.Digest();
+}
+
+std::optional<Font>
+ReadCachedFont(const std::filesystem::path& cachePath, uint64_t key)
+{
+    std::ifstream fileStream{ cachePath, std::ios::binary };
+    FontHeader    header{};
+    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.Magic, FONT_MAGIC, sizeof(FONT_MAGIC)) != 0 ||
+        header.Version != FONT_CACHE_VERSION || header.Key != key || header.GlyphCount <= 0 || header.AtlasWidth <= 0 || header.AtlasHeight <= 0)
+        {
+            return {};
+        }
+    std::vector<CachedGlyph> glyphs(static_cast<size_t>(header.GlyphCount));
+    if (!fileStream.read(reinterpret_cast<char*>(glyphs.data()), static_cast<std::streamsize>(glyphs.size() * sizeof(CachedGlyph))))
+        {
+            return {};
+        }
+
+    const int32_t atlasBytes{ GetPixelDataSize(header.AtlasWidth, header.AtlasHeight, header.AtlasFormat) };
+    Image         atlas{};
+    atlas.data    = MemAlloc(static_cast<unsigned int>(atlasBytes));
+    atlas.width   = header.AtlasWidth;
+    atlas.height  = header.AtlasHeight;
+    atlas.mipmaps = 1;
+    atlas.format  = header.AtlasFormat;
+    if (!fileStream.read(static_cast<char*>(atlas.data), atlasBytes))
+        {
+            UnloadImage(atlas);
+            return {};
+        }
+
+    Font font{};
+    font.baseSize     = header.BaseSize;
+    font.glyphCount   = header.GlyphCount;
+    font.glyphPadding = header.GlyphPadding;
+    font.texture      = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    if (font.texture.id == 0)
+        {
+            return {};
+        }
+    // Allocated by raylib so UnloadFont releases them
+    font.recs   = static_cast<Rectangle*>(MemAlloc(static_cast<unsigned int>(glyphs.size() * sizeof(Rectangle))));
+    font.glyphs = static_cast<GlyphInfo*>(MemAlloc(static_cast<unsigned int>(glyphs.size() * sizeof(GlyphInfo))));
+    for (size_t i{}; i < glyphs.size(); ++i)
+        {
+            font.recs[i]   = { glyphs[i].X, glyphs[i].Y, glyphs[i].Width, glyphs[i].Height };
+            font.glyphs[i] = { glyphs[i].Value, glyphs[i].OffsetX, glyphs[i].OffsetY, glyphs[i].AdvanceX, Image{} };
+        }
+    return font;
+}
+
+std::optional<std::string>
+WriteCachedFont(const std::filesystem::path& cachePath, uint64_t key, const Font& font, const Image& atlas)
+{
+    FontHeader header{};
+    std::memcpy(header.Magic, FONT_MAGIC, sizeof(FONT_MAGIC));
+    header.Version      = FONT_CACHE_VERSION;
+    header.Key          = key;
+    header.BaseSize     = font.baseSize;
+    header.GlyphCount   = font.glyphCount;
+    header.GlyphPadding = font.glyphPadding;
+    header.AtlasWidth   = atlas.width;
+    header.AtlasHeight  = atlas.height;
+    header.AtlasFormat  = atlas.format;
+
+    std::vector<uint8_t> buffer(sizeof(header));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    for (int32_t i{}; i < font.glyphCount; ++i)
+        {
+            const Rectangle&  rec{ font.recs[i] };
+            const GlyphInfo&  glyph{ font.glyphs[i] };
+            const CachedGlyph cachedGlyph{ glyph.value, glyph.offsetX, glyph.offsetY, glyph.advanceX, rec.x, rec.y, rec.width, rec.height };
+            const auto*       bytes{ reinterpret_cast<const uint8_t*>(&cachedGlyph) };
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(cachedGlyph));
+        }
+    const auto* pixels{ static_cast<const uint8_t*>(atlas.data) };
+    buffer.insert(buffer.end(), pixels, pixels + GetPixelDataSize(atlas.width, atlas.height, atlas.format));
+
+    std::error_code errorCode{};
+    std::filesystem::create_directories(cachePath.parent_path(), errorCode);
+    return WriteFileAtomically(cachePath, buffer.data(), buffer.size());
+}
+}
+
+Font
+LoadFontCached(const uint8_t* fileData, size_t fileSize, int32_t fontSize, int32_t numGlyphs, const std::filesystem::path& cacheDirectory, bool* outFromCache)
+{
+    const uint64_t key{ ComputeFontKey(fileData, fileSize, fontSize, numGlyphs) };
+    char           name[32]{};
+    std::snprintf(name, sizeof(name), "font_%016llx.atlas", static_cast<unsigned long long>(key));
+    const auto cachePath{ cacheDirectory / name };
+    if (outFromCache)
+        {
+            *outFromCache = false;
+        }
+    if (auto cachedFont{ ReadCachedFont(cachePath, key) }; cachedFont.has_value())
+        {
+            if (outFromCache)
+                {
+                    *outFromCache = true;
+                }
+            return cachedFont.value();
+        }
+
+    // What LoadFontFromMemory does, with the atlas image kept for the cache
+    Font font{};
+    font.baseSize     = fontSize;
+    font.glyphCount   = numGlyphs;
+    font.glyphPadding = GLYPH_PADDING;
+    font.glyphs       = LoadFontData(fileData, static_cast<int32_t>(fileSize), fontSize, nullptr, numGlyphs, FONT_DEFAULT);
+    if (!font.glyphs)
+        {
+            return GetFontDefault();
+        }
+    Image atlas  = GenImageFontAtlas(font.glyphs, &font.recs, numGlyphs, fontSize, GLYPH_PADDING, 0);
+    font.texture = LoadTextureFromImage(atlas);
+    // Same glyphs whether the font comes from the cache or not
+    for (int32_t i{}; i < numGlyphs; ++i)
+        {
+            UnloadImage(font.glyphs[i].image);
+            font.glyphs[i].image = {};
+        }
+    // A failed write only costs the rasterization next time
+    WriteCachedFont(cachePath, key, font, atlas);
+    UnloadImage(atlas);
+    return font;
+}
@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Frame layout math shared by the editor, the previews and the exporters.
+// Kept free of raylib so it can be used from headless code.
+namespace frame
+{
+
+/**
+ * \brief Offset of the frame from the top left corner of the first frame, frames wrap after `columns`.
+ */
+constexpr int32_t
+OffsetX(int32_t frameIndex, int32_t columns, int32_t frameWidth)
+{
+    return (frameIndex % (columns > 0 ? columns : 1)) * frameWidth;
+}
+
+constexpr int32_t
+OffsetY(int32_t frameIndex, int32_t columns, int32_t frameHeight)
+{
+    return (frameIndex / (columns > 0 ? columns : 1)) * frameHeight;
+}
+
+/**
+ * \brief Computes the frame index from an absolute time, no state is required thus every animation can be sampled from the same clock.
+ * Non looping animations stop on the last frame.
+ */
+constexpr int32_t
+IndexAtTime(int64_t elapsedMs, int32_t numOfFrames, int32_t frameDurationMs, bool looping)
+{
+    if (numOfFrames <= 1 || frameDurationMs <= 0 || elapsedMs <= 0)
+        {
+            return 0;
+        }
+
+    const int64_t frameAdvances{ elapsedMs / frameDurationMs };
+    if (looping)
+        {
+            return static_cast<int32_t>(frameAdvances % numOfFrames);
+        }
+    return frameAdvances >= numOfFrames ? numOfFrames - 1 : static_cast<int32_t>(frameAdvances);
+}
+
+}
@@ -26,24 +26,7 @@ SOFTWARE.
 
 #include "raylib.h"
 
-#include <cstdint>
-
-template<typename T>
-struct TVec2
-{
-    T x{}, y{};
-};
-
-template<typename T>
-struct TRect
-{
-    T x{}, y{}, w{}, h{};
-};
-
-// Use int32_t for all coordinates and sizes since raygui/raylib use int for those
-// Also avoid floating point precision issues for pixel coordinates
-using Vec2 = TVec2<int32_t>;
-using Rect = TRect<int32_t>;
+#include "geometry_types.hpp"
 
 namespace to
 {
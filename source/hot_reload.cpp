@@ -0,0 +1,376 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "hot_reload.hpp"
+
+#include "memory_stats.hpp"
+#include "profiler.hpp"
+#include "project.hpp"
+#include "texture_cache.hpp"
+#include "texture_upload.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+constexpr int32_t BYTES_PER_PIXEL{ 4 };
+
+Image
+DecodeRgbaImage(const std::string& imagePath)
+{
+    // The edited sprite is stored in the image cache, reopening it later maps it
+    return LoadRgbaImage(imagePath).Release();
+}
+}
+
+std::vector<Rect>
+FindDirtyRects(const Image& previous, const Image& next, int32_t tileSize)
+{
+    assert(previous.width == next.width && previous.height == next.height);
+    assert(previous.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 && next.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    const auto*  previousPixels{ static_cast<const uint8_t*>(previous.data) };
+    const auto*  nextPixels{ static_cast<const uint8_t*>(next.data) };
+    const size_t stride{ static_cast<size_t>(next.width) * BYTES_PER_PIXEL };
+
+    std::vector<Rect>   rects{};
+    std::vector<size_t> openRects{}; // Rects ending on the current tile row, they can still grow downwards
+    std::vector<size_t> nextOpenRects{};
+    for (int32_t ty{}; ty < next.height; ty += tileSize)
+        {
+            const int32_t th{ std::min(tileSize, next.height - ty) };
+            nextOpenRects.clear();
+
+            for (int32_t tx{}; tx < next.width; tx += tileSize)
+                {
+                    const int32_t tw{ std::min(tileSize, next.width - tx) };
+                    bool          dirty{};
+                    for (int32_t y{ ty }; y < ty + th && !dirty; ++y)
+                        {
+                            const size_t offset{ y * stride + static_cast<size_t>(tx) * BYTES_PER_PIXEL };
+                            dirty = std::memcmp(previousPixels + offset, nextPixels + offset, static_cast<size_t>(tw) * BYTES_PER_PIXEL) != 0;
+                        }
+                    if (!dirty)
+                        {
+                            continue;
+                        }
+
+                    // Grow the span started by the previous tile of this row
+                    if (!nextOpenRects.empty() && rects[nextOpenRects.back()].y == ty && rects[nextOpenRects.back()].x + rects[nextOpenRects.back()].w == tx)
+                        {
+                            rects[nextOpenRects.back()].w += tw;
+                            continue;
+                        }
+                    rects.push_back({ tx, ty, tw, th });
+                    nextOpenRects.push_back(rects.size() - 1);
+                }
+
+            // Merge the spans of this row into the rects above covering exactly the same columns
+            for (auto& spanIndex : nextOpenRects)
+                {
+                    const Rect& span{ rects[spanIndex] };
+                    const auto  above{ std::find_if(openRects.begin(), openRects.end(), [&](size_t i) { return rects[i].x == span.x && rects[i].w == span.w; }) };
+                    if (above != openRects.end())
+                        {
+                            rects[*above].h += span.h;
+                            rects[spanIndex].w = 0; // Merged, removed below
+                            spanIndex          = *above;
+                        }
+                }
+            std::swap(openRects, nextOpenRects);
+        }
+
+    rects.erase(std::remove_if(rects.begin(), rects.end(), [](const Rect& r) { return r.w == 0; }), rects.end());
+    return rects;
+}
+
+HotReloader::~HotReloader()
+{
+    DiscardPendingDecode();
+    FinishRemap(nullptr);
+}
+
+std::optional<std::string>
+HotReloader::TakeRemapReport()
+{
+    return std::exchange(_remapReport, std::nullopt);
+}
+
+void
+HotReloader::ReportMemory(MemoryReport& report) const
+{
+    report.Add("transient/upload_scratch", static_cast<int64_t>(_uploadScratch.capacity()));
+    report.Add("cpu/sprite_mip_levels", static_cast<int64_t>(_mipLevels.capacity()));
+    if (_pendingRemap.valid())
+        {
+            // Both images are owned by the remap task until it completes
+            report.Add("transient/remap_images", _remapImageBytes, 2);
+        }
+}
+
+void
+HotReloader::StartDecode(const std::string& imagePath)
+{
+    _pendingImage = std::async(std::launch::async, DecodeRgbaImage, imagePath);
+}
+
+void
+HotReloader::DiscardPendingDecode()
+{
+    if (_pendingImage.valid())
+        {
+            Image image = _pendingImage.get();
+            if (image.data)
+                {
+                    UnloadImage(image);
+                }
+        }
+    _decodeAgain = false;
+}
+
+std::optional<std::string>
+HotReloader::Update(Project& project)
+{
+    PROFILE_SCOPE("HotReloader::Update");
+    // The project changed, watch the new files
+    if (project.SpritePath != _watchedSpritePath)
+        {
+            DiscardPendingDecode();
+            FinishRemap(nullptr);
+            _watchedSpritePath = project.SpritePath;
+            _watcher.Watch(_watchedSpritePath.empty() ? std::vector<std::string>{} : std::vector<std::string>{ project.SpritePath, project.GetProjectFilePath() });
+        }
+
+    std::optional<std::string> error{};
+
+    const auto spritePath{ FileWatcher::Normalize(project.SpritePath).string() };
+    const auto projectFilePath{ FileWatcher::Normalize(project.GetProjectFilePath()).string() };
+    for (const auto& changedPath : _watcher.PollChanges())
+        {
+            if (changedPath == spritePath)
+                {
+                    // Still decoding the previous change, decode again once done
+                    if (_pendingImage.valid())
+                        {
+                            _decodeAgain = true;
+                        }
+                    else
+                        {
+                            StartDecode(project.SpritePath);
+                        }
+                }
+            else if (changedPath == projectFilePath)
+                {
+                    error = project.MergeAnimationDataFromFile();
+                }
+        }
+
+    if (_pendingImage.valid() && _pendingImage.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            Image image = _pendingImage.get();
+            // A failed decode usually means the file is still being written, the next change event retries
+            if (image.data)
+                {
+                    error = ApplyImage(project, image);
+                }
+            if (_decodeAgain)
+                {
+                    _decodeAgain = false;
+                    StartDecode(project.SpritePath);
+                }
+        }
+
+    if (_pendingRemap.valid() && _pendingRemap.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            FinishRemap(&project);
+        }
+
+    return error;
+}
+
+void
+HotReloader::StartRemap(Project& project, std::optional<Image> previous)
+{
+    if (!previous.has_value())
+        {
+            return;
+        }
+
+    auto animations{ CollectUvRemapInput(project) };
+    if (!HasAnyFrameChanged(previous.value(), project.SpriteImage.value(), animations))
+        {
+            UnloadImage(previous.value());
+            return;
+        }
+
+    // One remap at a time, the previous one is applied first so its result is not lost
+    FinishRemap(&project);
+
+    // The task owns both images, the project image may be replaced or unloaded meanwhile
+    _remapSpritePath = project.SpritePath;
+    _remapImageBytes = GetPixelDataSize(previous->width, previous->height, previous->format) +
+                       GetPixelDataSize(project.SpriteImage->width, project.SpriteImage->height, project.SpriteImage->format);
+    _pendingRemap    = std::async(std::launch::async, [previousImage = previous.value(), nextImage = ImageCopy(project.SpriteImage.value()), animations = std::move(animations)]() {
+        UvRemapReport report{ FindRemappedUvs(previousImage, nextImage, animations) };
+        UnloadImage(previousImage);
+        UnloadImage(nextImage);
+        return report;
+    });
+}
+
+void
+HotReloader::FinishRemap(Project* project)
+{
+    if (!_pendingRemap.valid())
+        {
+            return;
+        }
+
+    const UvRemapReport report{ _pendingRemap.get() };
+    _remapImageBytes = 0;
+    // Dropped if the project changed meanwhile
+    if (!project || project->SpritePath != _remapSpritePath)
+        {
+            return;
+        }
+    if (ApplyUvRemap(*project, report) || report.NumLowConfidence > 0)
+        {
+            _remapReport = report.ToString();
+        }
+}
+
+std::optional<std::string>
+HotReloader::ApplyImage(Project& project, Image image)
+{
+    // Size changed or nothing resident, the whole texture must be recreated
+    if (!project.SpriteTexture.has_value() || !project.SpriteImage.has_value() || project.SpriteImage->width != image.width || project.SpriteImage->height != image.height)
+        {
+            Texture2D newTexture = LoadMipmappedTexture(image);
+            if (newTexture.id == 0)
+                {
+                    UnloadImage(image);
+                    return "Failed to allocate the sprite GPU texture!";
+                }
+            if (project.SpriteTexture.has_value())
+                {
+                    UnloadTexture(project.SpriteTexture.value());
+                }
+            std::optional<Image> previous{ project.SpriteImage };
+            project.SpriteTexture = newTexture;
+            project.SpriteImage   = image;
+            _lastUploadedPixels   = static_cast<int64_t>(image.width) * image.height;
+            ++project.SpriteImageVersion;
+            StartRemap(project, previous);
+            return {};
+        }
+
+    // Upload only the regions that changed
+    _lastUploadedPixels = 0;
+    const Texture2D& texture{ project.SpriteTexture.value() };
+    const auto*      pixels{ static_cast<const uint8_t*>(image.data) };
+    const size_t     stride{ static_cast<size_t>(image.width) * BYTES_PER_PIXEL };
+    if (texture.mipmaps > 1)
+        {
+            PrepareMipLevels(project);
+        }
+    for (const Rect& dirty : FindDirtyRects(project.SpriteImage.value(), image, DIRTY_TILE_SIZE))
+        {
+            // Pack the rows of the region, the texture update expects tightly packed pixels
+            const size_t rowSize{ static_cast<size_t>(dirty.w) * BYTES_PER_PIXEL };
+            _uploadScratch.resize(rowSize * dirty.h);
+            for (int32_t y{}; y < dirty.h; ++y)
+                {
+                    std::memcpy(_uploadScratch.data() + y * rowSize, pixels + (dirty.y + y) * stride + static_cast<size_t>(dirty.x) * BYTES_PER_PIXEL, rowSize);
+                }
+            UpdateTextureRec(texture, to::Rectangle_(dirty), _uploadScratch.data());
+            _lastUploadedPixels += static_cast<int64_t>(dirty.w) * dirty.h;
+            if (texture.mipmaps > 1)
+                {
+                    // A texel reading a region changed by a later rect is regenerated again with that rect
+                    _mipRegions.resize(static_cast<size_t>(texture.mipmaps - 1));
+                    UpdateMipLevels(pixels, image.width, image.height, texture.mipmaps, GetMipFilter(), _mipLevels.data(), { dirty.x, dirty.y, dirty.w, dirty.h },
+                                    _mipRegions.data());
+                    UploadMipRegions(texture);
+                }
+        }
+
+    std::optional<Image> previous{ project.SpriteImage };
+    project.SpriteImage = image;
+    ++project.SpriteImageVersion;
+    _mipLevelsImage   = image.data;
+    _mipLevelsVersion = project.SpriteImageVersion;
+    StartRemap(project, previous);
+    return {};
+}
+
+void
+HotReloader::PrepareMipLevels(const Project& project)
+{
+    const Texture2D& texture{ project.SpriteTexture.value() };
+    const Image&     image{ project.SpriteImage.value() };
+    if (_mipLevelsTexture == texture.id && _mipLevelsImage == image.data && _mipLevelsVersion == project.SpriteImageVersion)
+        {
+            return;
+        }
+    // Same levels as the resident ones, the texture was loaded from this image with the same filter
+    PROFILE_SCOPE("HotReloader::PrepareMipLevels");
+    const size_t levelBytes{ static_cast<size_t>(image.width) * image.height * BYTES_PER_PIXEL };
+    _mipLevels.resize(GetMipChainBytes(image.width, image.height, texture.mipmaps) - levelBytes);
+    GenerateMipLevels(static_cast<const uint8_t*>(image.data), image.width, image.height, texture.mipmaps, GetMipFilter(), _mipLevels.data());
+    _mipLevelsTexture = texture.id;
+    _mipLevelsImage   = image.data;
+    _mipLevelsVersion = project.SpriteImageVersion;
+}
+
+void
+HotReloader::UploadMipRegions(const Texture2D& texture)
+{
+    const uint8_t* level{ _mipLevels.data() };
+    int32_t        width{ texture.width };
+    int32_t        height{ texture.height };
+    for (int32_t i{ 1 }; i < texture.mipmaps; ++i)
+        {
+            width  = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            const MipRegion& region{ _mipRegions[static_cast<size_t>(i - 1)] };
+            if (region.Width == 0 || region.Height == 0)
+                {
+                    // The next levels are untouched too
+                    break;
+                }
+            const size_t stride{ static_cast<size_t>(width) * BYTES_PER_PIXEL };
+            const size_t rowSize{ static_cast<size_t>(region.Width) * BYTES_PER_PIXEL };
+            _uploadScratch.resize(rowSize * region.Height);
+            for (int32_t y{}; y < region.Height; ++y)
+                {
+                    std::memcpy(_uploadScratch.data() + y * rowSize, level + (region.Y + y) * stride + static_cast<size_t>(region.X) * BYTES_PER_PIXEL, rowSize);
+                }
+            UpdateTextureLevel(texture.id, i, region.X, region.Y, region.Width, region.Height, _uploadScratch.data());
+            _lastUploadedPixels += static_cast<int64_t>(region.Width) * region.Height;
+            level += stride * height;
+        }
+}
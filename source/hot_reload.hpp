@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "raylib.h"
+
+#include "file_watcher.hpp"
+#include "geometry.hpp"
+#include "mip_pyramid.hpp"
+#include "uv_remap.hpp"
+
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+class MemoryReport;
+class Project;
+
+/**
+ * \brief Finds the regions that differ between two RGBA8 images of the same size.
+ * The images are compared in tiles, adjacent dirty tiles are merged into bigger rects to limit the number of uploads.
+ */
+std::vector<Rect> FindDirtyRects(const Image& previous, const Image& next, int32_t tileSize);
+
+/**
+ * \brief Picks up the sprite and project file changes made by other programs.
+ * Images are decoded in the background and only the changed regions are uploaded to the existing texture, on a texture with mip levels
+ * the texels of every level reading a changed region are generated again and uploaded as well. Project file changes are merged as undoable actions. When the frames moved inside the image the UVs are remapped in the background.
+ */
+class HotReloader final
+{
+  public:
+    HotReloader() = default;
+    ~HotReloader();
+
+    /**
+     * \brief Must be called once per frame from the main thread, it owns the GL context.
+     * \return The error string if a reload failed.
+     */
+    std::optional<std::string> Update(Project& project);
+
+    /**
+     * \brief The number of pixels uploaded by the last image reload.
+     */
+    int64_t GetLastUploadedPixels() const { return _lastUploadedPixels; }
+
+    /**
+     * \brief The summary of the last automatic UV remap, only set when animations moved or could not be matched.
+     */
+    std::optional<std::string> TakeRemapReport();
+
+    void ReportMemory(MemoryReport& report) const;
+
+  private:
+    constexpr static int32_t DIRTY_TILE_SIZE{ 32 };
+
+    FileWatcher          _watcher{};
+    std::string          _watchedSpritePath{};
+    std::future<Image>   _pendingImage{};
+    bool                 _decodeAgain{};
+    int64_t              _lastUploadedPixels{};
+    std::vector<uint8_t> _uploadScratch{};
+
+    /**
+     * \brief CPU copy of the levels after the first one of the resident sprite texture, the changed regions are regenerated from it.
+     * Generated by the first reload of an image, identified by the texture id, the image pixels and their version.
+     */
+    std::vector<uint8_t>   _mipLevels{};
+    std::vector<MipRegion> _mipRegions{};
+    uint32_t               _mipLevelsTexture{};
+    const void*            _mipLevelsImage{};
+    uint64_t               _mipLevelsVersion{};
+
+    std::future<UvRemapReport> _pendingRemap{};
+    std::string                _remapSpritePath{};
+    int64_t                    _remapImageBytes{};
+    std::optional<std::string> _remapReport{};
+
+    void                       StartDecode(const std::string& imagePath);
+    void                       DiscardPendingDecode();
+    void                       StartRemap(Project& project, std::optional<Image> previous);
+    void                       FinishRemap(Project* project);
+    std::optional<std::string> ApplyImage(Project& project, Image image);
+    void                       PrepareMipLevels(const Project& project);
+    void                       UploadMipRegions(const Texture2D& texture);
+};
@@ -0,0 +1,342 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "image_cache.hpp"
+
+#include <sprite_uv/runtime.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+constexpr char ENTRY_MAGIC[4]{ 'S', 'U', 'V', 'C' };
+constexpr auto ENTRY_EXTENSION{ ".rgba" };
+
+/**
+ * \brief In host byte order, the cache is local to the machine.
+ */
+struct EntryHeader
+{
+    char     Magic[4]{};
+    uint32_t Version{};
+    int32_t  Width{};
+    int32_t  Height{};
+    uint64_t SourceSize{};
+    int64_t  SourceTime{};
+    uint64_t SourceHash{};
+    double   DecodeMilliseconds{};
+};
+static_assert(sizeof(EntryHeader) <= ImageCache::PIXELS_OFFSET, "The header must fit before the pixels");
+
+// The header offset of the source time, rewritten when a touched source kept its content
+constexpr size_t SOURCE_TIME_OFFSET{ offsetof(EntryHeader, SourceTime) };
+
+uint64_t
+GetPixelBytes(int32_t width, int32_t height)
+{
+    return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4;
+}
+
+int64_t
+ToTicks(std::filesystem::file_time_type time)
+{
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+double
+GetMillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * \brief The header of the mapped entry if valid and the mapping holds all its pixels.
+ * Read from the mapped bytes, an entry evicted or rewritten by another process can not pair a header with a truncated file.
+ */
+std::optional<EntryHeader>
+ReadHeader(const sprite_uv::MappedFile& file)
+{
+    EntryHeader header{};
+    if (file.Size() < ImageCache::PIXELS_OFFSET)
+        {
+            return {};
+        }
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.Magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0 || header.Version != ImageCache::VERSION || header.Width <= 0 || header.Height <= 0 ||
+        file.Size() - ImageCache::PIXELS_OFFSET < GetPixelBytes(header.Width, header.Height))
+        {
+            return {};
+        }
+    return header;
+}
+}
+
+MappedImage::MappedImage()                                  = default;
+MappedImage::MappedImage(MappedImage&&) noexcept            = default;
+MappedImage& MappedImage::operator=(MappedImage&&) noexcept = default;
+MappedImage::~MappedImage()                                 = default;
+
+std::filesystem::path
+ImageCache::GetDefaultDirectory()
+{
+#if defined(_WIN32)
+    if (const char* localAppData{ std::getenv("LOCALAPPDATA") }; localAppData && *localAppData)
+        {
+            return std::filesystem::path{ localAppData } / "SpriteUVEditor" / "ImageCache";
+        }
+#elif defined(__APPLE__)
+    if (const char* home{ std::getenv("HOME") }; home && *home)
+        {
+            return std::filesystem::path{ home } / "Library" / "Caches" / "SpriteUVEditor";
+        }
+#else
+    if (const char* cacheHome{ std::getenv("XDG_CACHE_HOME") }; cacheHome && *cacheHome)
+        {
+            return std::filesystem::path{ cacheHome } / "sprite_uv_editor" / "images";
+        }
+    if (const char* home{ std::getenv("HOME") }; home && *home)
+        {
+            return std::filesystem::path{ home } / ".cache" / "sprite_uv_editor" / "images";
+        }
+#endif
+    std::error_code errorCode{};
+    return std::filesystem::temp_directory_path(errorCode) / "sprite_uv_image_cache";
+}
+
+ImageCache&
+ImageCache::Shared()
+{
+    static ImageCache cache{ GetDefaultDirectory() };
+    return cache;
+}
+
+ImageCache::ImageCache(std::filesystem::path directory, uint64_t budgetBytes)
+    : _directory{ std::move(directory) }
+    , _budgetBytes{ budgetBytes }
+{
+}
+
+std::filesystem::path
+ImageCache::GetEntryPath(const std::filesystem::path& imagePath) const
+{
+    // The same image opened through another relative path shares its entry
+    const std::string normalizedPath{ std::filesystem::absolute(imagePath).lexically_normal().string() };
+    char              name[17]{};
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(HashBytes(normalizedPath.data(), normalizedPath.size())));
+    return _directory / (std::string{ name } + ENTRY_EXTENSION);
+}
+
+std::optional<MappedImage>
+ImageCache::Find(const std::filesystem::path& imagePath, double* outDecodeMilliseconds)
+{
+    if (_budgetBytes == 0)
+        {
+            return {};
+        }
+
+    const auto start{ std::chrono::steady_clock::now() };
+    const auto countMiss = [this]() {
+        std::lock_guard lock{ _mutex };
+        ++_stats.NumMisses;
+    };
+    const auto  entryPath{ GetEntryPath(imagePath) };
+    const auto  sourceStamp{ GetFileStamp(imagePath) };
+    MappedImage image{};
+    image._file = std::make_unique<sprite_uv::MappedFile>();
+    auto header{ image._file->Open(entryPath.string().c_str()) ? ReadHeader(*image._file) : std::nullopt };
+    if (!header.has_value() || header->SourceSize != sourceStamp.Size)
+        {
+            countMiss();
+            return {};
+        }
+    // A touched or copied source keeps its entry while its content is the same, its new time is recorded to skip the hash next time
+    if (header->SourceTime != ToTicks(sourceStamp.Time))
+        {
+            const uint64_t sourceHash{ header->SourceHash };
+            if (HashFile(imagePath) != sourceHash)
+                {
+                    countMiss();
+                    return {};
+                }
+            // Windows does not share a mapped file for writing, the entry is mapped again after the write and checked to be the same one
+            image._file->Close();
+            const int64_t sourceTime{ ToTicks(sourceStamp.Time) };
+            {
+                std::fstream fileStream{ entryPath, std::ios::binary | std::ios::in | std::ios::out };
+                fileStream.seekp(static_cast<std::streamoff>(SOURCE_TIME_OFFSET));
+                fileStream.write(reinterpret_cast<const char*>(&sourceTime), sizeof(sourceTime));
+            }
+            header = image._file->Open(entryPath.string().c_str()) ? ReadHeader(*image._file) : std::nullopt;
+            if (!header.has_value() || header->SourceSize != sourceStamp.Size || header->SourceHash != sourceHash)
+                {
+                    countMiss();
+                    return {};
+                }
+        }
+
+    image._width  = header->Width;
+    image._height = header->Height;
+    image._pixels = static_cast<const uint8_t*>(image._file->Data()) + PIXELS_OFFSET;
+
+    // The time of the entry orders the eviction
+    std::error_code errorCode{};
+    std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), errorCode);
+    if (outDecodeMilliseconds)
+        {
+            *outDecodeMilliseconds = header->DecodeMilliseconds;
+        }
+
+    std::lock_guard lock{ _mutex };
+    ++_stats.NumHits;
+    _stats.HitMilliseconds += GetMillisecondsSince(start);
+    return image;
+}
+
+std::optional<std::string>
+ImageCache::Store(const std::filesystem::path& imagePath, FileStamp sourceStamp, const uint8_t* rgba, int32_t width, int32_t height, double decodeMilliseconds)
+{
+    if (_budgetBytes == 0)
+        {
+            return {};
+        }
+    {
+        std::lock_guard lock{ _mutex };
+        _stats.MissMilliseconds += decodeMilliseconds;
+    }
+    // An image over the whole budget would only evict everything else
+    const uint64_t pixelBytes{ GetPixelBytes(width, height) };
+    if (!rgba || width <= 0 || height <= 0 || PIXELS_OFFSET + pixelBytes > _budgetBytes)
+        {
+            return {};
+        }
+
+    // Hashed after the decode, the stamp tells if the source changed in between
+    const auto sourceHash{ HashFile(imagePath) };
+    if (!sourceHash.has_value() || GetFileStamp(imagePath) != sourceStamp)
+        {
+            return {};
+        }
+
+    std::error_code errorCode{};
+    std::filesystem::create_directories(_directory, errorCode);
+    if (errorCode)
+        {
+            return "Failed to create the image cache " + _directory.string();
+        }
+
+    EntryHeader header{};
+    std::memcpy(header.Magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+    header.Version            = VERSION;
+    header.Width              = width;
+    header.Height             = height;
+    header.SourceSize         = sourceStamp.Size;
+    header.SourceTime         = ToTicks(sourceStamp.Time);
+    header.SourceHash         = sourceHash.value();
+    header.DecodeMilliseconds = decodeMilliseconds;
+    char headerBytes[PIXELS_OFFSET]{};
+    std::memcpy(headerBytes, &header, sizeof(header));
+
+    // Written next to the entry then renamed, a concurrent reader never maps a partial entry
+    const auto entryPath{ GetEntryPath(imagePath) };
+    const auto temporaryPath{ std::filesystem::path{ entryPath }.concat(".tmp" + std::to_string(_numTemporaries++)) };
+    {
+        std::ofstream fileStream{ temporaryPath, std::ios::binary | std::ios::trunc };
+        fileStream.write(headerBytes, sizeof(headerBytes));
+        fileStream.write(reinterpret_cast<const char*>(rgba), static_cast<std::streamsize>(pixelBytes));
+        if (!fileStream)
+            {
+                fileStream.close();
+                std::filesystem::remove(temporaryPath, errorCode);
+                return "Failed to write " + temporaryPath.string();
+            }
+    }
+    // Fails while another process maps the entry on Windows, that one is still valid
+    std::filesystem::rename(temporaryPath, entryPath, errorCode);
+    if (errorCode)
+        {
+            std::filesystem::remove(temporaryPath, errorCode);
+        }
+
+    Evict();
+    return {};
+}
+
+void
+ImageCache::Evict()
+{
+    struct Entry
+    {
+        std::filesystem::path           Path{};
+        std::filesystem::file_time_type Time{};
+        uint64_t                        Size{};
+    };
+
+    std::lock_guard    lock{ _mutex };
+    std::error_code    errorCode{};
+    std::vector<Entry> entries{};
+    uint64_t           totalBytes{};
+    for (std::filesystem::directory_iterator it{ _directory, errorCode }, end{}; !errorCode && it != end; it.increment(errorCode))
+        {
+            if (it->path().extension() != ENTRY_EXTENSION)
+                {
+                    continue;
+                }
+            std::error_code entryErrorCode{};
+            Entry           entry{ it->path(), it->last_write_time(entryErrorCode), it->file_size(entryErrorCode) };
+            if (entryErrorCode)
+                {
+                    continue;
+                }
+            totalBytes += entry.Size;
+            entries.push_back(std::move(entry));
+        }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.Time < rhs.Time; });
+    for (const auto& entry : entries)
+        {
+            if (totalBytes <= _budgetBytes)
+                {
+                    break;
+                }
+            // A mapped entry can not be deleted on Windows, it goes next time
+            if (std::filesystem::remove(entry.Path, errorCode))
+                {
+                    totalBytes -= entry.Size;
+                }
+        }
+}
+
+ImageCache::Stats
+ImageCache::GetStats() const
+{
+    std::lock_guard lock{ _mutex };
+    return _stats;
+}
@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "content_hash.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace sprite_uv
+{
+class MappedFile;
+}
+
+// Kept free of raylib, the platform headers of the file mapping clash with it.
+
+/**
+ * \brief RGBA8 pixels mapped from an image cache entry, valid while the object lives.
+ */
+class MappedImage final
+{
+  public:
+    MappedImage();
+    MappedImage(MappedImage&&) noexcept;
+    MappedImage& operator=(MappedImage&&) noexcept;
+    ~MappedImage();
+
+    int32_t        GetWidth() const { return _width; }
+    int32_t        GetHeight() const { return _height; }
+    const uint8_t* GetPixels() const { return _pixels; }
+
+  private:
+    friend class ImageCache;
+
+    std::unique_ptr<sprite_uv::MappedFile> _file{};
+    int32_t                                _width{};
+    int32_t                                _height{};
+    const uint8_t*                         _pixels{};
+};
+
+/**
+ * \brief On-disk cache of decoded images, so reopening a large sheet maps its pixels instead of decoding the file again.
+ * An entry is a header followed by the raw RGBA8 pixels at an aligned offset, ready for the upload. It is named after the source path and valid
+ * while the source keeps its time and size, or its content hash. The cache is bounded, the least recently used entries are deleted first.
+ * Thread safe, the pages are decoded on worker threads.
+ */
+class ImageCache final
+{
+  public:
+    /**
+     * \brief Bumped whenever the entry layout changes, the entries of another version are decoded again.
+     */
+    constexpr static uint32_t VERSION{ 1 };
+    constexpr static uint64_t DEFAULT_BUDGET_BYTES{ 2ull * 1024 * 1024 * 1024 };
+    /**
+     * \brief Offset of the pixels in an entry, a cache line.
+     */
+    constexpr static size_t   PIXELS_OFFSET{ 64 };
+
+    struct Stats
+    {
+        size_t NumHits{};
+        size_t NumMisses{};
+        double HitMilliseconds{};
+        /**
+         * \brief The decode times of the missed images.
+         */
+        double MissMilliseconds{};
+    };
+
+    /**
+     * \brief The user cache directory of the platform.
+     */
+    static std::filesystem::path GetDefaultDirectory();
+
+    /**
+     * \brief The process wide cache in the default directory.
+     */
+    static ImageCache& Shared();
+
+    explicit ImageCache(std::filesystem::path directory, uint64_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    ImageCache(const ImageCache&)            = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    /**
+     * \brief Not thread safe, to be called before the first image is loaded. A zero budget disables the cache.
+     */
+    void SetDirectory(std::filesystem::path directory) { _directory = std::move(directory); }
+    void SetBudgetBytes(uint64_t budgetBytes) { _budgetBytes = budgetBytes; }
+    const std::filesystem::path& GetDirectory() const { return _directory; }
+
+    /**
+     * \brief The decoded image if cached and up to date, the entry becomes the most recently used.
+     * \param outDecodeMilliseconds The time the image took to decode when it was stored.
+     */
+    std::optional<MappedImage> Find(const std::filesystem::path& imagePath, double* outDecodeMilliseconds = nullptr);
+
+    /**
+     * \brief Stores the decoded image then deletes the least recently used entries over budget.
+     * \param sourceStamp Taken before decoding, nothing is stored if the source changed since.
+     * \return The error string if the entry can not be written.
+     */
+    std::optional<std::string> Store(const std::filesystem::path& imagePath, FileStamp sourceStamp, const uint8_t* rgba, int32_t width, int32_t height, double decodeMilliseconds);
+
+    Stats GetStats() const;
+
+  private:
+    std::filesystem::path _directory{};
+    std::atomic<uint64_t> _budgetBytes{};
+    mutable std::mutex    _mutex{};
+    Stats                 _stats{};
+    std::atomic<uint64_t> _numTemporaries{};
+
+    std::filesystem::path GetEntryPath(const std::filesystem::path& imagePath) const;
+    void                  Evict();
+};
@@ -0,0 +1,754 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "input.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+namespace input
+{
+namespace
+{
+constexpr char     MAGIC[4]{ 'S', 'U', 'V', 'I' };
+constexpr uint32_t VERSION{ 1 };
+// raylib MAX_KEYBOARD_KEYS and MAX_MOUSE_BUTTONS
+constexpr int32_t  MAX_KEYS{ 512 };
+constexpr int32_t  MAX_BUTTONS{ 7 };
+constexpr uint32_t CANCELLED_DIALOG{ 0xFFFFFFFF };
+
+/**
+ * \brief The sections present in a recorded frame, an idle frame is only the flags and the time.
+ * Absent mouse, wheel, buttons and render size are unchanged from the previous frame, absent lists are empty.
+ */
+enum EFrameFlags : uint16_t
+{
+    MOUSE       = 1 << 0,
+    WHEEL       = 1 << 1,
+    KEYS        = 1 << 2,
+    BUTTONS     = 1 << 3,
+    REPEATS     = 1 << 4,
+    KEY_QUEUE   = 1 << 5,
+    CHAR_QUEUE  = 1 << 6,
+    DIALOGS     = 1 << 7,
+    RENDER_SIZE = 1 << 8,
+};
+
+struct FrameState
+{
+    double                                  Time{};
+    Vector2                                 MousePosition{};
+    Vector2                                 MouseDelta{};
+    Vector2                                 Wheel{};
+    std::bitset<MAX_KEYS>                   Keys{};
+    std::bitset<MAX_KEYS>                   PreviousKeys{};
+    std::bitset<MAX_KEYS>                   RepeatKeys{};
+    uint8_t                                 Buttons{};
+    uint8_t                                 PreviousButtons{};
+    std::vector<int32_t>                    KeyQueue{};
+    std::vector<int32_t>                    CharQueue{};
+    size_t                                  KeyQueueIndex{};
+    size_t                                  CharQueueIndex{};
+    std::vector<std::optional<std::string>> Dialogs{};
+    size_t                                  DialogIndex{};
+    int32_t                                 RenderWidth{};
+    int32_t                                 RenderHeight{};
+
+    /**
+     * \brief Keeps the down states as the previous ones, the per frame lists are cleared.
+     */
+    void NextFrame()
+    {
+        PreviousKeys    = Keys;
+        PreviousButtons = Buttons;
+        RepeatKeys.reset();
+        KeyQueue.clear();
+        CharQueue.clear();
+        Dialogs.clear();
+        KeyQueueIndex  = 0;
+        CharQueueIndex = 0;
+        DialogIndex    = 0;
+    }
+};
+
+EInputMode mode{ EInputMode::LIVE };
+FrameState state{};
+
+// Recording
+std::ofstream        recordFile{};
+std::vector<uint8_t> recordBuffer{};
+FrameState           lastWritten{};
+bool                 hasCapturedFrame{};
+
+// The first frame is read when starting so the window can be created with the recorded size
+bool framePrimed{};
+
+// Replay
+std::vector<uint8_t>                  replayData{};
+size_t                                replayOffset{};
+std::vector<double>                   replayFrameTimesMs{};
+std::chrono::steady_clock::time_point replayFrameStart{};
+bool                                  replayStarted{};
+
+template<typename T>
+void
+Write(std::vector<uint8_t>& out, const T& value)
+{
+    const auto* bytes{ reinterpret_cast<const uint8_t*>(&value) };
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool
+Read(T& value)
+{
+    if (replayOffset + sizeof(T) > replayData.size())
+        {
+            return false;
+        }
+    std::memcpy(&value, replayData.data() + replayOffset, sizeof(T));
+    replayOffset += sizeof(T);
+    return true;
+}
+
+bool
+operator!=(const Vector2& a, const Vector2& b)
+{
+    return a.x != b.x || a.y != b.y;
+}
+
+void
+CaptureLiveFrame()
+{
+    state.NextFrame();
+    state.Time          = ::GetTime();
+    state.MousePosition = ::GetMousePosition();
+    state.MouseDelta    = ::GetMouseDelta();
+    state.Wheel         = ::GetMouseWheelMoveV();
+    for (int32_t key{ 1 }; key < MAX_KEYS; ++key)
+        {
+            state.Keys[key]       = ::IsKeyDown(key);
+            state.RepeatKeys[key] = ::IsKeyPressedRepeat(key);
+        }
+    state.Buttons = 0;
+    for (int32_t button{}; button < MAX_BUTTONS; ++button)
+        {
+            state.Buttons |= ::IsMouseButtonDown(button) ? 1 << button : 0;
+        }
+    // The queues are drained here, the editor reads them from the captured state
+    for (int32_t key{ ::GetKeyPressed() }; key != 0; key = ::GetKeyPressed())
+        {
+            state.KeyQueue.push_back(key);
+        }
+    for (int32_t codepoint{ ::GetCharPressed() }; codepoint != 0; codepoint = ::GetCharPressed())
+        {
+            state.CharQueue.push_back(codepoint);
+        }
+    state.RenderWidth  = ::GetRenderWidth();
+    state.RenderHeight = ::GetRenderHeight();
+}
+
+void
+WriteKeyList(const std::bitset<MAX_KEYS>& keys)
+{
+    Write(recordBuffer, static_cast<uint16_t>(keys.count()));
+    for (uint16_t key{}; key < MAX_KEYS; ++key)
+        {
+            if (keys[key])
+                {
+                    Write(recordBuffer, key);
+                }
+        }
+}
+
+void
+WriteQueue(const std::vector<int32_t>& queue)
+{
+    Write(recordBuffer, static_cast<uint16_t>(queue.size()));
+    for (const int32_t value : queue)
+        {
+            Write(recordBuffer, value);
+        }
+}
+
+/**
+ * \brief Appends the captured frame, the dialogs opened during the frame are included thus it is written at the start of the next one.
+ */
+void
+WriteCapturedFrame()
+{
+    if (!hasCapturedFrame)
+        {
+            return;
+        }
+    hasCapturedFrame = false;
+
+    uint16_t flags{};
+    flags |= state.MousePosition != lastWritten.MousePosition || state.MouseDelta != lastWritten.MouseDelta ? MOUSE : 0;
+    flags |= state.Wheel != lastWritten.Wheel ? WHEEL : 0;
+    flags |= state.Keys != lastWritten.Keys ? KEYS : 0;
+    flags |= state.Buttons != lastWritten.Buttons ? BUTTONS : 0;
+    flags |= state.RepeatKeys.any() ? REPEATS : 0;
+    flags |= !state.KeyQueue.empty() ? KEY_QUEUE : 0;
+    flags |= !state.CharQueue.empty() ? CHAR_QUEUE : 0;
+    flags |= !state.Dialogs.empty() ? DIALOGS : 0;
+    flags |= state.RenderWidth != lastWritten.RenderWidth || state.RenderHeight != lastWritten.RenderHeight ? RENDER_SIZE : 0;
+
+    recordBuffer.clear();
+    Write(recordBuffer, flags);
+    Write(recordBuffer, state.Time);
+    if (flags & MOUSE)
+        {
+            Write(recordBuffer, state.MousePosition);
+            Write(recordBuffer, state.MouseDelta);
+        }
+    if (flags & WHEEL)
+        {
+            Write(recordBuffer, state.Wheel);
+        }
+    if (flags & KEYS)
+        {
+            // Only the keys that went up or down
+            WriteKeyList(state.Keys ^ lastWritten.Keys);
+        }
+    if (flags & BUTTONS)
+        {
+            Write(recordBuffer, state.Buttons);
+        }
+    if (flags & REPEATS)
+        {
+            WriteKeyList(state.RepeatKeys);
+        }
+    if (flags & KEY_QUEUE)
+        {
+            WriteQueue(state.KeyQueue);
+        }
+    if (flags & CHAR_QUEUE)
+        {
+            WriteQueue(state.CharQueue);
+        }
+    if (flags & DIALOGS)
+        {
+            Write(recordBuffer, static_cast<uint16_t>(state.Dialogs.size()));
+            for (const auto& dialog : state.Dialogs)
+                {
+                    Write(recordBuffer, dialog.has_value() ? static_cast<uint32_t>(dialog->size()) : CANCELLED_DIALOG);
+                    if (dialog.has_value())
+                        {
+                            recordBuffer.insert(recordBuffer.end(), dialog->begin(), dialog->end());
+                        }
+                }
+        }
+    if (flags & RENDER_SIZE)
+        {
+            Write(recordBuffer, state.RenderWidth);
+            Write(recordBuffer, state.RenderHeight);
+        }
+    recordFile.write(reinterpret_cast<const char*>(recordBuffer.data()), static_cast<std::streamsize>(recordBuffer.size()));
+
+    lastWritten.MousePosition = state.MousePosition;
+    lastWritten.MouseDelta    = state.MouseDelta;
+    lastWritten.Wheel         = state.Wheel;
+    lastWritten.Keys          = state.Keys;
+    lastWritten.Buttons       = state.Buttons;
+    lastWritten.RenderWidth   = state.RenderWidth;
+    lastWritten.RenderHeight  = state.RenderHeight;
+}
+
+bool
+ReadKeyList(std::bitset<MAX_KEYS>& keys, bool toggle)
+{
+    uint16_t count{};
+    if (!Read(count))
+        {
+            return false;
+        }
+    for (uint16_t i{}; i < count; ++i)
+        {
+            uint16_t key{};
+            if (!Read(key) || key >= MAX_KEYS)
+                {
+                    return false;
+                }
+            keys[key] = toggle ? !keys[key] : true;
+        }
+    return true;
+}
+
+bool
+ReadQueue(std::vector<int32_t>& queue)
+{
+    uint16_t count{};
+    if (!Read(count))
+        {
+            return false;
+        }
+    queue.resize(count);
+    for (auto& value : queue)
+        {
+            if (!Read(value))
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+/**
+ * \brief Applies the next recorded frame on top of the current state.
+ * \return False at the end of the recording or on a truncated frame.
+ */
+bool
+ReadReplayedFrame()
+{
+    state.NextFrame();
+
+    uint16_t flags{};
+    if (!Read(flags) || !Read(state.Time))
+        {
+            return false;
+        }
+    if ((flags & MOUSE) && (!Read(state.MousePosition) || !Read(state.MouseDelta)))
+        {
+            return false;
+        }
+    if ((flags & WHEEL) && !Read(state.Wheel))
+        {
+            return false;
+        }
+    if ((flags & KEYS) && !ReadKeyList(state.Keys, true))
+        {
+            return false;
+        }
+    if ((flags & BUTTONS) && !Read(state.Buttons))
+        {
+            return false;
+        }
+    if ((flags & REPEATS) && !ReadKeyList(state.RepeatKeys, false))
+        {
+            return false;
+        }
+    if ((flags & KEY_QUEUE) && !ReadQueue(state.KeyQueue))
+        {
+            return false;
+        }
+    if ((flags & CHAR_QUEUE) && !ReadQueue(state.CharQueue))
+        {
+            return false;
+        }
+    if (flags & DIALOGS)
+        {
+            uint16_t count{};
+            if (!Read(count))
+                {
+                    return false;
+                }
+            for (uint16_t i{}; i < count; ++i)
+                {
+                    uint32_t length{};
+                    if (!Read(length))
+                        {
+                            return false;
+                        }
+                    if (length == CANCELLED_DIALOG)
+                        {
+                            state.Dialogs.emplace_back();
+                            continue;
+                        }
+                    if (replayOffset + length > replayData.size())
+                        {
+                            return false;
+                        }
+                    state.Dialogs.emplace_back(std::string{ reinterpret_cast<const char*>(replayData.data() + replayOffset), length });
+                    replayOffset += length;
+                }
+        }
+    if ((flags & RENDER_SIZE) && (!Read(state.RenderWidth) || !Read(state.RenderHeight)))
+        {
+            return false;
+        }
+    return true;
+}
+
+bool
+IsLive()
+{
+    return mode == EInputMode::LIVE;
+}
+}
+
+EInputMode
+GetMode()
+{
+    return mode;
+}
+
+std::optional<std::string>
+StartRecording(const std::string& path)
+{
+    recordFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!recordFile)
+        {
+            return "Failed to create the recording " + path + "!";
+        }
+    recordFile.write(MAGIC, sizeof(MAGIC));
+    recordFile.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+
+    mode        = EInputMode::RECORDING;
+    state       = {};
+    lastWritten = {};
+    CaptureLiveFrame();
+    hasCapturedFrame = true;
+    framePrimed      = true;
+    return {};
+}
+
+void
+StopRecording()
+{
+    if (mode != EInputMode::RECORDING)
+        {
+            return;
+        }
+    WriteCapturedFrame();
+    recordFile.close();
+    mode = EInputMode::LIVE;
+}
+
+std::optional<std::string>
+StartReplay(const std::string& path)
+{
+    std::ifstream fileStream{ path, std::ios::binary };
+    if (!fileStream)
+        {
+            return "Failed to open the recording " + path + "!";
+        }
+    replayData.assign(std::istreambuf_iterator<char>{ fileStream }, std::istreambuf_iterator<char>{});
+
+    uint32_t version{};
+    if (replayData.size() < sizeof(MAGIC) + sizeof(version) || std::memcmp(replayData.data(), MAGIC, sizeof(MAGIC)) != 0)
+        {
+            return path + " is not an input recording!";
+        }
+    std::memcpy(&version, replayData.data() + sizeof(MAGIC), sizeof(version));
+    if (version != VERSION)
+        {
+            return path + " was recorded by another version!";
+        }
+
+    mode          = EInputMode::REPLAYING;
+    state         = {};
+    replayOffset  = sizeof(MAGIC) + sizeof(version);
+    replayStarted = false;
+    replayFrameTimesMs.clear();
+    if (!ReadReplayedFrame())
+        {
+            mode = EInputMode::LIVE;
+            return path + " has no frame!";
+        }
+    framePrimed = true;
+    return {};
+}
+
+bool
+BeginFrame()
+{
+    switch (mode)
+        {
+            case EInputMode::RECORDING:
+                if (std::exchange(framePrimed, false))
+                    {
+                        return true;
+                    }
+                WriteCapturedFrame();
+                CaptureLiveFrame();
+                hasCapturedFrame = true;
+                return true;
+            case EInputMode::REPLAYING:
+                {
+                    const auto now{ std::chrono::steady_clock::now() };
+                    if (replayStarted)
+                        {
+                            replayFrameTimesMs.push_back(std::chrono::duration<double, std::milli>(now - replayFrameStart).count());
+                        }
+                    replayStarted    = true;
+                    replayFrameStart = now;
+                    return std::exchange(framePrimed, false) || ReadReplayedFrame();
+                }
+            case EInputMode::LIVE:
+            default:
+                return true;
+        }
+}
+
+void
+RecordDialogResult(const char* path)
+{
+    if (mode == EInputMode::RECORDING)
+        {
+            state.Dialogs.emplace_back(path ? std::optional<std::string>{ path } : std::nullopt);
+        }
+}
+
+bool
+TakeReplayedDialogResult(std::string& outPath)
+{
+    // A dialog the recording did not see is cancelled
+    if (state.DialogIndex >= state.Dialogs.size())
+        {
+            return false;
+        }
+    const auto& dialog{ state.Dialogs[state.DialogIndex++] };
+    if (!dialog.has_value())
+        {
+            return false;
+        }
+    outPath = dialog.value();
+    return true;
+}
+
+#pragma region Input state
+Vector2
+GetMousePosition()
+{
+    return IsLive() ? ::GetMousePosition() : state.MousePosition;
+}
+
+Vector2
+GetMouseDelta()
+{
+    return IsLive() ? ::GetMouseDelta() : state.MouseDelta;
+}
+
+float
+GetMouseWheelMove()
+{
+    if (IsLive())
+        {
+            return ::GetMouseWheelMove();
+        }
+    // Same as raylib, the dominant axis
+    return std::fabs(state.Wheel.x) > std::fabs(state.Wheel.y) ? state.Wheel.x : state.Wheel.y;
+}
+
+Vector2
+GetMouseWheelMoveV()
+{
+    return IsLive() ? ::GetMouseWheelMoveV() : state.Wheel;
+}
+
+bool
+IsMouseButtonDown(int button)
+{
+    if (IsLive())
+        {
+            return ::IsMouseButtonDown(button);
+        }
+    return button >= 0 && button < MAX_BUTTONS && (state.Buttons & (1 << button));
+}
+
+bool
+IsMouseButtonPressed(int button)
+{
+    if (IsLive())
+        {
+            return ::IsMouseButtonPressed(button);
+        }
+    return IsMouseButtonDown(button) && !(state.PreviousButtons & (1 << button));
+}
+
+bool
+IsMouseButtonReleased(int button)
+{
+    if (IsLive())
+        {
+            return ::IsMouseButtonReleased(button);
+        }
+    return button >= 0 && button < MAX_BUTTONS && !IsMouseButtonDown(button) && (state.PreviousButtons & (1 << button));
+}
+
+bool
+IsMouseButtonUp(int button)
+{
+    return IsLive() ? ::IsMouseButtonUp(button) : !IsMouseButtonDown(button);
+}
+
+bool
+IsKeyDown(int key)
+{
+    if (IsLive())
+        {
+            return ::IsKeyDown(key);
+        }
+    return key > 0 && key < MAX_KEYS && state.Keys[key];
+}
+
+bool
+IsKeyPressed(int key)
+{
+    if (IsLive())
+        {
+            return ::IsKeyPressed(key);
+        }
+    return IsKeyDown(key) && !state.PreviousKeys[key];
+}
+
+bool
+IsKeyPressedRepeat(int key)
+{
+    if (IsLive())
+        {
+            return ::IsKeyPressedRepeat(key);
+        }
+    return key > 0 && key < MAX_KEYS && state.RepeatKeys[key];
+}
+
+bool
+IsKeyReleased(int key)
+{
+    if (IsLive())
+        {
+            return ::IsKeyReleased(key);
+        }
+    return key > 0 && key < MAX_KEYS && !state.Keys[key] && state.PreviousKeys[key];
+}
+
+bool
+IsKeyUp(int key)
+{
+    return IsLive() ? ::IsKeyUp(key) : !IsKeyDown(key);
+}
+
+int
+GetKeyPressed()
+{
+    if (IsLive())
+        {
+            return ::GetKeyPressed();
+        }
+    return state.KeyQueueIndex < state.KeyQueue.size() ? state.KeyQueue[state.KeyQueueIndex++] : 0;
+}
+
+int
+GetCharPressed()
+{
+    if (IsLive())
+        {
+            return ::GetCharPressed();
+        }
+    return state.CharQueueIndex < state.CharQueue.size() ? state.CharQueue[state.CharQueueIndex++] : 0;
+}
+
+double
+GetTime()
+{
+    return IsLive() ? ::GetTime() : state.Time;
+}
+
+int
+GetRenderWidth()
+{
+    return IsLive() ? ::GetRenderWidth() : state.RenderWidth;
+}
+
+int
+GetRenderHeight()
+{
+    return IsLive() ? ::GetRenderHeight() : state.RenderHeight;
+}
+#pragma endregion
+
+#pragma region Replay timings
+const std::vector<double>&
+GetReplayFrameTimesMs()
+{
+    return replayFrameTimesMs;
+}
+
+std::string
+FrameTimeSummary::ToString() const
+{
+    std::ostringstream out{};
+    out << std::fixed << std::setprecision(3) << "Frames " << Frames << "  total " << TotalMs << " ms  mean " << MeanMs << "  p50 " << P50Ms << "  p95 " << P95Ms << "  p99 " << P99Ms
+        << "  max " << MaxMs << " ms";
+    return out.str();
+}
+
+FrameTimeSummary
+SummarizeFrameTimes(std::vector<double> frameTimesMs)
+{
+    FrameTimeSummary summary{};
+    if (frameTimesMs.empty())
+        {
+            return summary;
+        }
+    std::sort(frameTimesMs.begin(), frameTimesMs.end());
+
+    // Nearest rank percentiles
+    const auto percentile = [&frameTimesMs](double p) {
+        const size_t rank{ static_cast<size_t>(std::ceil(p * frameTimesMs.size())) };
+        return frameTimesMs[std::clamp<size_t>(rank, 1, frameTimesMs.size()) - 1];
+    };
+    summary.Frames = frameTimesMs.size();
+    for (const double ms : frameTimesMs)
+        {
+            summary.TotalMs += ms;
+        }
+    summary.MeanMs = summary.TotalMs / summary.Frames;
+    summary.P50Ms  = percentile(.5);
+    summary.P95Ms  = percentile(.95);
+    summary.P99Ms  = percentile(.99);
+    summary.MaxMs  = frameTimesMs.back();
+    return summary;
+}
+
+std::optional<std::string>
+WriteFrameTimesCsv(const std::string& path, const std::vector<double>& frameTimesMs)
+{
+    std::ofstream fileStream{ path };
+    if (!fileStream)
+        {
+            return "Failed to open " + path + " for writing!";
+        }
+    fileStream << "frame,ms\n" << std::fixed << std::setprecision(4);
+    for (size_t i{}; i < frameTimesMs.size(); ++i)
+        {
+            fileStream << i << "," << frameTimesMs[i] << "\n";
+        }
+    if (!fileStream)
+        {
+            return "Failed to write " + path + "!";
+        }
+    return {};
+}
+#pragma endregion
+
+}
@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+// Every input the editor reads goes through here so sessions can be recorded and replayed.
+// Live: forwards to raylib. Recording: captures the raylib state once per frame and appends it to a file.
+// Replaying: feeds the recorded frames back without throttling, GetTime returns the recorded time.
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace input
+{
+
+enum class EInputMode : uint8_t
+{
+    LIVE,
+    RECORDING,
+    REPLAYING,
+};
+
+EInputMode GetMode();
+inline bool
+IsReplaying()
+{
+    return GetMode() == EInputMode::REPLAYING;
+}
+
+/**
+ * \brief Records the input of every frame until StopRecording.
+ * \return The error string if the file can not be created.
+ */
+std::optional<std::string> StartRecording(const std::string& path);
+/**
+ * \brief Flushes and closes the recording.
+ */
+void StopRecording();
+
+/**
+ * \brief Loads the whole recording, the frames are fed back from the next BeginFrame.
+ * The first frame is already readable thus the window can be created with the recorded render size.
+ * \return The error string if the file is not a recording.
+ */
+std::optional<std::string> StartReplay(const std::string& path);
+
+/**
+ * \brief Must be called once at the start of every frame, before any input read.
+ * \return False once every replayed frame has been consumed.
+ */
+bool BeginFrame();
+
+/**
+ * \brief File dialogs are not replayable, their result is recorded with the frame instead.
+ */
+void RecordDialogResult(const char* path);
+/**
+ * \brief The dialog result recorded during the replayed frame.
+ * \return False if the dialog was cancelled.
+ */
+bool TakeReplayedDialogResult(std::string& outPath);
+
+#pragma region Input state
+Vector2 GetMousePosition();
+Vector2 GetMouseDelta();
+float   GetMouseWheelMove();
+Vector2 GetMouseWheelMoveV();
+bool    IsMouseButtonDown(int button);
+bool    IsMouseButtonPressed(int button);
+bool    IsMouseButtonReleased(int button);
+bool    IsMouseButtonUp(int button);
+bool    IsKeyDown(int key);
+bool    IsKeyPressed(int key);
+bool    IsKeyPressedRepeat(int key);
+bool    IsKeyReleased(int key);
+bool    IsKeyUp(int key);
+/**
+ * \brief Queued key and char presses, zero once the queue of the frame is empty.
+ */
+int     GetKeyPressed();
+int     GetCharPressed();
+double  GetTime();
+/**
+ * \brief Recorded as well, the layout depends on it.
+ */
+int     GetRenderWidth();
+int     GetRenderHeight();
+#pragma endregion
+
+#pragma region Replay timings
+/**
+ * \brief Wall clock duration of every replayed frame in milliseconds.
+ */
+const std::vector<double>& GetReplayFrameTimesMs();
+
+struct FrameTimeSummary
+{
+    size_t Frames{};
+    double TotalMs{};
+    double MeanMs{};
+    double P50Ms{};
+    double P95Ms{};
+    double P99Ms{};
+    double MaxMs{};
+
+    std::string ToString() const;
+};
+
+FrameTimeSummary SummarizeFrameTimes(std::vector<double> frameTimesMs);
+/**
+ * \brief One line per frame: index, milliseconds.
+ * \return The error string if failed.
+ */
+std::optional<std::string> WriteFrameTimesCsv(const std::string& path, const std::vector<double>& frameTimesMs);
+#pragma endregion
+
+}
@@ -0,0 +1,196 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "memory_stats.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+void
+MemoryReport::Add(std::string category, int64_t bytes, int64_t count, std::string detail)
+{
+    _entries.push_back({ std::move(category), std::move(detail), bytes, count });
+}
+
+void
+MemoryReport::AddTexture(std::string category, const Texture2D& texture, std::string detail)
+{
+    if (texture.id == 0)
+        {
+            return;
+        }
+    std::string description{ std::string{ GetPixelFormatName(texture.format) } + " " + std::to_string(texture.width) + "x" + std::to_string(texture.height) };
+    if (texture.mipmaps > 1)
+        {
+            description += " " + std::to_string(texture.mipmaps) + " mips";
+        }
+    if (!detail.empty())
+        {
+            description += " " + detail;
+        }
+    Add(std::move(category), GetTextureBytes(texture), 1, std::move(description));
+}
+
+void
+MemoryReport::AddImage(std::string category, const Image& image, std::string detail)
+{
+    if (!image.data)
+        {
+            return;
+        }
+    std::string description{ std::string{ GetPixelFormatName(image.format) } + " " + std::to_string(image.width) + "x" + std::to_string(image.height) };
+    if (!detail.empty())
+        {
+            description += " " + detail;
+        }
+    Add(std::move(category), GetPixelDataSize(image.width, image.height, image.format), 1, std::move(description));
+}
+
+int64_t
+MemoryReport::GetTotalBytes(std::string_view prefix) const
+{
+    int64_t total{};
+    for (const auto& entry : _entries)
+        {
+            if (std::string_view{ entry.Category }.substr(0, prefix.size()) == prefix)
+                {
+                    total += entry.Bytes;
+                }
+        }
+    return total;
+}
+
+nlohmann::ordered_json
+MemoryReport::ToJson(double timeSeconds) const
+{
+    nlohmann::ordered_json j{};
+    j["timeSeconds"] = timeSeconds;
+    j["totalBytes"]  = GetTotalBytes();
+    j["entries"]     = nlohmann::ordered_json::array();
+    for (const auto& entry : _entries)
+        {
+            nlohmann::ordered_json entryJson{};
+            entryJson["category"] = entry.Category;
+            entryJson["bytes"]    = entry.Bytes;
+            entryJson["count"]    = entry.Count;
+            if (!entry.Detail.empty())
+                {
+                    entryJson["detail"] = entry.Detail;
+                }
+            j["entries"].push_back(std::move(entryJson));
+        }
+    return j;
+}
+
+int64_t
+GetTextureBytes(const Texture2D& texture)
+{
+    int64_t bytes{};
+    for (int32_t mip{}; mip < std::max(1, texture.mipmaps); ++mip)
+        {
+            bytes += GetPixelDataSize(std::max(1, texture.width >> mip), std::max(1, texture.height >> mip), texture.format);
+        }
+    return bytes;
+}
+
+const char*
+GetPixelFormatName(int32_t format)
+{
+    switch (format)
+        {
+            case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return "GRAYSCALE";
+            case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: return "GRAY_ALPHA";
+            case PIXELFORMAT_UNCOMPRESSED_R5G6B5: return "R5G6B5";
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return "R8G8B8";
+            case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: return "R5G5B5A1";
+            case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: return "R4G4B4A4";
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: return "R8G8B8A8";
+            case PIXELFORMAT_COMPRESSED_DXT1_RGB: return "DXT1_RGB";
+            case PIXELFORMAT_COMPRESSED_DXT1_RGBA: return "DXT1_RGBA";
+            case PIXELFORMAT_COMPRESSED_DXT3_RGBA: return "DXT3_RGBA";
+            case PIXELFORMAT_COMPRESSED_DXT5_RGBA: return "DXT5_RGBA";
+            default: return "OTHER";
+        }
+}
+
+int64_t
+GetStringHeapBytes(const std::string& str)
+{
+    static const size_t SMALL_STRING_CAPACITY{ std::string{}.capacity() };
+    return str.capacity() > SMALL_STRING_CAPACITY ? static_cast<int64_t>(str.capacity()) + 1 : 0;
+}
+
+int64_t
+EstimateJsonBytes(const nlohmann::ordered_json& j)
+{
+    using json = nlohmann::ordered_json;
+
+    int64_t bytes{};
+    switch (j.type())
+        {
+            case json::value_t::object:
+                {
+                    // ordered_map is a vector of key/value pairs
+                    const auto& object{ j.get_ref<const json::object_t&>() };
+                    bytes += sizeof(json::object_t) + object.capacity() * sizeof(json::object_t::value_type);
+                    for (const auto& [key, value] : object)
+                        {
+                            bytes += GetStringHeapBytes(key) + EstimateJsonBytes(value);
+                        }
+                    break;
+                }
+            case json::value_t::array:
+                {
+                    const auto& array{ j.get_ref<const json::array_t&>() };
+                    bytes += sizeof(json::array_t) + array.capacity() * sizeof(json);
+                    for (const auto& value : array)
+                        {
+                            bytes += EstimateJsonBytes(value);
+                        }
+                    break;
+                }
+            case json::value_t::string:
+                bytes += sizeof(json::string_t) + GetStringHeapBytes(j.get_ref<const json::string_t&>());
+                break;
+            default:
+                // Numbers and booleans are stored in the node
+                break;
+        }
+    return bytes;
+}
+
+std::optional<std::string>
+AppendMemoryReport(const std::string& path, const MemoryReport& report, double timeSeconds)
+{
+    std::ofstream fileStream{ path, std::ios::app };
+    if (!fileStream)
+        {
+            return "Failed to open " + path + " for writing!";
+        }
+    fileStream << report.ToJson(timeSeconds).dump() << "\n";
+    if (!fileStream)
+        {
+            return "Failed to write " + path + "!";
+        }
+    return {};
+}
@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "raylib.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct MemoryEntry
+{
+    /**
+     * \brief Slash separated, the first part is the subsystem (gpu, cpu, project, undo, transient, ...).
+     */
+    std::string Category{};
+    std::string Detail{};
+    int64_t     Bytes{};
+    int64_t     Count{};
+};
+
+/**
+ * \brief Byte counters filled by every subsystem through its ReportMemory method.
+ */
+class MemoryReport final
+{
+  public:
+    void Add(std::string category, int64_t bytes, int64_t count = 1, std::string detail = {});
+    void AddTexture(std::string category, const Texture2D& texture, std::string detail = {});
+    void AddImage(std::string category, const Image& image, std::string detail = {});
+
+    const std::vector<MemoryEntry>& GetEntries() const { return _entries; }
+    /**
+     * \brief The sum of the categories starting with the prefix, all of them if empty.
+     */
+    int64_t GetTotalBytes(std::string_view prefix = {}) const;
+
+    nlohmann::ordered_json ToJson(double timeSeconds) const;
+
+  private:
+    std::vector<MemoryEntry> _entries{};
+};
+
+/**
+ * \brief The GPU size of the texture including its mipmaps.
+ */
+int64_t     GetTextureBytes(const Texture2D& texture);
+const char* GetPixelFormatName(int32_t format);
+/**
+ * \brief Heap bytes of the string, zero while it fits the small string buffer.
+ */
+int64_t GetStringHeapBytes(const std::string& str);
+/**
+ * \brief Heap bytes held by the json tree, the root node itself excluded.
+ */
+int64_t EstimateJsonBytes(const nlohmann::ordered_json& j);
+
+/**
+ * \brief Appends the report as one JSON line, a log of reports shows what grows during long sessions.
+ * \return The error string if failed.
+ */
+std::optional<std::string> AppendMemoryReport(const std::string& path, const MemoryReport& report, double timeSeconds);
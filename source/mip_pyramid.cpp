@@ -0,0 +1,394 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "mip_pyramid.hpp"
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Lobes of the Lanczos kernel, 2 keeps the ringing low on sprites with hard edges
+constexpr float  LANCZOS_RADIUS{ 2.f };
+constexpr float  PI{ 3.14159265358979f };
+// Destination rows per task, the horizontally filtered source rows are shared by the rows of a task
+constexpr size_t ROWS_PER_TASK{ 16 };
+
+/**
+ * \brief The source texels contributing to every destination texel along one axis, the weights of a texel sum to one.
+ */
+struct Contributions
+{
+    std::vector<int32_t> First{};
+    std::vector<int32_t> Count{};
+    /**
+     * \brief MaxTaps weights per destination texel.
+     */
+    std::vector<float>   Weights{};
+    int32_t              MaxTaps{};
+};
+
+float
+GetLanczosWeight(float x)
+{
+    x = std::abs(x);
+    if (x < 1e-6f)
+        {
+            return 1.f;
+        }
+    if (x >= LANCZOS_RADIUS)
+        {
+            return 0.f;
+        }
+    const float px{ PI * x };
+    return LANCZOS_RADIUS * std::sin(px) * std::sin(px / LANCZOS_RADIUS) / (px * px);
+}
+
+Contributions
+ComputeContributions(int32_t srcSize, int32_t dstSize, EMipFilter filter)
+{
+    const float scale{ static_cast<float>(srcSize) / static_cast<float>(dstSize) };
+    // The box covers the footprint of the destination texel, the Lanczos kernel is stretched by the scale
+    const float support{ filter == EMipFilter::LANCZOS ? LANCZOS_RADIUS * scale : scale * 0.5f };
+
+    Contributions contributions{};
+    contributions.MaxTaps = static_cast<int32_t>(std::ceil(support * 2.f)) + 2;
+    contributions.First.resize(static_cast<size_t>(dstSize));
+    contributions.Count.resize(static_cast<size_t>(dstSize));
+    contributions.Weights.resize(static_cast<size_t>(dstSize) * contributions.MaxTaps);
+    for (int32_t i{}; i < dstSize; ++i)
+        {
+            const float   center{ (static_cast<float>(i) + 0.5f) * scale };
+            // Taps outside the image are dropped, the remaining weights are normalized again
+            const int32_t first{ std::max(0, static_cast<int32_t>(std::floor(center - support))) };
+            const int32_t last{ std::min(srcSize, static_cast<int32_t>(std::ceil(center + support))) };
+            float*        weights{ &contributions.Weights[static_cast<size_t>(i) * contributions.MaxTaps] };
+            int32_t       count{};
+            float         totalWeight{};
+            for (int32_t j{ first }; j < last && count < contributions.MaxTaps; ++j, ++count)
+                {
+                    const float texel{ static_cast<float>(j) };
+                    weights[count] = filter == EMipFilter::LANCZOS ? GetLanczosWeight((texel + 0.5f - center) / scale)
+                                                                   : std::max(0.f, std::min(texel + 1.f, center + support) - std::max(texel, center - support));
+                    totalWeight += weights[count];
+                }
+            for (int32_t k{}; k < count && totalWeight != 0.f; ++k)
+                {
+                    weights[k] /= totalWeight;
+                }
+            contributions.First[i] = first;
+            contributions.Count[i] = count;
+        }
+    return contributions;
+}
+
+/**
+ * \brief The destination texels along one axis reading a texel of the source span, the taps of consecutive texels only move forward.
+ */
+void
+GetAffectedRange(const Contributions& contributions, int32_t srcBegin, int32_t srcEnd, int32_t& outBegin, int32_t& outEnd)
+{
+    const int32_t dstSize{ static_cast<int32_t>(contributions.First.size()) };
+    outBegin = 0;
+    while (outBegin < dstSize && contributions.First[outBegin] + contributions.Count[outBegin] <= srcBegin)
+        {
+            ++outBegin;
+        }
+    outEnd = outBegin;
+    while (outEnd < dstSize && contributions.First[outEnd] < srcEnd)
+        {
+            ++outEnd;
+        }
+}
+
+#pragma region Pixel
+// A premultiplied RGBA texel in floats, one SSE register
+#ifdef SPRITE_UV_SSE2
+// Wrapped, the alignment attribute of __m128 is lost as a template argument
+struct Pixel
+{
+    __m128 Value;
+};
+
+inline Pixel
+ZeroPixel()
+{
+    return { _mm_setzero_ps() };
+}
+
+inline Pixel
+MulAdd(Pixel sum, Pixel pixel, float weight)
+{
+    return { _mm_add_ps(sum.Value, _mm_mul_ps(pixel.Value, _mm_set1_ps(weight))) };
+}
+
+/**
+ * \brief The color channels take the multiplier, the alpha channel keeps its value.
+ */
+inline __m128
+ScaleColorOnly(__m128 multiplier)
+{
+    const __m128 colorMask{ _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)) };
+    return _mm_or_ps(_mm_and_ps(colorMask, multiplier), _mm_set_ps(1.f, 0.f, 0.f, 0.f));
+}
+
+inline Pixel
+LoadPremultiplied(const uint8_t* texel)
+{
+    int32_t packed{};
+    std::memcpy(&packed, texel, sizeof(packed));
+    const __m128i zero{ _mm_setzero_si128() };
+    const __m128  color{ _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero)) };
+    const __m128  alpha{ _mm_mul_ps(_mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3)), _mm_set1_ps(1.f / 255.f)) };
+    return { _mm_mul_ps(color, ScaleColorOnly(alpha)) };
+}
+
+inline void
+StoreUnpremultiplied(Pixel pixel, uint8_t* texel)
+{
+    const __m128 zero{ _mm_setzero_ps() };
+    const __m128 alpha{ _mm_min_ps(_mm_max_ps(_mm_shuffle_ps(pixel.Value, pixel.Value, _MM_SHUFFLE(3, 3, 3, 3)), zero), _mm_set1_ps(255.f)) };
+    // The ringing of the Lanczos kernel can push the color over the alpha or below zero
+    __m128       color{ _mm_min_ps(_mm_max_ps(pixel.Value, zero), alpha) };
+    color = _mm_mul_ps(color, ScaleColorOnly(_mm_div_ps(_mm_set1_ps(255.f), _mm_max_ps(alpha, _mm_set1_ps(1e-6f)))));
+    // Texels rounding to transparent are stored as transparent black
+    color = _mm_and_ps(color, _mm_cmpge_ps(alpha, _mm_set1_ps(0.5f)));
+
+    __m128i packed{ _mm_cvtps_epi32(color) };
+    packed = _mm_packs_epi32(packed, packed);
+    packed = _mm_packus_epi16(packed, packed);
+    const int32_t bytes{ _mm_cvtsi128_si32(packed) };
+    std::memcpy(texel, &bytes, sizeof(bytes));
+}
+#else
+struct Pixel
+{
+    float Channels[4]{};
+};
+
+inline Pixel
+ZeroPixel()
+{
+    return {};
+}
+
+inline Pixel
+MulAdd(Pixel sum, const Pixel& pixel, float weight)
+{
+    for (int32_t c{}; c < 4; ++c)
+        {
+            sum.Channels[c] += pixel.Channels[c] * weight;
+        }
+    return sum;
+}
+
+inline Pixel
+LoadPremultiplied(const uint8_t* texel)
+{
+    const float alpha{ texel[3] / 255.f };
+    return { { texel[0] * alpha, texel[1] * alpha, texel[2] * alpha, static_cast<float>(texel[3]) } };
+}
+
+inline void
+StoreUnpremultiplied(const Pixel& pixel, uint8_t* texel)
+{
+    const float alpha{ std::clamp(pixel.Channels[3], 0.f, 255.f) };
+    if (alpha < 0.5f)
+        {
+            std::memset(texel, 0, 4);
+            return;
+        }
+    for (int32_t c{}; c < 3; ++c)
+        {
+            texel[c] = static_cast<uint8_t>(std::lround(std::clamp(pixel.Channels[c], 0.f, alpha) * 255.f / alpha));
+        }
+    texel[3] = static_cast<uint8_t>(std::lround(alpha));
+}
+#endif
+#pragma endregion Pixel
+}
+
+int32_t
+GetNumMipLevels(int32_t width, int32_t height)
+{
+    int32_t numLevels{ 1 };
+    while (width > 1 || height > 1)
+        {
+            width  = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            ++numLevels;
+        }
+    return numLevels;
+}
+
+size_t
+GetMipChainBytes(int32_t width, int32_t height, int32_t numLevels)
+{
+    size_t bytes{};
+    for (int32_t level{}; level < numLevels; ++level)
+        {
+            bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+            width  = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+    return bytes;
+}
+
+void
+DownsampleImage(const uint8_t* src, int32_t srcWidth, int32_t srcHeight, uint8_t* dst, int32_t dstWidth, int32_t dstHeight, EMipFilter filter)
+{
+    (void)DownsampleRegion(src, srcWidth, srcHeight, dst, dstWidth, dstHeight, filter, { 0, 0, srcWidth, srcHeight });
+}
+
+MipRegion
+DownsampleRegion(const uint8_t* src, int32_t srcWidth, int32_t srcHeight, uint8_t* dst, int32_t dstWidth, int32_t dstHeight, EMipFilter filter, MipRegion srcRegion)
+{
+    const Contributions columns{ ComputeContributions(srcWidth, dstWidth, filter) };
+    const Contributions rows{ ComputeContributions(srcHeight, dstHeight, filter) };
+    int32_t             x0{};
+    int32_t             x1{};
+    int32_t             y0{};
+    int32_t             y1{};
+    GetAffectedRange(columns, srcRegion.X, srcRegion.X + srcRegion.Width, x0, x1);
+    GetAffectedRange(rows, srcRegion.Y, srcRegion.Y + srcRegion.Height, y0, y1);
+    if (x0 >= x1 || y0 >= y1)
+        {
+            return {};
+        }
+
+    // The source columns read by the destination columns of the region
+    const int32_t srcColumnBegin{ columns.First[x0] };
+    const int32_t srcColumnEnd{ columns.First[x1 - 1] + columns.Count[x1 - 1] };
+    const int32_t regionWidth{ x1 - x0 };
+    const size_t  numTasks{ (static_cast<size_t>(y1 - y0) + ROWS_PER_TASK - 1) / ROWS_PER_TASK };
+    ThreadPool::Shared().ParallelFor(numTasks, [&](size_t begin, size_t end) {
+        std::vector<Pixel> premultiplied(static_cast<size_t>(srcColumnEnd - srcColumnBegin));
+        std::vector<Pixel> sums(static_cast<size_t>(regionWidth));
+        std::vector<Pixel> filtered{};
+        for (size_t task{ begin }; task < end; ++task)
+            {
+                const int32_t firstRow{ y0 + static_cast<int32_t>(task * ROWS_PER_TASK) };
+                const int32_t lastRow{ std::min(y1, firstRow + static_cast<int32_t>(ROWS_PER_TASK)) };
+                const int32_t srcBegin{ rows.First[firstRow] };
+                const int32_t srcEnd{ rows.First[lastRow - 1] + rows.Count[lastRow - 1] };
+                filtered.resize(static_cast<size_t>(srcEnd - srcBegin) * regionWidth);
+
+                // Horizontal pass, once per source row of the band
+                for (int32_t y{ srcBegin }; y < srcEnd; ++y)
+                    {
+                        const uint8_t* srcRow{ src + static_cast<size_t>(y) * srcWidth * 4 };
+                        for (int32_t x{ srcColumnBegin }; x < srcColumnEnd; ++x)
+                            {
+                                premultiplied[x - srcColumnBegin] = LoadPremultiplied(srcRow + static_cast<size_t>(x) * 4);
+                            }
+                        Pixel* filteredRow{ &filtered[static_cast<size_t>(y - srcBegin) * regionWidth] };
+                        for (int32_t x{ x0 }; x < x1; ++x)
+                            {
+                                const Pixel* taps{ &premultiplied[columns.First[x] - srcColumnBegin] };
+                                const float* weights{ &columns.Weights[static_cast<size_t>(x) * columns.MaxTaps] };
+                                Pixel        sum{ ZeroPixel() };
+                                for (int32_t k{}; k < columns.Count[x]; ++k)
+                                    {
+                                        sum = MulAdd(sum, taps[k], weights[k]);
+                                    }
+                                filteredRow[x - x0] = sum;
+                            }
+                    }
+
+                // Vertical pass, row by row so the inner loop walks contiguous texels
+                for (int32_t y{ firstRow }; y < lastRow; ++y)
+                    {
+                        std::fill(sums.begin(), sums.end(), ZeroPixel());
+                        const float* weights{ &rows.Weights[static_cast<size_t>(y) * rows.MaxTaps] };
+                        for (int32_t k{}; k < rows.Count[y]; ++k)
+                            {
+                                const Pixel* filteredRow{ &filtered[static_cast<size_t>(rows.First[y] + k - srcBegin) * regionWidth] };
+                                for (int32_t x{}; x < regionWidth; ++x)
+                                    {
+                                        sums[x] = MulAdd(sums[x], filteredRow[x], weights[k]);
+                                    }
+                            }
+                        uint8_t* dstRow{ dst + (static_cast<size_t>(y) * dstWidth + x0) * 4 };
+                        for (int32_t x{}; x < regionWidth; ++x)
+                            {
+                                StoreUnpremultiplied(sums[x], dstRow + static_cast<size_t>(x) * 4);
+                            }
+                    }
+            }
+    });
+    return { x0, y0, regionWidth, y1 - y0 };
+}
+
+void
+GenerateMipChain(uint8_t* chain, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter)
+{
+    GenerateMipLevels(chain, width, height, numLevels, filter, chain + static_cast<size_t>(width) * height * 4);
+}
+
+void
+GenerateMipLevels(const uint8_t* image, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter, uint8_t* levels)
+{
+    if (filter == EMipFilter::NONE)
+        {
+            return;
+        }
+    const uint8_t* level{ image };
+    uint8_t*       nextLevel{ levels };
+    for (int32_t i{ 1 }; i < numLevels; ++i)
+        {
+            const int32_t levelWidth{ std::max(1, width / 2) };
+            const int32_t levelHeight{ std::max(1, height / 2) };
+            DownsampleImage(level, width, height, nextLevel, levelWidth, levelHeight, filter);
+            level = nextLevel;
+            nextLevel += static_cast<size_t>(levelWidth) * levelHeight * 4;
+            width  = levelWidth;
+            height = levelHeight;
+        }
+}
+
+void
+UpdateMipLevels(const uint8_t* image, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter, uint8_t* levels, MipRegion region, MipRegion* outRegions)
+{
+    const uint8_t* level{ image };
+    uint8_t*       nextLevel{ levels };
+    for (int32_t i{ 1 }; i < numLevels; ++i)
+        {
+            const int32_t levelWidth{ std::max(1, width / 2) };
+            const int32_t levelHeight{ std::max(1, height / 2) };
+            // Once nothing is left the next levels are untouched too
+            region = region.Width > 0 && region.Height > 0 && filter != EMipFilter::NONE
+                     ? DownsampleRegion(level, width, height, nextLevel, levelWidth, levelHeight, filter, region)
+                     : MipRegion{};
+            outRegions[i - 1] = region;
+            level             = nextLevel;
+            nextLevel += static_cast<size_t>(levelWidth) * levelHeight * 4;
+            width  = levelWidth;
+            height = levelHeight;
+        }
+}
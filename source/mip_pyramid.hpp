@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Mip chains of RGBA8 images, laid out as raylib uploads them: each level follows the previous one and the sizes are halved, rounding down,
+// until 1x1. Kept free of raylib so it can run headless.
+
+enum class EMipFilter : uint8_t
+{
+    NONE,
+    BOX,
+    LANCZOS,
+};
+
+/**
+ * \brief A rect of texels in one level.
+ */
+struct MipRegion
+{
+    int32_t X{};
+    int32_t Y{};
+    int32_t Width{};
+    int32_t Height{};
+};
+
+/**
+ * \brief Number of levels of the full chain including the image itself.
+ */
+int32_t GetNumMipLevels(int32_t width, int32_t height);
+
+size_t GetMipChainBytes(int32_t width, int32_t height, int32_t numLevels);
+
+/**
+ * \brief Downsamples an RGBA8 image to any smaller size. The filtering is done on premultiplied alpha so the color of the transparent texels
+ * does not bleed into their neighbors. The rows are filtered in parallel on the shared pool.
+ */
+void DownsampleImage(const uint8_t* src, int32_t srcWidth, int32_t srcHeight, uint8_t* dst, int32_t dstWidth, int32_t dstHeight, EMipFilter filter);
+
+/**
+ * \brief Regenerates only the destination texels reading the changed source region, the other texels are left as they are.
+ * \return The destination region written, empty if none.
+ */
+MipRegion DownsampleRegion(const uint8_t* src, int32_t srcWidth, int32_t srcHeight, uint8_t* dst, int32_t dstWidth, int32_t dstHeight, EMipFilter filter,
+                           MipRegion srcRegion);
+
+/**
+ * \brief Fills the levels after the first one, each from the previous level.
+ * \param chain Holds GetMipChainBytes, starts with the full size image.
+ */
+void GenerateMipChain(uint8_t* chain, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter);
+
+/**
+ * \brief GenerateMipChain with the first level apart from the others.
+ * \param levels Holds GetMipChainBytes minus the first level.
+ */
+void GenerateMipLevels(const uint8_t* image, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter, uint8_t* levels);
+
+/**
+ * \brief Regenerates the texels of the levels after the first one depending on a changed region of the first level.
+ * \param levels As filled by GenerateMipLevels from the image before the change.
+ * \param outRegions numLevels - 1 entries, the region written in every level after the first, empty when untouched.
+ */
+void UpdateMipLevels(const uint8_t* image, int32_t width, int32_t height, int32_t numLevels, EMipFilter filter, uint8_t* levels, MipRegion region,
+                     MipRegion* outRegions);
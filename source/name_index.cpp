@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "name_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace
+{
+
+constexpr char
+ToLower(char c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr uint32_t
+PackTrigram(const char* str)
+{
+    return static_cast<uint32_t>(static_cast<uint8_t>(str[0])) | static_cast<uint32_t>(static_cast<uint8_t>(str[1])) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(str[2])) << 16;
+}
+
+}
+
+uint32_t
+NameIndex::Add(std::string_view name)
+{
+    const uint32_t id{ static_cast<uint32_t>(GetSize()) };
+    const size_t   begin{ _lowered.size() };
+    std::transform(name.begin(), name.end(), std::back_inserter(_lowered), ToLower);
+    _offsets.push_back(static_cast<uint32_t>(_lowered.size()));
+
+    // A trigram repeated in the name is posted once, the ids of a posting stay sorted since they only grow
+    for (size_t i{ begin }; i + 3 <= _lowered.size(); ++i)
+        {
+            std::vector<uint32_t>& posting{ _postings[PackTrigram(_lowered.data() + i)] };
+            if (posting.empty() || posting.back() != id)
+                {
+                    posting.push_back(id);
+                }
+        }
+    return id;
+}
+
+const std::vector<uint32_t>&
+NameIndex::Search(std::string_view query)
+{
+    std::string lowered(query.size(), '\0');
+    std::transform(query.begin(), query.end(), lowered.begin(), ToLower);
+    _numVerified = 0;
+    if (lowered == _query && _searchedSize == GetSize())
+        {
+            return _matches;
+        }
+
+    const auto contains = [this, &lowered](uint32_t id) {
+        ++_numVerified;
+        return GetLowered(id).find(lowered) != std::string_view::npos;
+    };
+
+    // Typing narrows the previous matches, the names added since are checked on their own
+    if (!_query.empty() && lowered.find(_query) != std::string::npos)
+        {
+            _matches.erase(std::remove_if(_matches.begin(), _matches.end(), [&contains](uint32_t id) { return !contains(id); }), _matches.end());
+            for (uint32_t id{ static_cast<uint32_t>(_searchedSize) }; id < GetSize(); ++id)
+                {
+                    if (contains(id))
+                        {
+                            _matches.push_back(id);
+                        }
+                }
+        }
+    else if (lowered.size() >= 3)
+        {
+            // Every match holds every trigram of the query, the shortest posting bounds the work
+            const std::vector<uint32_t>* rarest{};
+            for (size_t i{}; i + 3 <= lowered.size(); ++i)
+                {
+                    const auto it{ _postings.find(PackTrigram(lowered.data() + i)) };
+                    if (it == _postings.end())
+                        {
+                            rarest = nullptr;
+                            break;
+                        }
+                    if (!rarest || it->second.size() < rarest->size())
+                        {
+                            rarest = &it->second;
+                        }
+                }
+            _matches.clear();
+            if (rarest)
+                {
+                    std::copy_if(rarest->begin(), rarest->end(), std::back_inserter(_matches), contains);
+                }
+        }
+    else
+        {
+            // Too short for a trigram, the names are scanned
+            _matches.resize(GetSize());
+            std::iota(_matches.begin(), _matches.end(), 0u);
+            if (!lowered.empty())
+                {
+                    _matches.erase(std::remove_if(_matches.begin(), _matches.end(), [&contains](uint32_t id) { return !contains(id); }), _matches.end());
+                }
+        }
+
+    _query        = std::move(lowered);
+    _searchedSize = GetSize();
+    return _matches;
+}
+
+int64_t
+NameIndex::GetBytes() const
+{
+    int64_t bytes{ static_cast<int64_t>(_lowered.capacity() + _offsets.capacity() * sizeof(uint32_t) + _matches.capacity() * sizeof(uint32_t)) };
+    for (const auto& [trigram, posting] : _postings)
+        {
+            bytes += static_cast<int64_t>(sizeof(trigram) + sizeof(posting) + posting.capacity() * sizeof(uint32_t));
+        }
+    return bytes;
+}
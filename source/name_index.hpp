@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief Case insensitive substring search over names, the ids are dense and assigned in insertion order like the interner symbols.
+ * Names are never removed, the caller skips the ids no longer in use.
+ * A query of at least three characters only verifies the names holding its rarest trigram,
+ * a query extending the previous one only verifies the previous matches and the names added since.
+ */
+class NameIndex final
+{
+  public:
+    /**
+     * \return The id of the name, the number of names before it.
+     */
+    uint32_t Add(std::string_view name);
+    size_t   GetSize() const { return _offsets.size() - 1; }
+
+    /**
+     * \brief The ids of the names containing the query in ascending order, an empty query matches every name.
+     * The result is valid until the next call.
+     */
+    const std::vector<uint32_t>& Search(std::string_view query);
+    /**
+     * \brief Names verified by the last search, the work done for the query.
+     */
+    size_t GetNumVerified() const { return _numVerified; }
+    /**
+     * \brief The lowered names, the offsets and the trigram postings.
+     */
+    int64_t GetBytes() const;
+
+  private:
+    std::string_view GetLowered(uint32_t id) const { return { _lowered.data() + _offsets[id], _offsets[id + 1] - _offsets[id] }; }
+
+    // All the names lowered back to back
+    std::string                                         _lowered{};
+    std::vector<uint32_t>                               _offsets{ 0 };
+    std::unordered_map<uint32_t, std::vector<uint32_t>> _postings{};
+
+    // The last search, refined while the query grows
+    std::string           _query{};
+    size_t                _searchedSize{};
+    std::vector<uint32_t> _matches{};
+    size_t                _numVerified{};
+};
@@ -0,0 +1,575 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "palette_quantization.hpp"
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <optional>
+
+namespace
+{
+// The fully transparent pixels whatever their color
+constexpr uint32_t TRANSPARENT_COLOR{ 0 };
+// More strips than threads so an uneven image still keeps every thread busy
+constexpr size_t   STRIPS_PER_THREAD{ 4 };
+constexpr int32_t  KMEANS_ITERATIONS{ 2 };
+// The histogram of the quantization keeps 5 bits of red, green and blue and 3 bits of alpha
+constexpr size_t   NUM_BUCKETS{ 1 << 18 };
+
+using Color = std::array<uint8_t, 4>;
+
+uint32_t
+ReadPixel(const uint8_t* pixel)
+{
+    uint32_t value{};
+    std::memcpy(&value, pixel, sizeof(value));
+    return value;
+}
+
+uint32_t
+ToPaletteColor(uint32_t pixel)
+{
+    return reinterpret_cast<const uint8_t*>(&pixel)[3] == 0 ? TRANSPARENT_COLOR : pixel;
+}
+
+Color
+ToColor(uint32_t pixel)
+{
+    Color color{};
+    std::memcpy(color.data(), &pixel, sizeof(pixel));
+    return color;
+}
+
+uint32_t
+FromColor(const Color& color)
+{
+    return ReadPixel(color.data());
+}
+
+uint32_t
+GetBucket(uint32_t pixel)
+{
+    const Color color{ ToColor(pixel) };
+    return (static_cast<uint32_t>(color[0] >> 3) << 13) | (static_cast<uint32_t>(color[1] >> 3) << 8) | (static_cast<uint32_t>(color[2] >> 3) << 3) | (color[3] >> 5);
+}
+
+Color
+GetBucketCenter(uint32_t bucket)
+{
+    return { static_cast<uint8_t>((((bucket >> 13) & 31) << 3) | 4), static_cast<uint8_t>((((bucket >> 8) & 31) << 3) | 4), static_cast<uint8_t>((((bucket >> 3) & 31) << 3) | 4),
+             static_cast<uint8_t>(((bucket & 7) << 5) | 16) };
+}
+
+/**
+ * \brief The number of leading pixels equal to the color, pixel art is mostly made of runs thus most pixels are skipped 4 at a time.
+ */
+size_t
+MatchRun(const uint8_t* pixels, size_t count, uint32_t pixel)
+{
+    size_t i{};
+#ifdef SPRITE_UV_SSE2
+    const __m128i target{ _mm_set1_epi32(static_cast<int32_t>(pixel)) };
+    for (; i + 4 <= count; i += 4)
+        {
+            const __m128i equal{ _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4)), target) };
+            if (_mm_movemask_epi8(equal) != 0xFFFF)
+                {
+                    break;
+                }
+        }
+#endif
+    while (i < count && ReadPixel(pixels + i * 4) == pixel)
+        {
+            ++i;
+        }
+    return i;
+}
+
+/**
+ * \brief Open addressing map of the colors to their palette index, sized for MAX_PALETTE_SIZE at a low load factor.
+ */
+class ColorTable final
+{
+  public:
+    ColorTable() { _slots.fill(EMPTY); }
+
+    /**
+     * \return The index of the color, -1 if it is new and the table already holds maxColors.
+     */
+    int32_t
+    Insert(uint32_t color, size_t maxColors)
+    {
+        for (size_t slot{ Hash(color) };; slot = (slot + 1) & (CAPACITY - 1))
+            {
+                if (_slots[slot] == EMPTY)
+                    {
+                        if (_colors.size() >= maxColors)
+                            {
+                                return -1;
+                            }
+                        _slots[slot] = static_cast<int16_t>(_colors.size());
+                        _colors.push_back(color);
+                        return _slots[slot];
+                    }
+                if (_colors[_slots[slot]] == color)
+                    {
+                        return _slots[slot];
+                    }
+            }
+    }
+
+    int32_t
+    Find(uint32_t color) const
+    {
+        for (size_t slot{ Hash(color) }; _slots[slot] != EMPTY; slot = (slot + 1) & (CAPACITY - 1))
+            {
+                if (_colors[_slots[slot]] == color)
+                    {
+                        return _slots[slot];
+                    }
+            }
+        return -1;
+    }
+
+    const std::vector<uint32_t>& GetColors() const { return _colors; }
+
+  private:
+    constexpr static size_t  CAPACITY{ 1024 };
+    constexpr static int16_t EMPTY{ -1 };
+    static_assert(CAPACITY >= MAX_PALETTE_SIZE * 4, "The load factor of a full palette must stay low");
+
+    static size_t Hash(uint32_t color) { return (color * 2654435761u) >> 22; }
+
+    std::array<int16_t, CAPACITY> _slots{};
+    std::vector<uint32_t>         _colors{};
+};
+
+/**
+ * \brief Runs body(beginRow, endRow) over horizontal strips of the image on the shared pool.
+ */
+template<typename Body>
+void
+ForEachStrip(int32_t height, const Body& body)
+{
+    ThreadPool&   pool{ ThreadPool::Shared() };
+    const size_t  numStrips{ std::clamp<size_t>(pool.GetNumThreads() * STRIPS_PER_THREAD, 1, static_cast<size_t>(height)) };
+    const int32_t stripHeight{ static_cast<int32_t>((static_cast<size_t>(height) + numStrips - 1) / numStrips) };
+    pool.ParallelFor(numStrips, [&](size_t begin, size_t end) {
+        for (size_t strip{ begin }; strip < end; ++strip)
+            {
+                const int32_t beginRow{ static_cast<int32_t>(strip) * stripHeight };
+                if (beginRow < height)
+                    {
+                        body(beginRow, std::min(beginRow + stripHeight, height));
+                    }
+            }
+    });
+}
+
+/**
+ * \brief Writes the palette index of every pixel, findIndex is only called once per run of equal pixels.
+ */
+template<typename FindIndex>
+void
+MapPixels(const uint8_t* rgba, int32_t width, int32_t height, uint8_t* outIndices, const FindIndex& findIndex)
+{
+    ForEachStrip(height, [&](int32_t beginRow, int32_t endRow) {
+        uint32_t previous{ ReadPixel(rgba + static_cast<size_t>(beginRow) * width * 4) };
+        uint8_t  previousIndex{ findIndex(previous) };
+        for (int32_t y{ beginRow }; y < endRow; ++y)
+            {
+                const uint8_t* row{ rgba + static_cast<size_t>(y) * width * 4 };
+                uint8_t*       indices{ outIndices + static_cast<size_t>(y) * width };
+                for (size_t x{};;)
+                    {
+                        const size_t run{ MatchRun(row + x * 4, width - x, previous) };
+                        std::memset(indices + x, previousIndex, run);
+                        x += run;
+                        if (x == static_cast<size_t>(width))
+                            {
+                                break;
+                            }
+                        previous      = ReadPixel(row + x * 4);
+                        previousIndex = findIndex(previous);
+                        indices[x++]  = previousIndex;
+                    }
+            }
+    });
+}
+
+/**
+ * \brief The sorted colors of the image, empty if there are more than maxColors.
+ * Every strip collects its own colors and stops as soon as any strip overflows.
+ */
+std::optional<std::vector<uint32_t>>
+FindExactPalette(const uint8_t* rgba, int32_t width, int32_t height, size_t maxColors)
+{
+    std::vector<ColorTable> tables{};
+    std::mutex              tablesMutex{};
+    std::atomic<bool>       overflow{};
+    ForEachStrip(height, [&](int32_t beginRow, int32_t endRow) {
+        ColorTable table{};
+        uint32_t   previous{ ReadPixel(rgba + static_cast<size_t>(beginRow) * width * 4) };
+        table.Insert(ToPaletteColor(previous), maxColors);
+        for (int32_t y{ beginRow }; y < endRow && !overflow; ++y)
+            {
+                const uint8_t* row{ rgba + static_cast<size_t>(y) * width * 4 };
+                for (size_t x{};;)
+                    {
+                        x += MatchRun(row + x * 4, width - x, previous);
+                        if (x == static_cast<size_t>(width))
+                            {
+                                break;
+                            }
+                        previous = ReadPixel(row + x * 4);
+                        if (table.Insert(ToPaletteColor(previous), maxColors) < 0)
+                            {
+                                overflow = true;
+                                return;
+                            }
+                        ++x;
+                    }
+            }
+        std::lock_guard lock{ tablesMutex };
+        tables.push_back(std::move(table));
+    });
+    if (overflow)
+        {
+            return {};
+        }
+
+    ColorTable merged{};
+    for (const auto& table : tables)
+        {
+            for (const uint32_t color : table.GetColors())
+                {
+                    if (merged.Insert(color, maxColors) < 0)
+                        {
+                            return {};
+                        }
+                }
+        }
+    // Independent of the strip order
+    std::vector<uint32_t> palette{ merged.GetColors() };
+    std::sort(palette.begin(), palette.end());
+    return palette;
+}
+
+struct HistogramEntry
+{
+    uint32_t Bucket{};
+    uint32_t Count{};
+    Color    Center{};
+};
+
+struct Box
+{
+    size_t   Begin{};
+    size_t   End{};
+    uint64_t Count{};
+    int32_t  Channel{};
+    int32_t  Range{};
+};
+
+/**
+ * \brief The widest channel of the entries, the box is split across it.
+ */
+void
+MeasureBox(const std::vector<HistogramEntry>& entries, Box& box)
+{
+    Color lowest{ 255, 255, 255, 255 };
+    Color highest{};
+    box.Count = 0;
+    for (size_t i{ box.Begin }; i < box.End; ++i)
+        {
+            for (size_t channel{}; channel < 4; ++channel)
+                {
+                    lowest[channel]  = std::min(lowest[channel], entries[i].Center[channel]);
+                    highest[channel] = std::max(highest[channel], entries[i].Center[channel]);
+                }
+            box.Count += entries[i].Count;
+        }
+    box.Range = -1;
+    for (int32_t channel{}; channel < 4; ++channel)
+        {
+            if (highest[channel] - lowest[channel] > box.Range)
+                {
+                    box.Range   = highest[channel] - lowest[channel];
+                    box.Channel = channel;
+                }
+        }
+}
+
+/**
+ * \brief Splits the most populated wide boxes at their median until there are numColors boxes, then returns their weighted means.
+ */
+std::vector<Color>
+MedianCut(std::vector<HistogramEntry>& entries, size_t numColors)
+{
+    std::vector<Box> boxes{ { 0, entries.size() } };
+    MeasureBox(entries, boxes.front());
+    while (boxes.size() < numColors)
+        {
+            const auto widest{ std::max_element(boxes.begin(), boxes.end(), [](const Box& lhs, const Box& rhs) {
+                return lhs.Count * (lhs.End - lhs.Begin > 1 ? lhs.Range : 0) < rhs.Count * (rhs.End - rhs.Begin > 1 ? rhs.Range : 0);
+            }) };
+            if (widest->End - widest->Begin < 2 || widest->Range == 0)
+                {
+                    break;
+                }
+
+            Box        box{ *widest };
+            const auto channel{ box.Channel };
+            std::sort(entries.begin() + box.Begin, entries.begin() + box.End, [channel](const HistogramEntry& lhs, const HistogramEntry& rhs) { return lhs.Center[channel] < rhs.Center[channel]; });
+            uint64_t below{};
+            size_t   split{ box.Begin };
+            while (split + 1 < box.End && (below + entries[split].Count) * 2 <= box.Count)
+                {
+                    below += entries[split++].Count;
+                }
+            split = std::max(split, box.Begin + 1);
+
+            Box upper{ split, box.End };
+            box.End = split;
+            MeasureBox(entries, box);
+            MeasureBox(entries, upper);
+            *widest = box;
+            boxes.push_back(upper);
+        }
+
+    std::vector<Color> palette{};
+    for (const auto& box : boxes)
+        {
+            std::array<uint64_t, 4> sums{};
+            for (size_t i{ box.Begin }; i < box.End; ++i)
+                {
+                    for (size_t channel{}; channel < 4; ++channel)
+                        {
+                            sums[channel] += static_cast<uint64_t>(entries[i].Center[channel]) * entries[i].Count;
+                        }
+                }
+            Color color{};
+            for (size_t channel{}; channel < 4; ++channel)
+                {
+                    color[channel] = static_cast<uint8_t>((sums[channel] + box.Count / 2) / std::max<uint64_t>(box.Count, 1));
+                }
+            palette.push_back(color);
+        }
+    return palette;
+}
+
+uint8_t
+FindNearest(const std::vector<Color>& palette, const Color& color)
+{
+    uint8_t  nearest{};
+    uint32_t nearestDistance{ UINT32_MAX };
+    for (size_t i{}; i < palette.size(); ++i)
+        {
+            uint32_t distance{};
+            for (size_t channel{}; channel < 4; ++channel)
+                {
+                    const int32_t difference{ static_cast<int32_t>(palette[i][channel]) - color[channel] };
+                    distance += static_cast<uint32_t>(difference * difference);
+                }
+            if (distance < nearestDistance)
+                {
+                    nearest         = static_cast<uint8_t>(i);
+                    nearestDistance = distance;
+                }
+        }
+    return nearest;
+}
+
+/**
+ * \brief Every pixel is mapped through the entry of its histogram bucket, the nearest palette color of the bucket center.
+ */
+void
+MapBuckets(const std::vector<HistogramEntry>& entries, const std::vector<Color>& palette, std::vector<uint8_t>& outBucketIndices)
+{
+    ThreadPool::Shared().ParallelFor(
+        entries.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i{ begin }; i < end; ++i)
+                {
+                    outBucketIndices[entries[i].Bucket] = FindNearest(palette, entries[i].Center);
+                }
+        },
+        256);
+}
+
+/**
+ * \brief Median cut over the histogram then k-means iterations moving every palette color to the mean of the pixels it stands for.
+ * \return The palette, the transparent entry first if any pixel is transparent.
+ */
+std::vector<uint32_t>
+QuantizePalette(const uint8_t* rgba, int32_t width, int32_t height, size_t maxColors, std::vector<uint8_t>& outBucketIndices, bool& outHasTransparent)
+{
+    std::vector<uint32_t> histogram(NUM_BUCKETS);
+    std::mutex            histogramMutex{};
+    std::atomic<bool>     hasTransparent{};
+    ForEachStrip(height, [&](int32_t beginRow, int32_t endRow) {
+        std::vector<uint32_t> counts(NUM_BUCKETS);
+        for (int32_t y{ beginRow }; y < endRow; ++y)
+            {
+                const uint8_t* row{ rgba + static_cast<size_t>(y) * width * 4 };
+                for (size_t x{}; x < static_cast<size_t>(width);)
+                    {
+                        const uint32_t pixel{ ReadPixel(row + x * 4) };
+                        const size_t   run{ MatchRun(row + x * 4, width - x, pixel) };
+                        x += run;
+                        if (ToPaletteColor(pixel) == TRANSPARENT_COLOR)
+                            {
+                                hasTransparent = true;
+                                continue;
+                            }
+                        counts[GetBucket(pixel)] += static_cast<uint32_t>(run);
+                    }
+            }
+        std::lock_guard lock{ histogramMutex };
+        std::transform(histogram.begin(), histogram.end(), counts.begin(), histogram.begin(), std::plus<>{});
+    });
+    outHasTransparent = hasTransparent;
+
+    std::vector<HistogramEntry> entries{};
+    for (uint32_t bucket{}; bucket < NUM_BUCKETS; ++bucket)
+        {
+            if (histogram[bucket] > 0)
+                {
+                    entries.push_back({ bucket, histogram[bucket], GetBucketCenter(bucket) });
+                }
+        }
+    if (entries.empty())
+        {
+            return { TRANSPARENT_COLOR };
+        }
+
+    std::vector<Color> palette{ MedianCut(entries, maxColors - (outHasTransparent ? 1 : 0)) };
+    outBucketIndices.assign(NUM_BUCKETS, 0);
+    for (int32_t iteration{}; iteration < KMEANS_ITERATIONS; ++iteration)
+        {
+            MapBuckets(entries, palette, outBucketIndices);
+
+            std::vector<std::array<uint64_t, 5>> sums(palette.size());
+            std::mutex                           sumsMutex{};
+            ForEachStrip(height, [&](int32_t beginRow, int32_t endRow) {
+                std::vector<std::array<uint64_t, 5>> stripSums(palette.size());
+                for (int32_t y{ beginRow }; y < endRow; ++y)
+                    {
+                        const uint8_t* row{ rgba + static_cast<size_t>(y) * width * 4 };
+                        for (size_t x{}; x < static_cast<size_t>(width);)
+                            {
+                                const uint32_t pixel{ ReadPixel(row + x * 4) };
+                                const size_t   run{ MatchRun(row + x * 4, width - x, pixel) };
+                                x += run;
+                                if (ToPaletteColor(pixel) == TRANSPARENT_COLOR)
+                                    {
+                                        continue;
+                                    }
+                                const Color color{ ToColor(pixel) };
+                                auto&       sum{ stripSums[outBucketIndices[GetBucket(pixel)]] };
+                                for (size_t channel{}; channel < 4; ++channel)
+                                    {
+                                        sum[channel] += static_cast<uint64_t>(color[channel]) * run;
+                                    }
+                                sum[4] += run;
+                            }
+                    }
+                std::lock_guard lock{ sumsMutex };
+                for (size_t i{}; i < sums.size(); ++i)
+                    {
+                        for (size_t channel{}; channel < 5; ++channel)
+                            {
+                                sums[i][channel] += stripSums[i][channel];
+                            }
+                    }
+            });
+            // A color standing for no pixel is kept as is
+            for (size_t i{}; i < palette.size(); ++i)
+                {
+                    if (sums[i][4] > 0)
+                        {
+                            for (size_t channel{}; channel < 4; ++channel)
+                                {
+                                    palette[i][channel] = static_cast<uint8_t>((sums[i][channel] + sums[i][4] / 2) / sums[i][4]);
+                                }
+                        }
+                }
+        }
+    MapBuckets(entries, palette, outBucketIndices);
+
+    std::vector<uint32_t> colors{};
+    if (outHasTransparent)
+        {
+            colors.push_back(TRANSPARENT_COLOR);
+        }
+    for (const auto& color : palette)
+        {
+            colors.push_back(FromColor(color));
+        }
+    return colors;
+}
+}
+
+IndexedImage
+QuantizeImage(const uint8_t* rgba, int32_t width, int32_t height, size_t maxColors)
+{
+    IndexedImage image{ width, height };
+    if (width <= 0 || height <= 0)
+        {
+            image.Exact = true;
+            return image;
+        }
+    maxColors = std::clamp<size_t>(maxColors, 2, MAX_PALETTE_SIZE);
+    image.Indices.resize(static_cast<size_t>(width) * height);
+
+    if (auto exactPalette{ FindExactPalette(rgba, width, height, maxColors) }; exactPalette.has_value())
+        {
+            ColorTable table{};
+            for (const uint32_t color : exactPalette.value())
+                {
+                    table.Insert(color, MAX_PALETTE_SIZE);
+                }
+            MapPixels(rgba, width, height, image.Indices.data(), [&table](uint32_t pixel) { return static_cast<uint8_t>(table.Find(ToPaletteColor(pixel))); });
+            image.Palette = std::move(exactPalette.value());
+            image.Exact   = true;
+            return image;
+        }
+
+    std::vector<uint8_t> bucketIndices{};
+    bool                 hasTransparent{};
+    image.Palette = QuantizePalette(rgba, width, height, maxColors, bucketIndices, hasTransparent);
+    // The transparent entry comes first and shifts the others
+    const uint8_t offset{ static_cast<uint8_t>(hasTransparent ? 1 : 0) };
+    MapPixels(rgba, width, height, image.Indices.data(), [&](uint32_t pixel) {
+        return ToPaletteColor(pixel) == TRANSPARENT_COLOR ? uint8_t{} : static_cast<uint8_t>(bucketIndices[GetBucket(pixel)] + offset);
+    });
+    return image;
+}
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Indexed color images, 1 byte per pixel plus a palette instead of the 4 bytes of RGBA8.
+// Kept free of raylib so it can run headless, the caller decodes the image.
+
+constexpr size_t MAX_PALETTE_SIZE{ 256 };
+
+struct IndexedImage
+{
+    int32_t               Width{};
+    int32_t               Height{};
+    /**
+     * \brief RGBA8 entries in memory order, at most MAX_PALETTE_SIZE.
+     */
+    std::vector<uint32_t> Palette{};
+    std::vector<uint8_t>  Indices{};
+    /**
+     * \brief Every color of the image got its own entry, only the color of the fully transparent pixels is lost.
+     */
+    bool                  Exact{};
+};
+
+/**
+ * \brief Builds the palette of the image, exactly if it holds few enough colors, with a median cut refined by k-means otherwise.
+ * The image is processed in horizontal strips on the shared pool. Fully transparent pixels share a single transparent entry.
+ */
+IndexedImage QuantizeImage(const uint8_t* rgba, int32_t width, int32_t height, size_t maxColors = MAX_PALETTE_SIZE);
+
+/**
+ * \brief The texture memory saved by uploading the indexed image and its palette instead of RGBA8.
+ */
+inline uint64_t
+GetSavedBytes(const IndexedImage& image)
+{
+    const uint64_t numPixels{ static_cast<uint64_t>(image.Width) * static_cast<uint64_t>(image.Height) };
+    const uint64_t indexedBytes{ numPixels + image.Palette.size() * sizeof(uint32_t) };
+    return numPixels * 4 > indexedBytes ? numPixels * 4 - indexedBytes : 0;
+}
@@ -0,0 +1,239 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "profiler.hpp"
+
+#if defined(SPRITE_UV_PROFILER)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+namespace profiler
+{
+namespace
+{
+constexpr uint64_t EVENT_MASK{ EVENT_CAPACITY - 1 };
+static_assert((EVENT_CAPACITY & EVENT_MASK) == 0, "The event capacity must be a power of two");
+
+/**
+ * \brief Written like a seqlock: the sequence is cleared, the fields written, then the sequence published.
+ * Readers keep the event only if the sequence matches before and after reading it.
+ */
+struct EventSlot
+{
+    std::atomic<uint64_t>    Sequence{};
+    std::atomic<const char*> Name{};
+    std::atomic<int64_t>     StartUs{};
+    std::atomic<int64_t>     DurationUs{};
+    std::atomic<uint32_t>    ThreadId{};
+    std::atomic<uint32_t>    Frame{};
+};
+
+std::array<EventSlot, EVENT_CAPACITY> events{};
+std::atomic<uint64_t>                 eventHead{};
+std::atomic<uint32_t>                 currentFrame{};
+std::atomic<uint32_t>                 nextThreadId{};
+
+// Main thread only
+std::array<FrameSample, FRAME_CAPACITY> frames{};
+uint64_t                                frameHead{};
+int64_t                                 frameStartUs{};
+
+uint32_t
+GetThreadId()
+{
+    thread_local const uint32_t threadId{ nextThreadId.fetch_add(1, std::memory_order_relaxed) + 1 };
+    return threadId;
+}
+
+std::optional<Event>
+ReadEvent(uint64_t index)
+{
+    const EventSlot& slot{ events[index & EVENT_MASK] };
+    const uint64_t   sequence{ slot.Sequence.load(std::memory_order_acquire) };
+    if (sequence != index + 1)
+        {
+            return {};
+        }
+    Event event{ slot.Name.load(std::memory_order_relaxed), slot.StartUs.load(std::memory_order_relaxed), slot.DurationUs.load(std::memory_order_relaxed),
+        slot.ThreadId.load(std::memory_order_relaxed), slot.Frame.load(std::memory_order_relaxed) };
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.Sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            return {};
+        }
+    return event;
+}
+
+std::string
+EscapeJson(const char* str)
+{
+    std::string escaped{};
+    for (const char* c{ str }; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                {
+                    escaped += '\\';
+                }
+            escaped += *c;
+        }
+    return escaped;
+}
+}
+
+int64_t
+NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+Record(const char* name, int64_t startUs, int64_t durationUs)
+{
+    const uint64_t index{ eventHead.fetch_add(1, std::memory_order_relaxed) };
+    EventSlot&     slot{ events[index & EVENT_MASK] };
+    slot.Sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.Name.store(name, std::memory_order_relaxed);
+    slot.StartUs.store(startUs, std::memory_order_relaxed);
+    slot.DurationUs.store(durationUs, std::memory_order_relaxed);
+    slot.ThreadId.store(GetThreadId(), std::memory_order_relaxed);
+    slot.Frame.store(currentFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot.Sequence.store(index + 1, std::memory_order_release);
+}
+
+void
+BeginFrame()
+{
+    frameStartUs = NowUs();
+}
+
+void
+EndFrame(const RenderStats& renderStats)
+{
+    const uint32_t frame{ currentFrame.load(std::memory_order_relaxed) };
+    const int64_t  durationUs{ NowUs() - frameStartUs };
+    Record("Frame", frameStartUs, durationUs);
+    frames[frameHead % FRAME_CAPACITY] = { frame, frameStartUs, durationUs, renderStats };
+    ++frameHead;
+    currentFrame.store(frame + 1, std::memory_order_relaxed);
+}
+
+std::vector<FrameSample>
+GetFrameSamples()
+{
+    const uint64_t           count{ std::min<uint64_t>(frameHead, FRAME_CAPACITY) };
+    std::vector<FrameSample> samples{};
+    samples.reserve(count);
+    for (uint64_t i{ frameHead - count }; i < frameHead; ++i)
+        {
+            samples.push_back(frames[i % FRAME_CAPACITY]);
+        }
+    return samples;
+}
+
+std::vector<Event>
+GetLastFrameEvents()
+{
+    std::vector<Event> lastFrameEvents{};
+    const uint32_t     currentFrameIndex{ currentFrame.load(std::memory_order_relaxed) };
+    if (currentFrameIndex == 0)
+        {
+            return lastFrameEvents;
+        }
+
+    // Events are recorded in order, walk back until the frame before
+    const uint64_t head{ eventHead.load(std::memory_order_acquire) };
+    const uint64_t first{ head > EVENT_CAPACITY ? head - EVENT_CAPACITY : 0 };
+    for (uint64_t index{ head }; index-- > first;)
+        {
+            const auto event{ ReadEvent(index) };
+            if (!event.has_value())
+                {
+                    continue;
+                }
+            if (event->Frame + 1 < currentFrameIndex)
+                {
+                    break;
+                }
+            if (event->Frame + 1 == currentFrameIndex)
+                {
+                    lastFrameEvents.push_back(event.value());
+                }
+        }
+    return lastFrameEvents;
+}
+
+int64_t
+GetBufferBytes()
+{
+    return static_cast<int64_t>(sizeof(events) + sizeof(frames));
+}
+
+std::optional<std::string>
+WriteChromeTrace(const std::string& path)
+{
+    std::ofstream fileStream{ path, std::ios::trunc };
+    if (!fileStream)
+        {
+            return "Failed to open " + path + " for writing!";
+        }
+
+    const uint64_t head{ eventHead.load(std::memory_order_acquire) };
+    const uint64_t first{ head > EVENT_CAPACITY ? head - EVENT_CAPACITY : 0 };
+
+    // Complete events ("X"), one line each
+    fileStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    fileStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Sprite UV Editor\"}}";
+    for (uint64_t index{ first }; index < head; ++index)
+        {
+            const auto event{ ReadEvent(index) };
+            if (!event.has_value())
+                {
+                    continue;
+                }
+            fileStream << ",\n{\"name\":\"" << EscapeJson(event->Name) << "\",\"ph\":\"X\",\"ts\":" << event->StartUs << ",\"dur\":" << event->DurationUs
+                       << ",\"pid\":1,\"tid\":" << event->ThreadId << ",\"args\":{\"frame\":" << event->Frame << "}}";
+        }
+    // Draw counts and text measurements as counter tracks
+    for (const auto& sample : GetFrameSamples())
+        {
+            fileStream << ",\n{\"name\":\"Render\",\"ph\":\"C\",\"ts\":" << sample.StartUs << ",\"pid\":1,\"args\":{\"drawCalls\":" << sample.Render.DrawCalls
+                       << ",\"vertices\":" << sample.Render.Vertices << "}}";
+            fileStream << ",\n{\"name\":\"Text\",\"ph\":\"C\",\"ts\":" << sample.StartUs << ",\"pid\":1,\"args\":{\"measurements\":" << sample.Render.TextMeasurements << "}}";
+        }
+    fileStream << "\n]}\n";
+
+    if (!fileStream)
+        {
+            return "Failed to write " + path + "!";
+        }
+    return {};
+}
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+// Scoped timers for the main loop and the project operations.
+// Everything compiles out unless SPRITE_UV_PROFILER is defined (CMake option SPRITE_UV_ENABLE_PROFILER).
+
+#if defined(SPRITE_UV_PROFILER)
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+/**
+ * \brief Times the enclosing scope, the name must be a string literal.
+ */
+#define PROFILE_SCOPE(name) const profiler::ScopedTimer PROFILE_CONCAT(profileScope_, __LINE__){ name }
+/**
+ * \brief Times a section of code without its own scope, ended by PROFILE_END.
+ */
+#define PROFILE_BEGIN(zone, name) profiler::ScopedTimer zone{ name }
+#define PROFILE_END(zone) zone.Stop()
+
+namespace profiler
+{
+
+constexpr size_t EVENT_CAPACITY{ 1 << 16 };
+constexpr size_t FRAME_CAPACITY{ 256 };
+
+struct Event
+{
+    const char* Name{};
+    int64_t     StartUs{};
+    int64_t     DurationUs{};
+    uint32_t    ThreadId{};
+    uint32_t    Frame{};
+};
+
+struct RenderStats
+{
+    int32_t DrawCalls{};
+    int32_t Vertices{};
+    /**
+     * \brief Texts laid out by the frame, the cached labels are not measured again.
+     */
+    int32_t TextMeasurements{};
+};
+
+struct FrameSample
+{
+    uint32_t    Frame{};
+    int64_t     StartUs{};
+    int64_t     DurationUs{};
+    RenderStats Render{};
+};
+
+int64_t NowUs();
+
+/**
+ * \brief Lock free, callable from any thread. The oldest events are overwritten once the ring is full.
+ */
+void Record(const char* name, int64_t startUs, int64_t durationUs);
+
+class ScopedTimer final
+{
+  public:
+    explicit ScopedTimer(const char* name) : _name{ name }, _startUs{ NowUs() } {}
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ~ScopedTimer() { Stop(); }
+
+    void Stop()
+    {
+        if (_name)
+            {
+                Record(_name, _startUs, NowUs() - _startUs);
+                _name = nullptr;
+            }
+    }
+
+  private:
+    const char* _name{};
+    int64_t     _startUs{};
+};
+
+/**
+ * \brief Frame boundaries, main thread only.
+ */
+void BeginFrame();
+void EndFrame(const RenderStats& renderStats);
+
+/**
+ * \brief The completed frames, oldest first.
+ */
+std::vector<FrameSample> GetFrameSamples();
+
+/**
+ * \brief The events of the last completed frame.
+ */
+std::vector<Event> GetLastFrameEvents();
+
+/**
+ * \brief Writes every event still in the ring as a Chrome trace_event JSON, to open with chrome://tracing or Perfetto.
+ * \return The error string if failed.
+ */
+std::optional<std::string> WriteChromeTrace(const std::string& path);
+
+/**
+ * \brief The size of the static event and frame rings.
+ */
+int64_t GetBufferBytes();
+
+}
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_BEGIN(zone, name) ((void)0)
+#define PROFILE_END(zone) ((void)0)
+
+#endif
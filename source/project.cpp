@@ -23,7 +23,12 @@ SOFTWARE.
 */
 #include "project.hpp"
 
+#include "memory_stats.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <optional>
@@ -43,25 +48,28 @@ SOFTWARE.
       "columns":"4",
       "durationMs":"350"
       "loop":"true"
+      "page":"1"
     }
-    ]
+    ],
+  "pages" : [ "sprite_page1.png" ]
 }
  */
 
 namespace
 {
 std::optional<std::string>
-LoadSpriteTexture(const std::string& imagePath, std::optional<Texture2D>& outTexture)
+LoadSpriteTexture(const std::string& imagePath, std::optional<Texture2D>& outTexture, std::optional<Image>& outImage)
 {
-    Image loadedImg = LoadImage(imagePath.c_str());
+    // Mapped from the image cache when the sprite did not change since it was last decoded
+    RgbaImage loadedImg{ LoadRgbaImage(imagePath) };
     // Failed to open the image!
-    if (loadedImg.data == nullptr)
+    if (loadedImg.Get().data == nullptr)
         {
             return "Failed to open the image!";
         }
 
-    Texture2D newTexture = LoadTextureFromImage(loadedImg);
-    UnloadImage(loadedImg);
+    // The mip levels are generated from the view, the CPU copy keeps the full size image only
+    Texture2D newTexture = LoadMipmappedTexture(loadedImg.Get());
 
     // Failed to allocate the sprite GPU texture!
     if (newTexture.id == 0)
@@ -75,25 +83,50 @@ LoadSpriteTexture(const std::string& imagePath, std::optional<Texture2D>& outTex
             UnloadTexture(outTexture.value());
         }
     outTexture.emplace(std::move(newTexture));
+    if (outImage.has_value())
+        {
+            UnloadImage(outImage.value());
+        }
+    // Keep a RGBA copy on the CPU, hot reload diffs against it
+    outImage.emplace(loadedImg.Release());
 
     // No error
     return {};
 }
 };
 
+Project::~Project()
+{
+    if (SpriteTexture.has_value())
+        {
+            UnloadTexture(SpriteTexture.value());
+        }
+    if (SpriteImage.has_value())
+        {
+            UnloadImage(SpriteImage.value());
+        }
+}
+
+std::string
+Project::GetProjectFilePath() const
+{
+    // Same name of the sprite with the .json extension
+    return std::filesystem::path{ SpritePath }.replace_extension(".json").string();
+}
+
 bool
 Project::SaveToFile() const
 {
+    PROFILE_SCOPE("Project::SaveToFile");
     if (SpritePath.empty())
         return false;
 
     // Write the latest json to file
-    nlohmann::ordered_json j{ SerializeAnimationData() };
+    // Like every json of the editor, copy initialized: a json in braces is wrapped into an array
+    const nlohmann::ordered_json j = SerializeAnimationData();
     try
         {
-            // remove extension from path and add .json
-            const auto    spriteJsonPath{ std::filesystem::path{ SpritePath }.replace_extension(".json").string() };
-            std::ofstream fileStream{ spriteJsonPath };
+            std::ofstream fileStream{ GetProjectFilePath() };
             fileStream << j.dump(4);
             fileStream.close();
             return true;
@@ -110,23 +143,26 @@ Project::SaveToFile() const
 bool
 Project::LoadFromFile(const std::string& filePath)
 {
+    PROFILE_SCOPE("Project::LoadFromFile");
     assert(!filePath.empty());
     assert(!SpriteTexture.has_value()); // Should not have a texture already loaded
 
     std::optional<Texture2D> loadedTexture{};
-    const auto               loadError{ LoadSpriteTexture(filePath, loadedTexture) };
+    std::optional<Image>     loadedImage{};
+    const auto               loadError{ LoadSpriteTexture(filePath, loadedTexture, loadedImage) };
     if (!loadError.has_value())
         {
             SpriteTexture = std::move(loadedTexture.value());
+            SpriteImage   = std::move(loadedImage.value());
             SpritePath    = filePath;
+            ++SpriteImageVersion;
         }
 
     // Try to load the equivalent json with the same name
     nlohmann::ordered_json j{};
     try
         {
-            const auto    spriteJsonPath{ std::filesystem::path{ SpritePath }.replace_extension(".json").string() };
-            std::ifstream fileStream{ spriteJsonPath };
+            std::ifstream fileStream{ GetProjectFilePath() };
             fileStream >> j;
             Deserialize(j);
         }
@@ -146,6 +182,7 @@ Project::LoadFromFile(const std::string& filePath)
 bool
 Project::HasUnsavedChanges()
 {
+    PROFILE_SCOPE("Project::HasUnsavedChanges");
     // Compare latest json vs previous json
     if (_actionsStack.empty())
         {
@@ -156,9 +193,8 @@ Project::HasUnsavedChanges()
     try
         {
             std::ifstream fileStream{};
-            const auto    spriteJsonPath{ std::filesystem::path{ SpritePath }.replace_extension(".json").string() };
             {
-                fileStream.open(spriteJsonPath);
+                fileStream.open(GetProjectFilePath());
                 nlohmann::ordered_json latestJson{};
                 fileStream >> latestJson;
                 fileStream.close();
@@ -175,10 +211,145 @@ Project::HasUnsavedChanges()
     return false;
 }
 
+std::optional<std::string>
+Project::MergeAnimationDataFromFile()
+{
+    PROFILE_SCOPE("Project::MergeAnimationDataFromFile");
+    // Keep the pending edit in the history, the merge replaces the state
+    CommitTransaction();
+    nlohmann::ordered_json j{};
+    try
+        {
+            std::ifstream fileStream{ GetProjectFilePath() };
+            fileStream >> j;
+        }
+    catch (const std::exception& e)
+        {
+            return std::string{ "Failed to reload the project file: " } + e.what();
+        }
+
+    // Our own save or an edit that changed nothing
+    if (j == SerializeAnimationData())
+        {
+            return {};
+        }
+
+    try
+        {
+            // Keep the current selection when still in range, external tools may not know about editor only data
+            const auto numOfAnimations{ static_cast<int32_t>(j.at("animations").size()) };
+            j["selectedAnimationIndex"] = ListState.activeIndex < numOfAnimations ? ListState.activeIndex : -1;
+            Deserialize(j);
+        }
+    catch (const std::exception& e)
+        {
+            // Restore the last known good state
+            if (!_actionsStack.empty())
+                {
+                    Deserialize(_actionsStack.back());
+                }
+            return std::string{ "Failed to merge the project file: " } + e.what();
+        }
+
+    // Undoable like any other edit
+    CommitNewAction();
+    return {};
+}
+
+std::optional<std::string>
+Project::AddPage(const std::string& imagePath)
+{
+    PROFILE_SCOPE("Project::AddPage");
+    int32_t width{};
+    int32_t height{};
+    if (SpritePath.empty() || !ReadImageSize(imagePath, width, height))
+        {
+            return "Failed to open the image!";
+        }
+
+    // Stored relative to the project file so the project can be moved around with its pages
+    const auto projectDir{ std::filesystem::path{ GetProjectFilePath() }.parent_path() };
+    const auto relativePath{ std::filesystem::proximate(imagePath, projectDir).generic_string() };
+    std::error_code errorCode{};
+    if (std::filesystem::equivalent(imagePath, SpritePath, errorCode) || std::find(PagePaths.begin(), PagePaths.end(), relativePath) != PagePaths.end())
+        {
+            return "The image is already a page of the project!";
+        }
+
+    PagePaths.push_back(relativePath);
+    RefreshPageTextures();
+    CommitNewAction();
+    return {};
+}
+
+const Texture2D*
+Project::AcquirePageTexture(int32_t page)
+{
+    if (page == 0)
+        {
+            return SpriteTexture.has_value() ? &SpriteTexture.value() : nullptr;
+        }
+    return page > 0 ? PageTextures.Acquire(static_cast<size_t>(page - 1)) : nullptr;
+}
+
+Vec2
+Project::GetPageSize(int32_t page) const
+{
+    if (page == 0)
+        {
+            return SpriteTexture.has_value() ? Vec2{ SpriteTexture->width, SpriteTexture->height } : Vec2{};
+        }
+    if (page < 0 || static_cast<size_t>(page - 1) >= PageTextures.GetNumPages())
+        {
+            return {};
+        }
+    const auto& cachedPage{ PageTextures.GetPage(static_cast<size_t>(page - 1)) };
+    return { cachedPage.Width, cachedPage.Height };
+}
+
+std::vector<Vec2>
+Project::GetPageSizes() const
+{
+    std::vector<Vec2> sizes{};
+    for (int32_t page{}; page < GetNumPages(); ++page)
+        {
+            sizes.push_back(GetPageSize(page));
+        }
+    return sizes;
+}
+
+EPageResidency
+Project::GetPageResidency(int32_t page) const
+{
+    if (page == 0)
+        {
+            return SpriteTexture.has_value() ? EPageResidency::RESIDENT : EPageResidency::NOT_LOADED;
+        }
+    if (page < 0 || static_cast<size_t>(page - 1) >= PageTextures.GetNumPages())
+        {
+            return EPageResidency::FAILED;
+        }
+    return PageTextures.GetPage(static_cast<size_t>(page - 1)).Residency;
+}
+
+void
+Project::RefreshPageTextures()
+{
+    const auto               projectDir{ std::filesystem::path{ GetProjectFilePath() }.parent_path() };
+    std::vector<std::string> resolvedPaths{};
+    for (const auto& pagePath : PagePaths)
+        {
+            resolvedPaths.push_back((projectDir / pagePath).string());
+        }
+    PageTextures.SetPaths(resolvedPaths);
+}
+
 void
 Project::CommitNewAction()
 {
-    auto newState{ SerializeAnimationData() };
+    PROFILE_SCOPE("Project::CommitNewAction");
+    _transaction = {};
+    auto newState = SerializeAnimationData();
     // Prevent from pushing the same state twice in the stack
     if (!_actionsStack.empty() && _actionsStack.back() == newState)
         {
@@ -198,20 +369,22 @@ Project::CommitNewAction()
 void
 Project::UndoAction()
 {
+    PROFILE_SCOPE("Project::UndoAction");
+    // The open edit is undone as a whole
+    CommitTransaction();
     if (_actionsStack.empty())
         {
             return;
         }
 
     // Remove current state and store it in redo stack
-    auto current{ std::move(_actionsStack.back()) };
+    auto current = std::move(_actionsStack.back());
     _actionsStack.pop_back();
 
     if (!_actionsStack.empty())
         {
             // Restore the previous state (now the last in the actions stack)
-            const auto previous = _actionsStack.back();
-            Deserialize(previous);
+            Deserialize(_actionsStack.back());
         }
     else
         {
@@ -229,11 +402,14 @@ Project::UndoAction()
 void
 Project::RedoAction()
 {
+    PROFILE_SCOPE("Project::RedoAction");
+    // A pending edit is a new action, it drops the redo stack
+    CommitTransaction();
     if (_redoStack.empty())
         {
             return;
         }
-    auto j{ std::move(_redoStack.back()) };
+    auto j = std::move(_redoStack.back());
     _redoStack.pop_back();
 
     Deserialize(j);
@@ -246,16 +422,356 @@ Project::RedoAction()
         }
 }
 
+void
+Project::BeginTransaction(const void* key, double time)
+{
+    assert(key);
+    if (IsInTransaction() && _transaction.Key != key)
+        {
+            CommitTransaction();
+        }
+    _transaction.Key          = key;
+    _transaction.LastEditTime = time;
+}
+
+void
+Project::UpdateTransaction(double time)
+{
+    if (IsInTransaction())
+        {
+            _transaction.LastEditTime = time;
+        }
+}
+
+void
+Project::CommitTransaction()
+{
+    if (IsInTransaction())
+        {
+            CommitNewAction();
+        }
+}
+
+void
+Project::CommitIdleTransaction(double time)
+{
+    if (IsInTransaction() && time - _transaction.LastEditTime >= COALESCE_SECONDS)
+        {
+            CommitTransaction();
+        }
+}
+
+void
+Project::CancelTransaction()
+{
+    PROFILE_SCOPE("Project::CancelTransaction");
+    if (!IsInTransaction())
+        {
+            return;
+        }
+    _transaction = {};
+    // The last action is the state the edit started from, the selection is not part of the edit
+    if (!_actionsStack.empty())
+        {
+            const ListSelection listState{ ListState };
+            Deserialize(_actionsStack.back());
+            if (listState.activeIndex < static_cast<int32_t>(AnimationNameToSpritesheet.size()))
+                {
+                    ListState = listState;
+                    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+                }
+        }
+}
+
+void
+Project::ReportMemory(MemoryReport& report) const
+{
+    PROFILE_SCOPE("Project::ReportMemory");
+    if (SpriteTexture.has_value())
+        {
+            report.AddTexture("gpu/sprite", SpriteTexture.value(), SpritePath);
+        }
+    if (SpriteImage.has_value())
+        {
+            report.AddImage("cpu/sprite_image", SpriteImage.value(), SpritePath);
+        }
+    PageTextures.ReportMemory(report);
+
+    // The map nodes live in the arena, the keyframes are still on the heap
+    report.Add("project/animations", _animationArena.GetReservedBytes(), static_cast<int64_t>(AnimationNameToSpritesheet.size()));
+    report.Add("project/animation_names", AnimationNames.GetBytes(), static_cast<int64_t>(AnimationNames.GetNumSymbols()));
+    report.Add("project/animation_name_index", AnimationNameIndex.GetBytes() + static_cast<int64_t>(AnimationNameWidths.capacity() * sizeof(float)),
+               static_cast<int64_t>(AnimationNameIndex.GetSize()));
+    int64_t keyframeBytes{};
+    for (const auto& [name, animation] : AnimationNameToSpritesheet)
+        {
+            if (const auto* keyframes{ std::get_if<KeyframeUv>(&animation.Data) })
+                {
+                    keyframeBytes += static_cast<int64_t>(keyframes->Keyframes.capacity() * sizeof(KeyframeUv::Keyframe));
+                }
+        }
+    report.Add("project/keyframes", keyframeBytes);
+
+    int64_t pagePathBytes{ static_cast<int64_t>(PagePaths.capacity() * sizeof(std::string)) };
+    for (const auto& pagePath : PagePaths)
+        {
+            pagePathBytes += GetStringHeapBytes(pagePath);
+        }
+    report.Add("project/page_paths", pagePathBytes, static_cast<int64_t>(PagePaths.size()));
+
+    // Every action is a full snapshot of the animation data
+    const auto addHistory = [&report](const char* category, const std::list<nlohmann::ordered_json>& stack) {
+        constexpr int64_t LIST_NODE_BYTES{ 2 * sizeof(void*) + sizeof(nlohmann::ordered_json) };
+        int64_t           bytes{};
+        for (const auto& snapshot : stack)
+            {
+                bytes += LIST_NODE_BYTES + EstimateJsonBytes(snapshot);
+            }
+        report.Add(category, bytes, static_cast<int64_t>(stack.size()));
+    };
+    addHistory("undo/actions", _actionsStack);
+    addHistory("undo/redo", _redoStack);
+
+    report.Add("transient/animation_names",
+               static_cast<int64_t>(ImmutableTransientAnimationNames.capacity() * sizeof(const char*) + ImmutableTransientAnimations.capacity() * sizeof(AnimationMap::iterator)),
+               static_cast<int64_t>(ImmutableTransientAnimationNames.size()));
+}
+
+AnimationMap::iterator
+Project::FindAnimation(std::string_view name)
+{
+    const Symbol symbol{ AnimationNames.Find(name) };
+    return symbol.IsValid() && symbol.Id < _liveSymbols.size() && _liveSymbols[symbol.Id] ? AnimationNameToSpritesheet.find(symbol) : AnimationNameToSpritesheet.end();
+}
+
+bool
+Project::HasAnimation(std::string_view name) const
+{
+    const Symbol symbol{ AnimationNames.Find(name) };
+    return symbol.IsValid() && symbol.Id < _liveSymbols.size() && _liveSymbols[symbol.Id];
+}
+
+int32_t
+Project::AddAnimation(std::string_view name, AnimationData data)
+{
+    // The list index is only needed here, loads emplace directly
+    const auto it{ AnimationNameToSpritesheet.emplace(MarkLive(AnimationNames.Intern(name)), std::move(data)).first };
+    return static_cast<int32_t>(std::distance(AnimationNameToSpritesheet.begin(), it));
+}
+
+Symbol
+Project::MarkLive(Symbol symbol)
+{
+    if (symbol.Id >= _liveSymbols.size())
+        {
+            _liveSymbols.resize(AnimationNames.GetNumSymbols());
+        }
+    _liveSymbols[symbol.Id] = true;
+    return symbol;
+}
+
+void
+Project::RemoveAnimation(Symbol symbol)
+{
+    if (AnimationNameToSpritesheet.erase(symbol) > 0)
+        {
+            _liveSymbols[symbol.Id] = false;
+            SetSymbolSelected(symbol, false);
+        }
+}
+
+bool
+Project::IsSelected(int32_t listIndex) const
+{
+    if (listIndex == ListState.activeIndex)
+        {
+            return true;
+        }
+    const Symbol symbol{ ImmutableTransientAnimations[listIndex]->first };
+    return symbol.Id < _selectedSymbols.size() && _selectedSymbols[symbol.Id];
+}
+
+void
+Project::ToggleSelected(int32_t listIndex)
+{
+    CommitTransaction();
+    const Symbol symbol{ ImmutableTransientAnimations[listIndex]->first };
+    if (!IsSelected(listIndex))
+        {
+            // The previous active animation stays selected
+            if (ListState.activeIndex >= 0)
+                {
+                    SetSymbolSelected(ImmutableTransientAnimations[ListState.activeIndex]->first, true);
+                }
+            SetSymbolSelected(symbol, true);
+            ListState.activeIndex = listIndex;
+        }
+    else
+        {
+            SetSymbolSelected(symbol, false);
+            if (listIndex == ListState.activeIndex)
+                {
+                    const auto next{ std::find_if(ImmutableTransientAnimations.begin(), ImmutableTransientAnimations.end(), [this](AnimationMap::iterator it) {
+                        return it->first.Id < _selectedSymbols.size() && _selectedSymbols[it->first.Id];
+                    }) };
+                    ListState.activeIndex = next == ImmutableTransientAnimations.end() ? -1 : static_cast<int32_t>(next - ImmutableTransientAnimations.begin());
+                }
+        }
+    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+}
+
+void
+Project::SelectRange(int32_t listIndex)
+{
+    CommitTransaction();
+    const int32_t anchor{ ListState.activeIndex < 0 ? listIndex : ListState.activeIndex };
+    for (int32_t i{ std::min(anchor, listIndex) }; i <= std::max(anchor, listIndex); ++i)
+        {
+            SetSymbolSelected(ImmutableTransientAnimations[i]->first, true);
+        }
+    ListState.activeIndex = listIndex;
+    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+}
+
+void
+Project::SelectOnly(int32_t listIndex)
+{
+    CommitTransaction();
+    _selectedSymbols.assign(_selectedSymbols.size(), false);
+    ListState.activeIndex = listIndex;
+    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+}
+
+void
+Project::AddToSelection(const std::vector<int32_t>& listIndices)
+{
+    CommitTransaction();
+    for (const int32_t listIndex : listIndices)
+        {
+            SetSymbolSelected(ImmutableTransientAnimations[listIndex]->first, true);
+        }
+    if (ListState.activeIndex < 0 && !listIndices.empty())
+        {
+            ListState.activeIndex = listIndices.front();
+        }
+    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+}
+
+void
+Project::ClearSelection()
+{
+    SelectOnly(ListState.activeIndex);
+}
+
+void
+Project::SetSymbolSelected(Symbol symbol, bool selected)
+{
+    if (symbol.Id >= _selectedSymbols.size())
+        {
+            _selectedSymbols.resize(AnimationNames.GetNumSymbols());
+        }
+    _selectedSymbols[symbol.Id] = selected;
+}
+
+void
+Project::RefreshSelectedAnimations()
+{
+    SelectedAnimations.clear();
+    for (int32_t i{}; i < static_cast<int32_t>(ImmutableTransientAnimations.size()); ++i)
+        {
+            if (IsSelected(i))
+                {
+                    SelectedAnimations.push_back(ImmutableTransientAnimations[i]);
+                }
+        }
+}
+
+template<typename Function>
+void
+Project::ForEachSelectedSpritesheet(Function&& function)
+{
+    for (const auto it : SelectedAnimations)
+        {
+            if (auto* spriteSheet{ std::get_if<SpritesheetUv>(&it->second.Data) })
+                {
+                    function(*spriteSheet);
+                }
+        }
+}
+
+void
+Project::TranslateSelection(int32_t dx, int32_t dy, double time)
+{
+    PROFILE_SCOPE("Project::TranslateSelection");
+    // Opened before the edit, it commits the edit of another widget first
+    static constexpr char TRANSACTION_KEY{};
+    BeginTransaction(&TRANSACTION_KEY, time);
+    ForEachSelectedSpritesheet([dx, dy](SpritesheetUv& spriteSheet) {
+        spriteSheet.Uv.x += dx;
+        spriteSheet.Uv.y += dy;
+    });
+}
+
+void
+Project::ScaleSelection(float scale, double time)
+{
+    PROFILE_SCOPE("Project::ScaleSelection");
+    static constexpr char TRANSACTION_KEY{};
+    BeginTransaction(&TRANSACTION_KEY, time);
+    const auto scaled = [scale](int32_t value) { return static_cast<int32_t>(std::lround(value * scale)); };
+    ForEachSelectedSpritesheet([&scaled](SpritesheetUv& spriteSheet) {
+        spriteSheet.Uv = { scaled(spriteSheet.Uv.x), scaled(spriteSheet.Uv.y), std::max(1, scaled(spriteSheet.Uv.w)), std::max(1, scaled(spriteSheet.Uv.h)) };
+    });
+}
+
+void
+Project::SetSelectionFrameDuration(int32_t durationMs, double time)
+{
+    PROFILE_SCOPE("Project::SetSelectionFrameDuration");
+    static constexpr char TRANSACTION_KEY{};
+    BeginTransaction(&TRANSACTION_KEY, time);
+    ForEachSelectedSpritesheet([durationMs](SpritesheetUv& spriteSheet) { spriteSheet.Property_FrameDurationMs.Value = durationMs; });
+}
+
+void
+Project::SetSelectionLooping(bool looping, double time)
+{
+    PROFILE_SCOPE("Project::SetSelectionLooping");
+    static constexpr char TRANSACTION_KEY{};
+    BeginTransaction(&TRANSACTION_KEY, time);
+    ForEachSelectedSpritesheet([looping](SpritesheetUv& spriteSheet) { spriteSheet.Looping = looping; });
+}
+
+void
+Project::DeleteSelection()
+{
+    PROFILE_SCOPE("Project::DeleteSelection");
+    CommitTransaction();
+    for (const auto it : SelectedAnimations)
+        {
+            const Symbol symbol{ it->first };
+            AnimationNameToSpritesheet.erase(it);
+            _liveSymbols[symbol.Id] = false;
+            SetSymbolSelected(symbol, false);
+        }
+    ListState.activeIndex = -1;
+    RebuildAnimationNamesVectorAndRefreshPropertyPanel(ListState.activeIndex);
+    CommitNewAction();
+}
+
 void
 Project::Deserialize(const nlohmann::ordered_json& j)
 {
-    // Clear everything
+    PROFILE_SCOPE("Project::Deserialize");
+    // Clear everything, the map nodes are dropped with the arena instead of one by one, the names stay interned
     AnimationNameToSpritesheet.clear();
-    // Deserialize animations
+    _animationArena.Release();
+    _liveSymbols.assign(_liveSymbols.size(), false);
+    // Deserialize animations, the strings are read in place
     for (const auto& animJson : j.at("animations"))
         {
-            const std::string name{ animJson.at("name").get<std::string>() };
-            const std::string type{ animJson.at("type").get<std::string>() };
+            const auto& name{ animJson.at("name").get_ref<const std::string&>() };
+            const auto& type{ animJson.at("type").get_ref<const std::string&>() };
             if (type == "Spritesheet")
                 {
                     SpritesheetUv spriteSheet{};
@@ -267,16 +783,25 @@ Project::Deserialize(const nlohmann::ordered_json& j)
                     spriteSheet.Property_Columns.Value         = animJson.at("columns").get<int32_t>();
                     spriteSheet.Property_FrameDurationMs.Value = animJson.at("durationMs").get<int32_t>();
                     spriteSheet.Looping                        = animJson.at("looping").get<bool>();
+                    spriteSheet.Property_Page.Value            = animJson.value("page", 0);
 
                     AnimationData animData{ std::move(spriteSheet) };
 
-                    AnimationNameToSpritesheet.emplace(name, std::move(animData));
+                    AnimationNameToSpritesheet.emplace(MarkLive(AnimationNames.Intern(name)), std::move(animData));
                 }
             else if (type == "Keyframe")
                 {
                     assert(false && "KEYFRAME not Supported yet!");
                 }
         }
+    // Pages, the textures of the pages still referenced stay resident
+    PagePaths.clear();
+    if (j.contains("pages"))
+        {
+            PagePaths = j.at("pages").get<std::vector<std::string>>();
+        }
+    RefreshPageTextures();
+
     // Editor only data
     const int32_t selectedAnimationIndex{ j.at("selectedAnimationIndex").get<int32_t>() };
     assert(selectedAnimationIndex >= -1 && selectedAnimationIndex < static_cast<int32_t>(AnimationNameToSpritesheet.size()));
@@ -289,13 +814,14 @@ Project::Deserialize(const nlohmann::ordered_json& j)
 nlohmann::ordered_json
 Project::SerializeAnimationData() const
 {
+    PROFILE_SCOPE("Project::SerializeAnimationData");
     nlohmann::ordered_json j{};
     // Serialize animations
     j["animations"] = nlohmann::ordered_json::array();
-    for (const auto& [name, animationData] : AnimationNameToSpritesheet)
+    for (const auto& [symbol, animationData] : AnimationNameToSpritesheet)
         {
             nlohmann::ordered_json animJson{};
-            animJson["name"] = name;
+            animJson["name"] = AnimationNames.GetView(symbol);
             if (std::holds_alternative<SpritesheetUv>(animationData.Data))
                 {
                     const auto& spriteSheet{ std::get<SpritesheetUv>(animationData.Data) };
@@ -308,6 +834,11 @@ Project::SerializeAnimationData() const
                     animJson["columns"]    = spriteSheet.Property_Columns.Value;
                     animJson["durationMs"] = spriteSheet.Property_FrameDurationMs.Value;
                     animJson["looping"]    = spriteSheet.Looping;
+                    // Only written for extra pages, keeps single page projects unchanged
+                    if (spriteSheet.Property_Page.Value != 0)
+                        {
+                            animJson["page"] = spriteSheet.Property_Page.Value;
+                        }
                 }
             else if (std::holds_alternative<KeyframeUv>(animationData.Data))
                 {
@@ -316,6 +847,11 @@ Project::SerializeAnimationData() const
             j["animations"].push_back(animJson);
         }
 
+    if (!PagePaths.empty())
+        {
+            j["pages"] = PagePaths;
+        }
+
     // Editor only data
     j["selectedAnimationIndex"] = ListState.activeIndex;
 
@@ -28,17 +28,25 @@ SOFTWARE.
 
 #include <nlohmann/json.hpp> // Would be better to include it only in cpp, but needed for some definitions here.
 
+#include "arena.hpp"
+#include "frame_layout.hpp"
 #include "geometry.hpp"
+#include "name_index.hpp"
+#include "string_interner.hpp"
+#include "texture_cache.hpp"
 
 #include <cstdint>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <variant>
 #include <vector>
 
+class MemoryReport;
+
 struct Property
 {
     int32_t Value{};
@@ -61,12 +69,22 @@ struct SpritesheetUv
     Property Property_NumOfFrames{ 1 };
     Property Property_Columns{ std::numeric_limits<int32_t>::max() };
     Property Property_FrameDurationMs{ 100 };
+    Property Property_Page{};
     bool     Looping{ true };
 
-#pragma region Internal data
-    Property CurrentFrameIndex{};
-    int64_t  StartTimeMs{};
+    /**
+     * \brief The frame index at the given time of the shared animation clock.
+     */
+    int32_t GetFrameIndexAt(int64_t elapsedMs) const { return frame::IndexAtTime(elapsedMs, Property_NumOfFrames.Value, Property_FrameDurationMs.Value, Looping); }
+    /**
+     * \brief The image space rect of the frame, frames wrap around after the number of columns.
+     */
+    Rect GetFrameRect(int32_t frameIndex) const
+    {
+        return { Uv.x + frame::OffsetX(frameIndex, Property_Columns.Value, Uv.w), Uv.y + frame::OffsetY(frameIndex, Property_Columns.Value, Uv.h), Uv.w, Uv.h };
+    }
 
+#pragma region Internal data
     int32_t DraggingControlIndex{};
     Vec2    DeltaMousePos{};
 #pragma endregion
@@ -89,6 +107,21 @@ struct AnimationData
     AnimationVariant_T Data{ SpritesheetUv{} };
 };
 
+/**
+ * \brief Orders the symbols by their name, equal symbols are equal names thus never compare the strings.
+ */
+struct SymbolNameLess
+{
+    const StringInterner* Names{};
+
+    bool operator()(Symbol a, Symbol b) const { return a != b && Names->GetView(a) < Names->GetView(b); }
+};
+
+/**
+ * \brief Keyed by interned name, still sorted by name so the list order and the saved order do not depend on the interning order.
+ */
+using AnimationMap = std::pmr::map<Symbol, AnimationData, SymbolNameLess>;
+
 // Selection list
 struct ListSelection
 {
@@ -96,6 +129,11 @@ struct ListSelection
     int32_t activeIndex{ -1 };
     int32_t focusIndex{ -1 };
     bool    ShowList{};
+    /**
+     * \brief Search text of the list, empty lists every animation.
+     */
+    char    Filter[32 + 1]{};
+    bool    FilterEditMode{};
 };
 
 class Project
@@ -103,24 +141,96 @@ class Project
   public:
     Project() = default;
     Project(Texture2D sprite, const std::string& filePath);
+    Project(const Project&)            = delete;
+    Project& operator=(const Project&) = delete;
+    ~Project();
     bool SaveToFile() const;
     bool LoadFromFile(const std::string& filePath);
+    /**
+     * \brief The json file path derived from the sprite path.
+     */
+    std::string GetProjectFilePath() const;
+    /**
+     * \brief Reloads the project file changed by an external tool, the result is committed as a new undoable action.
+     * \return The error string if failed, the current state is kept.
+     */
+    std::optional<std::string> MergeAnimationDataFromFile();
+    /**
+     * \brief Adds an atlas page, committed as a new undoable action.
+     * \return The error string if the image can not be read.
+     */
+    std::optional<std::string> AddPage(const std::string& imagePath);
 
-    std::vector<const char*> ImmutableTransientAnimationNames{};
-    void                     RebuildAnimationNamesVectorAndRefreshPropertyPanel(int32_t activeIndex)
+    /**
+     * \brief The names in list order, they point into the interner thus stay valid across rebuilds.
+     */
+    std::vector<const char*>            ImmutableTransientAnimationNames{};
+    /**
+     * \brief The animations in list order, parallel to the names.
+     */
+    std::vector<AnimationMap::iterator> ImmutableTransientAnimations{};
+    /**
+     * \brief The selected animations in list order, the active one included.
+     */
+    std::vector<AnimationMap::iterator> SelectedAnimations{};
+    void                                RebuildAnimationNamesVectorAndRefreshPropertyPanel(int32_t activeIndex)
     {
         ImmutableTransientAnimationNames.clear();
+        ImmutableTransientAnimations.clear();
         ImmutableTransientAnimationNames.reserve(AnimationNameToSpritesheet.size());
-        for (const auto& [name, spriteSheet] : AnimationNameToSpritesheet)
+        ImmutableTransientAnimations.reserve(AnimationNameToSpritesheet.size());
+        for (auto it{ AnimationNameToSpritesheet.begin() }; it != AnimationNameToSpritesheet.end(); ++it)
             {
-                ImmutableTransientAnimationNames.push_back(name.data());
+                ImmutableTransientAnimationNames.push_back(AnimationNames.GetCStr(it->first));
+                ImmutableTransientAnimations.push_back(it);
             }
+        RefreshSelectedAnimations();
 
-        PropertyPanel = activeIndex < 0 ? nullptr : &AnimationNameToSpritesheet.at(ImmutableTransientAnimationNames[activeIndex]);
+        PropertyPanel = activeIndex < 0 ? nullptr : &ImmutableTransientAnimations[activeIndex]->second;
     }
-    std::string                          SpritePath{};
-    std::optional<Texture2D>             SpriteTexture{};
-    std::map<std::string, AnimationData> AnimationNameToSpritesheet{};
+    std::string              SpritePath{};
+    std::optional<Texture2D> SpriteTexture{};
+    /**
+     * \brief RGBA8 CPU copy of the sprite texture.
+     */
+    std::optional<Image>     SpriteImage{};
+    /**
+     * \brief Bumped every time `SpriteImage` is replaced, lets consumers of the pixels skip unchanged frames.
+     */
+    uint64_t                 SpriteImageVersion{};
+    /**
+     * \brief Extra atlas pages relative to the project file, page 0 is always the sprite itself.
+     */
+    std::vector<std::string> PagePaths{};
+    /**
+     * \brief Lazily loaded textures of the extra pages.
+     */
+    TextureCache             PageTextures{};
+
+    /**
+     * \brief The animation names, kept across loads, undo and redo thus a name keeps its symbol for the whole session.
+     */
+    StringInterner     AnimationNames{};
+    /**
+     * \brief Search index of the interned names, the ids are the symbols. Caught up lazily by the animation list.
+     */
+    NameIndex          AnimationNameIndex{};
+    /**
+     * \brief List width of every interned name indexed by symbol, each name is measured once.
+     */
+    std::vector<float> AnimationNameWidths{};
+
+  private:
+    /**
+     * \brief Backs the animation map nodes, released wholesale on every load, undo and redo.
+     * Declared before the map so it outlives it.
+     */
+    Arena             _animationArena{ 64 * 1024 };
+    std::vector<bool> _liveSymbols{};
+    std::vector<bool> _selectedSymbols{};
+
+  public:
+    AnimationMap AnimationNameToSpritesheet{ SymbolNameLess{ &AnimationNames }, _animationArena.Get() };
     /**
      * \brief The currently selected animation for property editing.
      */
@@ -130,18 +240,142 @@ class Project
      */
     ListSelection ListState{};
 
+#pragma region Animations
+    /**
+     * \brief A single hash probe, names that were never interned are rejected without touching the map.
+     */
+    AnimationMap::iterator FindAnimation(std::string_view name);
+    bool                   HasAnimation(std::string_view name) const;
+    std::string_view       GetAnimationName(Symbol symbol) const { return AnimationNames.GetView(symbol); }
+    /**
+     * \brief Adds the animation if the name is not used yet, the transient vectors are not rebuilt.
+     * \return The list index of the animation.
+     */
+    int32_t AddAnimation(std::string_view name, AnimationData data);
+    void    RemoveAnimation(Symbol symbol);
+#pragma endregion
+
+#pragma region Selection
+    // The active animation (ListState.activeIndex) is always part of the selection, the others are kept by symbol across rebuilds.
+    // Every change commits the open edit, an edit never spans two selections.
+    bool IsSelected(int32_t listIndex) const;
+    /**
+     * \brief Ctrl click, the added animation becomes the active one. Removing the active one activates another selected animation.
+     */
+    void ToggleSelected(int32_t listIndex);
+    /**
+     * \brief Shift click, adds the animations from the active one to the index which becomes the active one.
+     */
+    void SelectRange(int32_t listIndex);
+    /**
+     * \brief Plain click, the animation becomes the only selected one.
+     */
+    void SelectOnly(int32_t listIndex);
+    /**
+     * \brief Adds the animations at once, the first one becomes the active one if none is.
+     */
+    void AddToSelection(const std::vector<int32_t>& listIndices);
+    /**
+     * \brief Keeps only the active animation.
+     */
+    void    ClearSelection();
+    int32_t GetNumSelected() const { return static_cast<int32_t>(SelectedAnimations.size()); }
+#pragma endregion
+
+#pragma region Bulk operations
+    // Applied in one pass over the selected sprite sheets as a transaction, repeated steps of the same operation are a single undo step.
+    void TranslateSelection(int32_t dx, int32_t dy, double time);
+    /**
+     * \brief Scales the positions and the sizes, follows an atlas resized by the factor.
+     */
+    void ScaleSelection(float scale, double time);
+    void SetSelectionFrameDuration(int32_t durationMs, double time);
+    void SetSelectionLooping(bool looping, double time);
+    /**
+     * \brief Removes every selected animation as a single undo step.
+     */
+    void DeleteSelection();
+#pragma endregion
+
+#pragma region Pages
+    int32_t GetNumPages() const { return 1 + static_cast<int32_t>(PagePaths.size()); }
+    /**
+     * \brief The texture of the page, marks it as visible this frame.
+     * \return Null while the page is loading or if it failed to load.
+     */
+    const Texture2D* AcquirePageTexture(int32_t page);
+    /**
+     * \brief The page size in pixels, zero if unknown.
+     */
+    Vec2              GetPageSize(int32_t page) const;
+    std::vector<Vec2> GetPageSizes() const;
+    EPageResidency    GetPageResidency(int32_t page) const;
+#pragma endregion
+
     nlohmann::ordered_json SerializeAnimationData() const;
     bool                   HasUnsavedChanges();
 
 #pragma region UndoRedo
+    /**
+     * \brief Pushes the current state as an undo step, closes the open transaction which becomes part of this step.
+     */
     void CommitNewAction();
     void UndoAction();
     void RedoAction();
 #pragma endregion
+
+#pragma region Transactions
+    /**
+     * \brief Edits of the same widget closer than this are merged into a single undo step.
+     */
+    constexpr static double COALESCE_SECONDS{ 1.0 };
+    /**
+     * \brief Opens an edit on the key, the address of the edited value or widget. An edit open on another key is committed first,
+     * while an edit open on the same key continues thus repeated clicks coalesce.
+     * Until the commit the edits are plain in memory updates, nothing is serialized.
+     */
+    void BeginTransaction(const void* key, double time);
+    /**
+     * \brief Keeps the open edit alive, a held widget (a drag, an active value box) calls it every frame.
+     */
+    void UpdateTransaction(double time);
+    /**
+     * \brief Pushes the open edit as a single undo step.
+     */
+    void CommitTransaction();
+    /**
+     * \brief Commits the open edit once it was not updated for COALESCE_SECONDS, called once per frame.
+     */
+    void CommitIdleTransaction(double time);
+    /**
+     * \brief Restores the state from before the open edit, the references into the animation map are invalidated.
+     */
+    void CancelTransaction();
+    bool IsInTransaction() const { return _transaction.Key != nullptr; }
+#pragma endregion
+
+    /**
+     * \brief Adds the textures, the animation data, the undo history and the transient buffers of the project.
+     */
+    void ReportMemory(MemoryReport& report) const;
+
   private:
+    struct Transaction
+    {
+        const void* Key{};
+        double      LastEditTime{};
+    };
+
     constexpr static size_t           MAX_UNDO_ACTIONS{ 100 };
     std::list<nlohmann::ordered_json> _actionsStack{};
     std::list<nlohmann::ordered_json> _redoStack{};
+    Transaction                       _transaction{};
 
-    void Deserialize(const nlohmann::ordered_json& j);
+    void   Deserialize(const nlohmann::ordered_json& j);
+    void   RefreshPageTextures();
+    Symbol MarkLive(Symbol symbol);
+    void   SetSymbolSelected(Symbol symbol, bool selected);
+    void   RefreshSelectedAnimations();
+    template<typename Function>
+    void ForEachSelectedSpritesheet(Function&& function);
 };
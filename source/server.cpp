@@ -0,0 +1,666 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "server.hpp"
+
+#include "batch.hpp"
+#include "content_hash.hpp"
+#include "export.hpp"
+#include "texture_cache.hpp"
+#include "thread_pool.hpp"
+
+#include "raylib.h"
+
+#include <sprite_uv/runtime.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace server
+{
+#if defined(_WIN32)
+
+int
+Run(const Options&)
+{
+    std::cerr << "The server mode needs Unix domain sockets, it is not supported on Windows" << std::endl;
+    return batch::EExitCode::USAGE;
+}
+
+#else
+
+namespace
+{
+// How often the blocking loops check for a stop request
+constexpr int    POLL_TIMEOUT_MS{ 200 };
+// A client not sending new lines must not grow the buffer forever
+constexpr size_t MAX_REQUEST_SIZE{ 1024 * 1024 };
+
+std::atomic<bool> stopRequested{};
+
+void
+OnStopSignal(int)
+{
+    stopRequested = true;
+}
+
+std::vector<FileStamp>
+GetFileStamps(const std::vector<std::filesystem::path>& paths)
+{
+    std::vector<FileStamp> stamps(paths.size());
+    for (size_t i{}; i < paths.size(); ++i)
+        {
+            stamps[i] = GetFileStamp(paths[i]);
+        }
+    return stamps;
+}
+
+/**
+ * \brief What the cached data is derived from: the project file and the page sizes, the pixels are never read.
+ */
+uint64_t
+HashContent(std::string_view projectContent, const std::vector<Vec2>& pageSizes)
+{
+    ContentHasher hasher{};
+    hasher.Update(projectContent);
+    for (const auto& pageSize : pageSizes)
+        {
+            hasher.UpdateValue(pageSize);
+        }
+    return hasher.Digest();
+}
+
+/**
+ * \brief Immutable once loaded, requests keep a reference while the cache replaces it.
+ */
+struct ProjectData
+{
+    batch::LoadedProject Project{};
+    /**
+     * \brief The binary export, empty if the project has validation errors. Frame queries are answered through the runtime reader.
+     */
+    std::vector<uint8_t> Binary{};
+};
+
+struct CacheEntry
+{
+    std::shared_ptr<const ProjectData> Data{};
+    /**
+     * \brief The project file, the sprite then the other pages.
+     */
+    std::vector<std::filesystem::path> Paths{};
+    std::vector<FileStamp>             Stamps{};
+    uint64_t                           ContentHash{};
+};
+
+enum class ECacheResult : uint8_t
+{
+    HIT,
+    /**
+     * \brief The files were touched but their content did not change.
+     */
+    REVALIDATED,
+    MISS,
+};
+
+const char*
+ToString(ECacheResult result)
+{
+    switch (result)
+        {
+            case ECacheResult::HIT: return "hit";
+            case ECacheResult::REVALIDATED: return "revalidated";
+            case ECacheResult::MISS: return "miss";
+        }
+    return "";
+}
+
+nlohmann::ordered_json
+ToJson(const std::vector<ValidationIssue>& issues)
+{
+    auto j = nlohmann::ordered_json::array();
+    for (const auto& issue : issues)
+        {
+            j.push_back(issue.ToString());
+        }
+    return j;
+}
+
+class Server final
+{
+  public:
+    explicit Server(size_t numThreads) : _pool{ numThreads } {}
+
+    int Serve(const std::string& socketPath);
+
+  private:
+    struct Connection
+    {
+        explicit Connection(int fd) : Fd{ fd } {}
+        ~Connection() { ::close(Fd); }
+
+        /**
+         * \brief Thread safe, the lines of concurrent responses are never interleaved.
+         */
+        void Send(const std::string& line)
+        {
+            std::lock_guard<std::mutex> lock{ WriteMutex };
+            for (size_t sent{}; sent < line.size();)
+                {
+                    const ssize_t written{ ::write(Fd, line.data() + sent, line.size() - sent) };
+                    if (written < 0)
+                        {
+                            if (errno == EINTR)
+                                {
+                                    continue;
+                                }
+                            // The client is gone, its remaining responses are dropped
+                            return;
+                        }
+                    sent += static_cast<size_t>(written);
+                }
+        }
+
+        const int  Fd;
+        std::mutex WriteMutex{};
+    };
+
+    void ReadConnection(const std::shared_ptr<Connection>& connection);
+    void Dispatch(const std::shared_ptr<Connection>& connection, std::string line);
+
+    nlohmann::ordered_json HandleRequest(const std::string& line);
+    /**
+     * \brief The cached project of the sprite, reloaded if its files changed.
+     * \return The error string if the project can not be loaded.
+     */
+    std::optional<std::string> Acquire(const std::filesystem::path& spritePath, CacheEntry& outEntry, ECacheResult& outResult);
+
+    ThreadPool _pool;
+
+    std::mutex                                  _cacheMutex{};
+    std::unordered_map<std::string, CacheEntry> _cache{};
+
+    std::mutex              _pendingMutex{};
+    std::condition_variable _pendingDone{};
+    size_t                  _numPending{};
+
+    std::atomic<size_t> _numRequests{};
+    std::atomic<size_t> _numHits{};
+    std::atomic<size_t> _numRevalidated{};
+    std::atomic<size_t> _numMisses{};
+};
+
+int
+Server::Serve(const std::string& socketPath)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "The socket path must be 1 to " << sizeof(address.sun_path) - 1 << " characters long" << std::endl;
+            return batch::EExitCode::USAGE;
+        }
+    socketPath.copy(address.sun_path, socketPath.size());
+
+    // The socket of a previous run that did not shut down would fail the bind, anything else is not ours to remove
+    if (std::error_code errorCode{}; std::filesystem::is_socket(socketPath, errorCode))
+        {
+            ::unlink(socketPath.c_str());
+        }
+    else if (std::filesystem::exists(socketPath, errorCode))
+        {
+            std::cerr << socketPath << " exists and is not a socket" << std::endl;
+            return batch::EExitCode::USAGE;
+        }
+
+    const int listenFd{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, SOMAXCONN) != 0)
+        {
+            std::cerr << "Failed to listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+            if (listenFd >= 0)
+                {
+                    ::close(listenFd);
+                }
+            return batch::EExitCode::FAILURES;
+        }
+
+    std::signal(SIGINT, OnStopSignal);
+    std::signal(SIGTERM, OnStopSignal);
+    // Writing to a client that disconnected must fail instead of killing the server
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cout << "Serving on " << socketPath << " with " << _pool.GetNumThreads() << " threads" << std::endl;
+
+    struct Reader
+    {
+        std::thread                        Thread{};
+        std::shared_ptr<std::atomic<bool>> Done{};
+    };
+    std::vector<Reader> readers{};
+    while (!stopRequested)
+        {
+            pollfd     listenPoll{ listenFd, POLLIN, 0 };
+            const bool readable{ ::poll(&listenPoll, 1, POLL_TIMEOUT_MS) > 0 };
+
+            // Joins the readers of the closed connections
+            for (auto it{ readers.begin() }; it != readers.end();)
+                {
+                    if (*it->Done)
+                        {
+                            it->Thread.join();
+                            it = readers.erase(it);
+                        }
+                    else
+                        {
+                            ++it;
+                        }
+                }
+
+            if (!readable)
+                {
+                    continue;
+                }
+            const int fd{ ::accept(listenFd, nullptr, nullptr) };
+            if (fd < 0)
+                {
+                    continue;
+                }
+            auto connection{ std::make_shared<Connection>(fd) };
+            auto done{ std::make_shared<std::atomic<bool>>(false) };
+            readers.push_back({ std::thread{ [this, connection, done]() {
+                                   ReadConnection(connection);
+                                   *done = true;
+                               } },
+                done });
+        }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    for (auto& reader : readers)
+        {
+            reader.Thread.join();
+        }
+    // The requests already read are answered
+    {
+        std::unique_lock<std::mutex> lock{ _pendingMutex };
+        _pendingDone.wait(lock, [this]() { return _numPending == 0; });
+    }
+
+    std::cout << "Served " << _numRequests << " requests: " << _numHits << " cache hits, " << _numRevalidated << " revalidated, " << _numMisses << " misses" << std::endl;
+    return batch::EExitCode::SUCCESS;
+}
+
+void
+Server::ReadConnection(const std::shared_ptr<Connection>& connection)
+{
+    std::string buffer{};
+    char        chunk[4096];
+    while (!stopRequested)
+        {
+            pollfd readPoll{ connection->Fd, POLLIN, 0 };
+            if (const int numReady{ ::poll(&readPoll, 1, POLL_TIMEOUT_MS) }; numReady <= 0)
+                {
+                    if (numReady < 0 && errno != EINTR)
+                        {
+                            return;
+                        }
+                    continue;
+                }
+            const ssize_t numRead{ ::read(connection->Fd, chunk, sizeof(chunk)) };
+            if (numRead < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+            if (numRead <= 0)
+                {
+                    // A last request without new line is still answered
+                    if (numRead == 0 && !buffer.empty())
+                        {
+                            Dispatch(connection, std::move(buffer));
+                        }
+                    return;
+                }
+            buffer.append(chunk, static_cast<size_t>(numRead));
+
+            size_t lineBegin{};
+            for (size_t newline{ buffer.find('\n') }; newline != std::string::npos; newline = buffer.find('\n', lineBegin))
+                {
+                    std::string line{ buffer.substr(lineBegin, newline - lineBegin) };
+                    lineBegin = newline + 1;
+                    if (!line.empty() && line.back() == '\r')
+                        {
+                            line.pop_back();
+                        }
+                    if (!line.empty())
+                        {
+                            Dispatch(connection, std::move(line));
+                        }
+                }
+            buffer.erase(0, lineBegin);
+            if (buffer.size() > MAX_REQUEST_SIZE)
+                {
+                    connection->Send(R"({"ok":false,"error":"Request too large"})"
+                                     "\n");
+                    return;
+                }
+        }
+}
+
+void
+Server::Dispatch(const std::shared_ptr<Connection>& connection, std::string line)
+{
+    {
+        std::lock_guard<std::mutex> lock{ _pendingMutex };
+        ++_numPending;
+    }
+    _pool.Submit([this, connection, line = std::move(line)]() {
+        connection->Send(HandleRequest(line).dump() + "\n");
+        std::lock_guard<std::mutex> lock{ _pendingMutex };
+        if (--_numPending == 0)
+            {
+                _pendingDone.notify_all();
+            }
+    });
+}
+
+std::optional<std::string>
+Server::Acquire(const std::filesystem::path& spritePath, CacheEntry& outEntry, ECacheResult& outResult)
+{
+    const std::string         key{ spritePath.string() };
+    std::optional<CacheEntry> cached{};
+    {
+        std::lock_guard<std::mutex> lock{ _cacheMutex };
+        if (const auto it{ _cache.find(key) }; it != _cache.end())
+            {
+                cached = it->second;
+            }
+    }
+
+    const auto publish = [&](const CacheEntry& entry, ECacheResult result) {
+        {
+            std::lock_guard<std::mutex> lock{ _cacheMutex };
+            _cache[key] = entry;
+        }
+        outEntry  = entry;
+        outResult = result;
+    };
+
+    const auto projectPath{ std::filesystem::path{ spritePath }.replace_extension(".json") };
+    if (cached.has_value())
+        {
+            auto stamps{ GetFileStamps(cached->Paths) };
+            if (stamps == cached->Stamps)
+                {
+                    outEntry  = std::move(cached.value());
+                    outResult = ECacheResult::HIT;
+                    return {};
+                }
+
+            // A checkout or a save without change touches the files, the content hash keeps the project parsed and validated
+            std::ifstream fileStream{ projectPath, std::ios::binary };
+            if (fileStream)
+                {
+                    const std::string content{ std::istreambuf_iterator<char>{ fileStream }, std::istreambuf_iterator<char>{} };
+                    std::vector<Vec2> pageSizes(cached->Paths.size() - 1);
+                    for (size_t i{}; i < pageSizes.size(); ++i)
+                        {
+                            ReadImageSize(cached->Paths[i + 1].string(), pageSizes[i].x, pageSizes[i].y);
+                        }
+                    if (HashContent(content, pageSizes) == cached->ContentHash)
+                        {
+                            cached->Stamps = std::move(stamps);
+                            publish(cached.value(), ECacheResult::REVALIDATED);
+                            return {};
+                        }
+                }
+        }
+
+    // Stamped before reading, a change made during the load is detected by the next request
+    const FileStamp projectStamp{ GetFileStamp(projectPath) };
+    auto            data{ std::make_shared<ProjectData>() };
+    if (auto loadError{ batch::LoadProject(spritePath, data->Project) }; loadError.has_value())
+        {
+            std::lock_guard<std::mutex> lock{ _cacheMutex };
+            _cache.erase(key);
+            return loadError;
+        }
+    if (!HasValidationErrors(data->Project.Issues))
+        {
+            data->Binary = BuildBinaryExport(data->Project.Json, data->Project.PageSizes);
+        }
+
+    CacheEntry entry{};
+    entry.Paths.push_back(projectPath);
+    entry.Paths.insert(entry.Paths.end(), data->Project.PagePaths.begin(), data->Project.PagePaths.end());
+    entry.Stamps      = GetFileStamps(entry.Paths);
+    entry.Stamps[0]   = projectStamp;
+    entry.ContentHash = HashContent(data->Project.Content, data->Project.PageSizes);
+    entry.Data        = std::move(data);
+    publish(entry, ECacheResult::MISS);
+    return {};
+}
+
+nlohmann::ordered_json
+Server::HandleRequest(const std::string& line)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    ++_numRequests;
+
+    auto       response = nlohmann::ordered_json::object();
+    const auto fail     = [&response](const std::string& error) {
+        response["ok"]    = false;
+        response["error"] = error;
+        return response;
+    };
+
+    const auto request = nlohmann::ordered_json::parse(line, nullptr, false);
+    if (request.is_discarded() || !request.is_object())
+        {
+            return fail("The request must be a json object on a single line");
+        }
+    if (request.contains("id"))
+        {
+            response["id"] = request.at("id");
+        }
+    response["ok"] = false;
+
+    try
+        {
+            const std::string command{ request.value("command", std::string{}) };
+            if (command == "stats")
+                {
+                    std::lock_guard<std::mutex> lock{ _cacheMutex };
+                    response["ok"]          = true;
+                    response["projects"]    = _cache.size();
+                    response["requests"]    = _numRequests.load();
+                    response["hits"]        = _numHits.load();
+                    response["revalidated"] = _numRevalidated.load();
+                    response["misses"]      = _numMisses.load();
+                    response["threads"]     = _pool.GetNumThreads();
+                    return response;
+                }
+            if (command == "shutdown")
+                {
+                    stopRequested  = true;
+                    response["ok"] = true;
+                    return response;
+                }
+            if (command != "validate" && command != "export" && command != "frames")
+                {
+                    return fail("Unknown command '" + command + "', expected validate, export, frames, stats or shutdown");
+                }
+
+            // The same inputs as the batch mode: the sprite or its project file
+            size_t     numSkipped{};
+            const std::string input{ request.value("sprite", std::string{}) };
+            const auto        sprites{ batch::FindProjects({ input }, numSkipped) };
+            if (sprites.size() != 1)
+                {
+                    return fail("No project found for '" + input + "', expected a sprite or a project file");
+                }
+            std::error_code errorCode{};
+            const auto      spritePath{ std::filesystem::weakly_canonical(sprites[0], errorCode) };
+
+            CacheEntry   entry{};
+            ECacheResult cacheResult{};
+            if (const auto loadError{ Acquire(errorCode ? sprites[0] : spritePath, entry, cacheResult) }; loadError.has_value())
+                {
+                    return fail(loadError.value());
+                }
+            switch (cacheResult)
+                {
+                    case ECacheResult::HIT: ++_numHits; break;
+                    case ECacheResult::REVALIDATED: ++_numRevalidated; break;
+                    case ECacheResult::MISS: ++_numMisses; break;
+                }
+
+            const auto& project{ entry.Data->Project };
+            const bool  valid{ !HasValidationErrors(project.Issues) };
+            response["cache"]  = ToString(cacheResult);
+            response["valid"]  = valid;
+            response["issues"] = ToJson(project.Issues);
+            if (command == "validate")
+                {
+                    response["ok"] = true;
+                }
+            else if (!valid)
+                {
+                    fail("The project has validation errors");
+                }
+            else if (command == "export")
+                {
+                    const auto exports{ batch::ParseExportFormats(request.value("formats", std::string{ "binary" })) };
+                    if (!exports.has_value() || exports.value() == 0)
+                        {
+                            return fail("Unknown export format, expected json, binary, header or compact");
+                        }
+                    // The cached projects hold the page sizes only, the page formats would decode every page on every request
+                    if (exports.value() & (batch::EExportFormat::BC1 | batch::EExportFormat::BC3 | batch::EExportFormat::INDEXED))
+                        {
+                            return fail("The bc1, bc3 and indexed formats are exported in batch mode only, expected json, binary, header or compact");
+                        }
+                    std::vector<std::string> outputs{};
+                    const auto               exportError{ batch::ExportProject(project, exports.value(), outputs) };
+                    if (exportError.has_value())
+                        {
+                            fail(exportError.value());
+                        }
+                    else
+                        {
+                            response["ok"] = true;
+                        }
+                    response["outputs"] = outputs;
+                }
+            else
+                {
+                    const auto set{ sprite_uv::AnimationSet::FromMemory(entry.Data->Binary.data(), entry.Data->Binary.size()) };
+                    if (!set.has_value())
+                        {
+                            return fail("Failed to read the binary export");
+                        }
+
+                    const auto toJson = [&set](const sprite_uv::BinaryAnimation& animation) {
+                        nlohmann::ordered_json j{};
+                        j["name"]              = std::string{ set->GetName(animation) };
+                        j["page"]              = animation.Page;
+                        j["looping"]           = set->IsLooping(animation);
+                        j["total_duration_ms"] = animation.TotalDurationMs;
+                        j["frames"]            = nlohmann::ordered_json::array();
+                        // [u0, v0, u1, v1] normalized by the size of the page
+                        for (const auto& uv : set->GetFrames(animation))
+                            {
+                                j["frames"].push_back({ uv.U0, uv.V0, uv.U1, uv.V1 });
+                            }
+                        j["durations_ms"] = nlohmann::ordered_json::array();
+                        for (const uint32_t duration : set->GetDurations(animation))
+                            {
+                                j["durations_ms"].push_back(duration);
+                            }
+                        return j;
+                    };
+
+                    const sprite_uv::BinaryAnimation* requested{};
+                    if (request.contains("animation"))
+                        {
+                            const std::string name{ request.value("animation", std::string{}) };
+                            requested = set->Find(name);
+                            if (!requested)
+                                {
+                                    return fail("No animation named '" + name + "'");
+                                }
+                        }
+
+                    response["ok"]         = true;
+                    response["animations"] = nlohmann::ordered_json::array();
+                    if (requested)
+                        {
+                            response["animations"].push_back(toJson(*requested));
+                        }
+                    else
+                        {
+                            for (const auto& animation : set->GetAnimations())
+                                {
+                                    response["animations"].push_back(toJson(animation));
+                                }
+                        }
+                }
+        }
+    catch (const std::exception& e)
+        {
+            fail(e.what());
+        }
+    response["milliseconds"] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return response;
+}
+}
+
+int
+Run(const Options& options)
+{
+    // Only the problems, the server runs for hours
+    SetTraceLogLevel(LOG_WARNING);
+    Server server{ options.NumThreads };
+    return server.Serve(options.SocketPath);
+}
+
+#endif
+}
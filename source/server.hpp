@@ -0,0 +1,57 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Long lived export server for incremental builds: the projects stay parsed and validated in memory between requests.
+// Newline delimited json over a local Unix domain socket, one request per line and one response line per request:
+//   {"id": 1, "command": "validate", "sprite": "hero.png"}                       -> {"id": 1, "ok": true, "valid": true, "issues": [], "cache": "hit"}
+//   {"id": 2, "command": "export", "sprite": "hero.json", "formats": "binary"}    -> {"id": 2, "ok": true, "outputs": ["hero.uvb"], ...}
+//   {"id": 3, "command": "frames", "sprite": "hero.png", "animation": "Idle"}     -> {"id": 3, "ok": true, "animations": [{"name": "Idle", "frames": [...]}]}
+//   {"id": 4, "command": "stats"} and {"command": "shutdown"}
+// Requests are processed concurrently, even on a single connection, thus responses may come out of order and carry the id of their request.
+// A failed request answers {"ok": false, "error": "..."}. The export formats are json, binary, header and compact, the page formats
+// (bc1, bc3, indexed) decode the pages and are exported by the batch mode only.
+namespace server
+{
+
+struct Options
+{
+    std::string SocketPath{};
+    /**
+     * \brief Zero means one per hardware thread.
+     */
+    size_t      NumThreads{};
+};
+
+/**
+ * \brief Serves until a shutdown request, SIGINT or SIGTERM. Not supported on Windows.
+ * \return The process exit code, see batch::EExitCode.
+ */
+int Run(const Options& options);
+
+}
@@ -0,0 +1,130 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "string_interner.hpp"
+
+#include <sprite_uv/binary_format.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+Symbol
+StringInterner::Intern(std::string_view str)
+{
+    if (const Symbol found{ Find(str) }; found.IsValid())
+        {
+            return found;
+        }
+
+    if ((_strings.size() + 1) * 2 > _slots.size())
+        {
+            Grow();
+        }
+
+    const uint32_t hash{ sprite_uv::binary::HashName(str) };
+    const Symbol   symbol{ static_cast<uint32_t>(_strings.size()) };
+    _strings.emplace_back(Store(str), str.size());
+
+    const size_t mask{ _slots.size() - 1 };
+    size_t       slot{ hash & mask };
+    while (_slots[slot].Id != Symbol::INVALID)
+        {
+            slot = (slot + 1) & mask;
+        }
+    _slots[slot] = { hash, symbol.Id };
+    return symbol;
+}
+
+Symbol
+StringInterner::Find(std::string_view str) const
+{
+    if (_slots.empty())
+        {
+            return {};
+        }
+
+    const uint32_t hash{ sprite_uv::binary::HashName(str) };
+    const size_t   mask{ _slots.size() - 1 };
+    for (size_t slot{ hash & mask };; slot = (slot + 1) & mask)
+        {
+            const Slot& entry{ _slots[slot] };
+            if (entry.Id == Symbol::INVALID)
+                {
+                    return {};
+                }
+            if (entry.Hash == hash && _strings[entry.Id] == str)
+                {
+                    return { entry.Id };
+                }
+        }
+}
+
+int64_t
+StringInterner::GetBytes() const
+{
+    return static_cast<int64_t>(_blockBytes + _strings.capacity() * sizeof(std::string_view) + _slots.capacity() * sizeof(Slot) +
+                                _blocks.capacity() * sizeof(std::unique_ptr<char[]>));
+}
+
+const char*
+StringInterner::Store(std::string_view str)
+{
+    // Room for the terminator, a long string gets a block of its own
+    const size_t bytes{ str.size() + 1 };
+    if (_blockUsed + bytes > _blockCapacity)
+        {
+            _blockCapacity = std::max(BLOCK_BYTES, bytes);
+            _blockUsed     = 0;
+            _blocks.push_back(std::make_unique<char[]>(_blockCapacity));
+            _blockBytes += _blockCapacity;
+        }
+
+    char* storage{ _blocks.back().get() + _blockUsed };
+    std::memcpy(storage, str.data(), str.size());
+    storage[str.size()] = '\0';
+    _blockUsed += bytes;
+    return storage;
+}
+
+void
+StringInterner::Grow()
+{
+    // Rehash from the stored hashes, the strings are not touched
+    std::vector<Slot> slots(_slots.empty() ? 64 : _slots.size() * 2);
+    const size_t      mask{ slots.size() - 1 };
+    for (const Slot& entry : _slots)
+        {
+            if (entry.Id == Symbol::INVALID)
+                {
+                    continue;
+                }
+            size_t slot{ entry.Hash & mask };
+            while (slots[slot].Id != Symbol::INVALID)
+                {
+                    slot = (slot + 1) & mask;
+                }
+            slots[slot] = entry;
+        }
+    _slots = std::move(slots);
+}
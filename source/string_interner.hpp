@@ -0,0 +1,98 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief Small integer handle of an interned string, equal symbols are equal strings.
+ */
+struct Symbol
+{
+    constexpr static uint32_t INVALID{ ~0u };
+    uint32_t                  Id{ INVALID };
+
+    constexpr bool IsValid() const { return Id != INVALID; }
+    constexpr bool operator==(Symbol other) const { return Id == other.Id; }
+    constexpr bool operator!=(Symbol other) const { return Id != other.Id; }
+};
+
+/**
+ * \brief Deduplicated string storage, every distinct string is stored once and never moves thus its C string can be handed out.
+ * Strings are never removed, the table only grows with the distinct names seen during the session.
+ * The hash is the FNV-1a of the runtime export, the one of the exported lookup table.
+ */
+class StringInterner final
+{
+  public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&)            = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * \brief The symbol of the string, the string is copied on first use.
+     */
+    Symbol Intern(std::string_view str);
+    /**
+     * \brief Single hash probe, does not intern.
+     * \return An invalid symbol if the string was never interned.
+     */
+    Symbol Find(std::string_view str) const;
+
+    std::string_view GetView(Symbol symbol) const { return _strings[symbol.Id]; }
+    /**
+     * \brief Null terminated, valid as long as the interner.
+     */
+    const char* GetCStr(Symbol symbol) const { return _strings[symbol.Id].data(); }
+    size_t      GetNumSymbols() const { return _strings.size(); }
+    /**
+     * \brief The character blocks, the views and the hash table.
+     */
+    int64_t GetBytes() const;
+
+  private:
+    constexpr static size_t BLOCK_BYTES{ 16 * 1024 };
+
+    struct Slot
+    {
+        uint32_t Hash{};
+        uint32_t Id{ Symbol::INVALID };
+    };
+
+    // Open addressing with linear probing, power of two capacity with a load factor of at most 50%
+    std::vector<Slot>                    _slots{};
+    std::vector<std::string_view>        _strings{};
+    std::vector<std::unique_ptr<char[]>> _blocks{};
+    size_t                               _blockBytes{};
+    size_t                               _blockUsed{};
+    size_t                               _blockCapacity{};
+
+    const char* Store(std::string_view str);
+    void        Grow();
+};
@@ -0,0 +1,188 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "text_layout.hpp"
+
+#include "content_hash.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+/**
+ * \brief raylib scales the default font from this size, and spaces its glyphs by a pixel per multiple of it.
+ */
+constexpr int DEFAULT_FONT_SIZE{ 10 };
+
+uint64_t
+HashKey(const Font& font, float fontSize, float spacing, std::string_view text)
+{
+    ContentHasher hasher{};
+    hasher.UpdateValue(font.texture.id);
+    hasher.UpdateValue(font.baseSize);
+    hasher.UpdateValue(font.glyphCount);
+    hasher.UpdateValue(fontSize);
+    hasher.UpdateValue(spacing);
+    hasher.Update(text);
+    return hasher.Digest();
+}
+
+/**
+ * \brief The pen walk of DrawTextEx up to the first line break, the text must be null terminated for GetCodepointNext.
+ */
+void
+Layout(const Font& font, float fontSize, float spacing, const std::string& text, TextRun& run)
+{
+    run = {};
+    if (font.glyphCount <= 0 || !font.glyphs || !font.recs || font.baseSize <= 0)
+        {
+            return;
+        }
+
+    const float scale{ fontSize / font.baseSize };
+    for (size_t i{}; i < text.size() && text[i] != '\n';)
+        {
+            int       codepointSize{};
+            const int codepoint{ GetCodepointNext(text.c_str() + i, &codepointSize) };
+            const int index{ GetGlyphIndex(font, codepoint) };
+            if (codepoint != ' ' && codepoint != '\t')
+                {
+                    run.Glyphs.push_back({ index, run.Advance });
+                }
+            const float advance{ font.glyphs[index].advanceX == 0 ? font.recs[index].width : static_cast<float>(font.glyphs[index].advanceX) };
+            run.Advance += advance * scale + spacing;
+            i += static_cast<size_t>(std::max(codepointSize, 1));
+        }
+    run.Size = { std::max(0.f, run.Advance - spacing), fontSize };
+}
+
+}
+
+TextLayoutCache&
+TextLayoutCache::Shared()
+{
+    static TextLayoutCache cache{};
+    return cache;
+}
+
+const TextRun&
+TextLayoutCache::GetRun(const Font& font, float fontSize, float spacing, std::string_view text)
+{
+    const auto [it, inserted]{ _runs.try_emplace(HashKey(font, fontSize, spacing, text)) };
+    Entry& entry{ it->second };
+    if (!inserted && entry.Text == text && entry.FontId == font.texture.id && entry.FontSize == fontSize && entry.Spacing == spacing)
+        {
+            return entry.Run;
+        }
+
+    // New text, or a hash collision that replaces the previous run
+    entry.FontId   = font.texture.id;
+    entry.FontSize = fontSize;
+    entry.Spacing  = spacing;
+    entry.Text.assign(text);
+    Layout(font, fontSize, spacing, entry.Text, entry.Run);
+    ++_measurements;
+    return entry.Run;
+}
+
+TextRun
+TextLayoutCache::LayoutUncached(const Font& font, float fontSize, float spacing, std::string_view text)
+{
+    TextRun run{};
+    Layout(font, fontSize, spacing, std::string{ text }, run);
+    ++_measurements;
+    return run;
+}
+
+void
+TextLayoutCache::Clear()
+{
+    _runs.clear();
+    ++_generation;
+}
+
+void
+TextLayoutCache::EndFrame()
+{
+    if (_runs.size() > MAX_RUNS)
+        {
+            _runs.clear();
+        }
+    _frameMeasurements = _measurements;
+    _measurements      = 0;
+}
+
+int64_t
+TextLayoutCache::GetBytes() const
+{
+    int64_t bytes{ static_cast<int64_t>(_runs.bucket_count() * sizeof(void*)) };
+    for (const auto& [key, entry] : _runs)
+        {
+            bytes += static_cast<int64_t>(sizeof(key) + sizeof(entry) + entry.Text.capacity() + entry.Run.Glyphs.capacity() * sizeof(TextRun::Glyph));
+        }
+    return bytes;
+}
+
+void
+DrawTextRun(const Font& font, const TextRun& run, Vector2 position, float fontSize, Color tint)
+{
+    if (font.baseSize <= 0)
+        {
+            return;
+        }
+
+    // The quads of DrawTextCodepoint, the padding keeps the filtered edges of the glyphs
+    const float scale{ fontSize / font.baseSize };
+    const float padding{ static_cast<float>(font.glyphPadding) };
+    for (const TextRun::Glyph& glyph : run.Glyphs)
+        {
+            const Rectangle& rec{ font.recs[glyph.Index] };
+            const GlyphInfo& info{ font.glyphs[glyph.Index] };
+            const Rectangle  source{ rec.x - padding, rec.y - padding, rec.width + padding * 2, rec.height + padding * 2 };
+            const Rectangle  dest{ position.x + glyph.X + (info.offsetX - padding) * scale, position.y + (info.offsetY - padding) * scale, source.width * scale,
+                                  source.height * scale };
+            DrawTexturePro(font.texture, source, dest, {}, 0.f, tint);
+        }
+}
+
+int
+MeasureTextCached(const char* text, int fontSize)
+{
+    const int size{ std::max(fontSize, DEFAULT_FONT_SIZE) };
+    return static_cast<int>(TextLayoutCache::Shared().GetRun(GetFontDefault(), static_cast<float>(size), static_cast<float>(size / DEFAULT_FONT_SIZE), text).Size.x);
+}
+
+void
+DrawTextCached(const char* text, int posX, int posY, int fontSize, Color color)
+{
+    const Font font{ GetFontDefault() };
+    if (font.texture.id == 0)
+        {
+            return;
+        }
+    const int      size{ std::max(fontSize, DEFAULT_FONT_SIZE) };
+    const TextRun& run{ TextLayoutCache::Shared().GetRun(font, static_cast<float>(size), static_cast<float>(size / DEFAULT_FONT_SIZE), text) };
+    DrawTextRun(font, run, { static_cast<float>(posX), static_cast<float>(posY) }, static_cast<float>(size), color);
+}
@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "raylib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief The first line of a text laid out for a font, a size and a spacing.
+ * The glyphs are resolved once, drawing does not search the font for every codepoint again.
+ */
+struct TextRun
+{
+    struct Glyph
+    {
+        int32_t Index{};
+        /**
+         * \brief Pen position of the glyph from the start of the line.
+         */
+        float   X{};
+    };
+
+    /**
+     * \brief The visible glyphs, blanks only advance the pen.
+     */
+    std::vector<Glyph> Glyphs{};
+    /**
+     * \brief Pen position after the last glyph, the spacing follows every glyph as in raygui GetTextWidth.
+     */
+    float              Advance{};
+    /**
+     * \brief The size MeasureTextEx returns, no spacing after the last glyph.
+     */
+    Vector2            Size{};
+};
+
+/**
+ * \brief Runs keyed by font, size, spacing and text, the static labels are laid out once instead of every frame.
+ * The runs stay valid until the font or the style changes, the cache is then cleared by the caller.
+ */
+class TextLayoutCache final
+{
+  public:
+    /**
+     * \brief Dropped wholesale when exceeded, a frame only draws a few hundred distinct strings.
+     */
+    constexpr static size_t MAX_RUNS{ 4096 };
+
+    static TextLayoutCache& Shared();
+
+    /**
+     * \brief The run of the text, laid out on the first use. Valid until the next call.
+     */
+    const TextRun& GetRun(const Font& font, float fontSize, float spacing, std::string_view text);
+    /**
+     * \brief Lays out without keeping the run, for the text the caller caches on its own.
+     */
+    TextRun        LayoutUncached(const Font& font, float fontSize, float spacing, std::string_view text);
+
+    /**
+     * \brief To call when a font or the text style changes, the texture id of an unloaded font is reused.
+     */
+    void     Clear();
+    /**
+     * \brief Bumped by Clear, the widths cached outside are measured again when it changes.
+     */
+    uint32_t GetGeneration() const { return _generation; }
+
+    /**
+     * \brief Trims the runs over the budget and closes the measurement count of the frame.
+     */
+    void    EndFrame();
+    /**
+     * \brief Texts laid out during the last frame, zero once the labels are cached.
+     */
+    int32_t GetFrameMeasurements() const { return _frameMeasurements; }
+    size_t  GetNumRuns() const { return _runs.size(); }
+    int64_t GetBytes() const;
+
+  private:
+    struct Entry
+    {
+        uint32_t    FontId{};
+        float       FontSize{};
+        float       Spacing{};
+        std::string Text{};
+        TextRun     Run{};
+    };
+
+    std::unordered_map<uint64_t, Entry> _runs{};
+    uint32_t                            _generation{};
+    int32_t                             _measurements{};
+    int32_t                             _frameMeasurements{};
+};
+
+/**
+ * \brief DrawTextEx from a laid out run, the same glyph quads.
+ */
+void DrawTextRun(const Font& font, const TextRun& run, Vector2 position, float fontSize, Color tint);
+
+/**
+ * \brief MeasureText and DrawText of the default font through the shared cache, for single lines.
+ */
+int  MeasureTextCached(const char* text, int fontSize);
+void DrawTextCached(const char* text, int posX, int posY, int fontSize, Color color);
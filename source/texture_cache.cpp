@@ -0,0 +1,364 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "texture_cache.hpp"
+
+#include "memory_stats.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+EMipFilter mipFilter{ EMipFilter::BOX };
+// Filter last set on the textures created by LoadMipmappedTexture, by texture id
+std::unordered_map<uint32_t, int32_t> textureFilters{};
+
+uint32_t
+ReadBigEndianU32(const unsigned char* bytes)
+{
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) | (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+}
+
+RgbaImage::RgbaImage(MappedImage mappedImage)
+    : _mappedImage{ std::move(mappedImage) }
+{
+    // Only read by the upload
+    _image.data    = const_cast<uint8_t*>(_mappedImage->GetPixels());
+    _image.width   = _mappedImage->GetWidth();
+    _image.height  = _mappedImage->GetHeight();
+    _image.mipmaps = 1;
+    _image.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+}
+
+RgbaImage&
+RgbaImage::operator=(RgbaImage&& other) noexcept
+{
+    if (this != &other)
+        {
+            Reset();
+            std::swap(_image, other._image);
+            std::swap(_mappedImage, other._mappedImage);
+        }
+    return *this;
+}
+
+Image
+RgbaImage::Release()
+{
+    const Image image{ _mappedImage.has_value() ? ImageCopy(_image) : _image };
+    if (!_mappedImage.has_value())
+        {
+            _image = {};
+        }
+    Reset();
+    return image;
+}
+
+void
+RgbaImage::Reset()
+{
+    if (!_mappedImage.has_value() && _image.data)
+        {
+            UnloadImage(_image);
+        }
+    _mappedImage.reset();
+    _image = {};
+}
+
+RgbaImage
+LoadRgbaImage(const std::string& imagePath)
+{
+    PROFILE_SCOPE("LoadRgbaImage");
+    ImageCache& imageCache{ ImageCache::Shared() };
+    // The hit and miss timings are in the cache stats, shown by the memory panel
+    if (auto mappedImage{ imageCache.Find(imagePath) }; mappedImage.has_value())
+        {
+            return RgbaImage{ std::move(mappedImage.value()) };
+        }
+
+    const auto      start{ std::chrono::steady_clock::now() };
+    const FileStamp sourceStamp{ GetFileStamp(imagePath) };
+    Image           image = LoadImage(imagePath.c_str());
+    if (!image.data)
+        {
+            return {};
+        }
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    const double decodeMilliseconds{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() };
+    // A failed store only costs a decode next time
+    imageCache.Store(imagePath, sourceStamp, static_cast<const uint8_t*>(image.data), image.width, image.height, decodeMilliseconds);
+    return RgbaImage{ image };
+}
+
+void
+SetMipFilter(EMipFilter filter)
+{
+    mipFilter = filter;
+}
+
+EMipFilter
+GetMipFilter()
+{
+    return mipFilter;
+}
+
+Image
+GenerateMipmaps(const Image& image)
+{
+    if (mipFilter == EMipFilter::NONE || !image.data)
+        {
+            return {};
+        }
+    PROFILE_SCOPE("GenerateMipmaps");
+    const int32_t numLevels{ GetNumMipLevels(image.width, image.height) };
+    Image         mipmapped{};
+    // Allocated by raylib so UnloadImage releases it
+    mipmapped.data    = MemAlloc(static_cast<unsigned int>(GetMipChainBytes(image.width, image.height, numLevels)));
+    mipmapped.width   = image.width;
+    mipmapped.height  = image.height;
+    mipmapped.mipmaps = numLevels;
+    mipmapped.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    std::memcpy(mipmapped.data, image.data, static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4);
+    GenerateMipChain(static_cast<uint8_t*>(mipmapped.data), image.width, image.height, numLevels, mipFilter);
+    return mipmapped;
+}
+
+Texture2D
+LoadMipmappedTexture(const Image& image)
+{
+    Image     mipmapped = image.mipmaps > 1 ? Image{} : GenerateMipmaps(image);
+    Texture2D texture   = LoadTextureFromImage(mipmapped.data ? mipmapped : image);
+    if (mipmapped.data)
+        {
+            UnloadImage(mipmapped);
+        }
+    if (texture.id != 0)
+        {
+            // The default filter depends on the graphics API, a reused id must not keep the filter of the deleted texture
+            SetTrackedTextureFilter(texture, TEXTURE_FILTER_POINT);
+        }
+    return texture;
+}
+
+int32_t
+GetTextureFilter(const Texture2D& texture)
+{
+    const auto found{ textureFilters.find(texture.id) };
+    return found != textureFilters.end() ? found->second : TEXTURE_FILTER_POINT;
+}
+
+void
+SetTrackedTextureFilter(const Texture2D& texture, int32_t filter)
+{
+    SetTextureFilter(texture, filter);
+    textureFilters[texture.id] = filter;
+}
+
+bool
+ReadImageSize(const std::string& imagePath, int32_t& outWidth, int32_t& outHeight)
+{
+    // PNG: signature then the IHDR chunk holding the size
+    constexpr unsigned char PNG_SIGNATURE[8]{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    unsigned char           header[24]{};
+    {
+        std::ifstream fileStream{ imagePath, std::ios::binary };
+        if (!fileStream)
+            {
+                return false;
+            }
+        fileStream.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (fileStream.gcount() == sizeof(header) && std::memcmp(header, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0 && std::memcmp(header + 12, "IHDR", 4) == 0)
+            {
+                outWidth  = static_cast<int32_t>(ReadBigEndianU32(header + 16));
+                outHeight = static_cast<int32_t>(ReadBigEndianU32(header + 20));
+                return outWidth > 0 && outHeight > 0;
+            }
+    }
+
+    // Other formats are rare for atlas pages, pay the decode once
+    Image image = LoadImage(imagePath.c_str());
+    if (!image.data)
+        {
+            return false;
+        }
+    outWidth  = image.width;
+    outHeight = image.height;
+    UnloadImage(image);
+    return true;
+}
+
+TextureCache::~TextureCache()
+{
+    Clear();
+}
+
+void
+TextureCache::SetPaths(const std::vector<std::string>& paths)
+{
+    std::vector<Page> pages(paths.size());
+    for (size_t i{}; i < paths.size(); ++i)
+        {
+            const auto existing{ std::find_if(_pages.begin(), _pages.end(), [&](const Page& page) { return page.Path == paths[i] && !page.Path.empty(); }) };
+            if (existing != _pages.end())
+                {
+                    pages[i] = std::move(*existing);
+                    // A moved optional stays engaged, the texture now belongs to the new page
+                    existing->Path.clear();
+                    existing->Texture.reset();
+                    continue;
+                }
+            pages[i].Path = paths[i];
+            if (!ReadImageSize(paths[i], pages[i].Width, pages[i].Height))
+                {
+                    pages[i].Residency = EPageResidency::FAILED;
+                }
+        }
+
+    // Pages no longer referenced
+    for (auto& page : _pages)
+        {
+            Unload(page);
+        }
+    _pages = std::move(pages);
+}
+
+void
+TextureCache::Clear()
+{
+    for (auto& page : _pages)
+        {
+            Unload(page);
+        }
+    _pages.clear();
+}
+
+const Texture2D*
+TextureCache::Acquire(size_t pageIndex)
+{
+    if (pageIndex >= _pages.size())
+        {
+            return nullptr;
+        }
+
+    Page& page{ _pages[pageIndex] };
+    page.LastUsedFrame = _frame;
+    if (page.Residency == EPageResidency::NOT_LOADED)
+        {
+            page.Residency    = EPageResidency::LOADING;
+            page.PendingImage = std::async(std::launch::async, [path = page.Path]() {
+                RgbaImage image{ LoadRgbaImage(path) };
+                Image     mipmapped = GenerateMipmaps(image.Get());
+                return mipmapped.data ? RgbaImage{ mipmapped } : std::move(image);
+            });
+        }
+    return page.Texture.has_value() ? &page.Texture.value() : nullptr;
+}
+
+void
+TextureCache::Update()
+{
+    PROFILE_SCOPE("TextureCache::Update");
+    // Upload the decoded pages, GL calls must stay on the main thread
+    for (auto& page : _pages)
+        {
+            if (page.Residency != EPageResidency::LOADING || page.PendingImage.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    continue;
+                }
+            // Without mip levels a mapped page is uploaded straight from the image cache
+            const RgbaImage image{ page.PendingImage.get() };
+            if (!image.Get().data)
+                {
+                    page.Residency = EPageResidency::FAILED;
+                    continue;
+                }
+            Texture2D texture = LoadMipmappedTexture(image.Get());
+            if (texture.id == 0)
+                {
+                    page.Residency = EPageResidency::FAILED;
+                    continue;
+                }
+            page.Width     = texture.width;
+            page.Height    = texture.height;
+            page.Texture   = texture;
+            page.Residency = EPageResidency::RESIDENT;
+            _residentBytes += GetTextureBytes(texture);
+        }
+
+    // Evict the least recently used pages, the ones visible during the last frame are kept even over budget
+    while (_residentBytes > _budgetBytes)
+        {
+            Page* leastRecentlyUsed{};
+            for (auto& page : _pages)
+                {
+                    if (page.Residency == EPageResidency::RESIDENT && page.LastUsedFrame < _frame && (!leastRecentlyUsed || page.LastUsedFrame < leastRecentlyUsed->LastUsedFrame))
+                        {
+                            leastRecentlyUsed = &page;
+                        }
+                }
+            if (!leastRecentlyUsed)
+                {
+                    break;
+                }
+            Unload(*leastRecentlyUsed);
+        }
+
+    ++_frame;
+}
+
+void
+TextureCache::ReportMemory(MemoryReport& report) const
+{
+    for (const auto& page : _pages)
+        {
+            if (page.Texture.has_value())
+                {
+                    report.AddTexture("gpu/pages", page.Texture.value(), page.Path);
+                }
+        }
+}
+
+void
+TextureCache::Unload(Page& page)
+{
+    if (page.PendingImage.valid())
+        {
+            page.PendingImage.get();
+        }
+    if (page.Texture.has_value())
+        {
+            _residentBytes -= GetTextureBytes(page.Texture.value());
+            UnloadTexture(page.Texture.value());
+            page.Texture.reset();
+        }
+    if (page.Residency != EPageResidency::FAILED)
+        {
+            page.Residency = EPageResidency::NOT_LOADED;
+        }
+}
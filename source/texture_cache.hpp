@@ -0,0 +1,178 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "image_cache.hpp"
+#include "mip_pyramid.hpp"
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+class MemoryReport;
+
+enum class EPageResidency : uint8_t
+{
+    NOT_LOADED,
+    LOADING,
+    RESIDENT,
+    FAILED,
+};
+
+/**
+ * \brief Reads the image size without decoding the pixels when the format allows it (PNG), otherwise decodes it.
+ * \return False if the file can not be read.
+ */
+bool ReadImageSize(const std::string& imagePath, int32_t& outWidth, int32_t& outHeight);
+
+/**
+ * \brief An RGBA8 image, decoded or mapped from the image cache without a copy.
+ */
+class RgbaImage final
+{
+  public:
+    RgbaImage() = default;
+    explicit RgbaImage(Image image)
+        : _image{ image }
+    {
+    }
+    explicit RgbaImage(MappedImage mappedImage);
+    RgbaImage(const RgbaImage&)            = delete;
+    RgbaImage& operator=(const RgbaImage&) = delete;
+    RgbaImage(RgbaImage&& other) noexcept { *this = std::move(other); }
+    RgbaImage& operator=(RgbaImage&& other) noexcept;
+    ~RgbaImage() { Reset(); }
+
+    /**
+     * \brief Valid while this object lives, the pixels of a mapped image are read only.
+     */
+    const Image& Get() const { return _image; }
+    bool         IsMapped() const { return _mappedImage.has_value(); }
+
+    /**
+     * \brief The image owned by the caller, a mapped image is copied.
+     */
+    Image Release();
+    void  Reset();
+
+  private:
+    Image                      _image{};
+    std::optional<MappedImage> _mappedImage{};
+};
+
+/**
+ * \brief Decodes the image as RGBA8 through the shared image cache: a cached image is mapped, a decoded one is stored for the next time.
+ * \return A null image if the file can not be decoded.
+ */
+RgbaImage LoadRgbaImage(const std::string& imagePath);
+
+/**
+ * \brief Filter of the mip levels generated for the sprite and the pages, NONE uploads them without mipmaps.
+ * Not thread safe, to be set before the first image is loaded.
+ */
+void       SetMipFilter(EMipFilter filter);
+EMipFilter GetMipFilter();
+
+/**
+ * \brief A copy of the RGBA8 image followed by its mip levels, owned by the caller.
+ * \return A null image when the mip filter is NONE.
+ */
+Image GenerateMipmaps(const Image& image);
+
+/**
+ * \brief Uploads the image with its mip levels, generated first if the image has none. The sprite and the pages are created with it so their
+ * filter is tracked.
+ */
+Texture2D LoadMipmappedTexture(const Image& image);
+
+/**
+ * \brief The filter last set on a texture created by LoadMipmappedTexture, changing it only costs a lookup when it is already set.
+ */
+int32_t GetTextureFilter(const Texture2D& texture);
+void    SetTrackedTextureFilter(const Texture2D& texture, int32_t filter);
+
+/**
+ * \brief Texture pages decoded and uploaded on first use, kept in a GPU memory budget.
+ * Pages not used during the last frame are evicted least recently used first once the budget is exceeded.
+ */
+class TextureCache final
+{
+  public:
+    constexpr static int64_t DEFAULT_BUDGET_BYTES{ 256ll * 1024 * 1024 };
+
+    struct Page
+    {
+        std::string              Path{};
+        int32_t                  Width{};
+        int32_t                  Height{};
+        EPageResidency           Residency{ EPageResidency::NOT_LOADED };
+        std::optional<Texture2D> Texture{};
+        uint64_t                 LastUsedFrame{};
+        /**
+         * \brief Decoded with its mip levels on the worker.
+         */
+        std::future<RgbaImage>   PendingImage{};
+    };
+
+    TextureCache() = default;
+    TextureCache(const TextureCache&)            = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    ~TextureCache();
+
+    /**
+     * \brief Replaces the pages, the ones with the same path keep their texture.
+     */
+    void SetPaths(const std::vector<std::string>& paths);
+    void Clear();
+
+    /**
+     * \brief Marks the page as visible this frame and starts loading it if needed.
+     * \return The texture if resident, null while loading or if the load failed.
+     */
+    const Texture2D* Acquire(size_t pageIndex);
+
+    /**
+     * \brief Must be called once per frame from the main thread: uploads the decoded pages and evicts over budget.
+     */
+    void Update();
+
+    size_t      GetNumPages() const { return _pages.size(); }
+    const Page& GetPage(size_t pageIndex) const { return _pages[pageIndex]; }
+    int64_t     GetResidentBytes() const { return _residentBytes; }
+    int64_t     GetBudgetBytes() const { return _budgetBytes; }
+    void        SetBudgetBytes(int64_t budgetBytes) { _budgetBytes = budgetBytes; }
+    void        ReportMemory(MemoryReport& report) const;
+
+  private:
+    std::vector<Page> _pages{};
+    uint64_t          _frame{ 1 };
+    int64_t           _residentBytes{};
+    int64_t           _budgetBytes{ DEFAULT_BUDGET_BYTES };
+
+    void Unload(Page& page);
+};
@@ -0,0 +1,515 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "texture_compression.hpp"
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+/**
+ * \brief Planar copy of a 4x4 block, the index search compares 4 pixels at once.
+ */
+struct alignas(16) BlockPixels
+{
+    float R[16];
+    float G[16];
+    float B[16];
+    float A[16];
+};
+
+struct ColorBlock
+{
+    uint16_t C0{};
+    uint16_t C1{};
+    uint8_t  Indices[16]{};
+    float    Error{ FLT_MAX };
+};
+
+void
+LoadBlock(const uint8_t* rgba, int32_t width, int32_t height, int32_t blockX, int32_t blockY, BlockPixels& outBlock)
+{
+    for (int32_t i{}; i < 16; ++i)
+        {
+            const int32_t  x{ std::min(blockX * BLOCK_DIMENSION + (i & 3), width - 1) };
+            const int32_t  y{ std::min(blockY * BLOCK_DIMENSION + (i >> 2), height - 1) };
+            const uint8_t* pixel{ rgba + (static_cast<size_t>(y) * width + x) * 4 };
+            outBlock.R[i] = pixel[0];
+            outBlock.G[i] = pixel[1];
+            outBlock.B[i] = pixel[2];
+            outBlock.A[i] = pixel[3];
+        }
+}
+
+uint16_t
+To565(const float color[3])
+{
+    const auto quantize = [](float value, int32_t maxValue) { return std::clamp(static_cast<int32_t>(value * maxValue / 255.f + 0.5f), 0, maxValue); };
+    return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+/**
+ * \brief Expanded the way the GPU does, the top bits are replicated into the low bits.
+ */
+void
+From565(uint16_t color, float outColor[3])
+{
+    const int32_t r{ color >> 11 };
+    const int32_t g{ (color >> 5) & 63 };
+    const int32_t b{ color & 31 };
+    outColor[0] = static_cast<float>((r << 3) | (r >> 2));
+    outColor[1] = static_cast<float>((g << 2) | (g >> 4));
+    outColor[2] = static_cast<float>((b << 3) | (b >> 2));
+}
+
+/**
+ * \brief The nearest palette entry of every pixel by squared RGB distance.
+ */
+void
+FindNearestIndices(const BlockPixels& block, const float palette[4][3], int32_t numColors, uint8_t outIndices[16])
+{
+#if defined(SPRITE_UV_SSE2)
+    for (int32_t group{}; group < 16; group += 4)
+        {
+            const __m128 r{ _mm_load_ps(block.R + group) };
+            const __m128 g{ _mm_load_ps(block.G + group) };
+            const __m128 b{ _mm_load_ps(block.B + group) };
+            __m128       bestDistance{ _mm_set1_ps(FLT_MAX) };
+            __m128i      bestIndex{ _mm_setzero_si128() };
+            for (int32_t i{}; i < numColors; ++i)
+                {
+                    const __m128 dr{ _mm_sub_ps(r, _mm_set1_ps(palette[i][0])) };
+                    const __m128 dg{ _mm_sub_ps(g, _mm_set1_ps(palette[i][1])) };
+                    const __m128 db{ _mm_sub_ps(b, _mm_set1_ps(palette[i][2])) };
+                    const __m128 distance{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db)) };
+                    // SSE2 has no blend, the index is selected with masks
+                    const __m128i closer{ _mm_castps_si128(_mm_cmplt_ps(distance, bestDistance)) };
+                    bestIndex    = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(i)), _mm_andnot_si128(closer, bestIndex));
+                    bestDistance = _mm_min_ps(distance, bestDistance);
+                }
+            alignas(16) int32_t indices[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+            for (int32_t lane{}; lane < 4; ++lane)
+                {
+                    outIndices[group + lane] = static_cast<uint8_t>(indices[lane]);
+                }
+        }
+#else
+    for (int32_t pixel{}; pixel < 16; ++pixel)
+        {
+            float bestDistance{ FLT_MAX };
+            for (int32_t i{}; i < numColors; ++i)
+                {
+                    const float dr{ block.R[pixel] - palette[i][0] };
+                    const float dg{ block.G[pixel] - palette[i][1] };
+                    const float db{ block.B[pixel] - palette[i][2] };
+                    const float distance{ dr * dr + dg * dg + db * db };
+                    if (distance < bestDistance)
+                        {
+                            bestDistance      = distance;
+                            outIndices[pixel] = static_cast<uint8_t>(i);
+                        }
+                }
+        }
+#endif
+}
+
+/**
+ * \brief Quantizes the endpoints and picks the indices. The three color mode (c0 <= c1) keeps index 3 for the transparent pixels.
+ */
+ColorBlock
+QuantizeColorBlock(const BlockPixels& block, const bool transparent[16], bool threeColorMode, const float endpoint0[3], const float endpoint1[3])
+{
+    ColorBlock result{};
+    result.C0 = To565(endpoint0);
+    result.C1 = To565(endpoint1);
+    if (threeColorMode ? result.C0 > result.C1 : result.C0 < result.C1)
+        {
+            std::swap(result.C0, result.C1);
+        }
+
+    float palette[4][3]{};
+    From565(result.C0, palette[0]);
+    From565(result.C1, palette[1]);
+    // Equal endpoints decode in the three color mode whatever was asked, index 3 must not be used for opaque pixels
+    int32_t numColors{ 3 };
+    for (int32_t c{}; c < 3; ++c)
+        {
+            if (!threeColorMode && result.C0 != result.C1)
+                {
+                    palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+                    palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+                    numColors     = 4;
+                }
+            else
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2.f;
+                }
+        }
+    FindNearestIndices(block, palette, numColors, result.Indices);
+
+    result.Error = 0.f;
+    for (int32_t i{}; i < 16; ++i)
+        {
+            if (transparent[i])
+                {
+                    result.Indices[i] = 3;
+                    continue;
+                }
+            const float* color{ palette[result.Indices[i]] };
+            const float  dr{ block.R[i] - color[0] };
+            const float  dg{ block.G[i] - color[1] };
+            const float  db{ block.B[i] - color[2] };
+            result.Error += dr * dr + dg * dg + db * db;
+        }
+    return result;
+}
+
+/**
+ * \brief Least squares endpoints for the chosen indices, the classic refinement of the principal axis fit.
+ * \return False if the indices do not constrain both endpoints.
+ */
+bool
+RefitEndpoints(const BlockPixels& block, const bool transparent[16], const ColorBlock& colorBlock, bool threeColorMode, float outEndpoint0[3], float outEndpoint1[3])
+{
+    // Weight of the first endpoint for each index
+    constexpr float FOUR_COLOR_WEIGHTS[4]{ 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+    constexpr float THREE_COLOR_WEIGHTS[4]{ 1.f, 0.f, 0.5f, 0.f };
+    const float*    weights{ threeColorMode || colorBlock.C0 == colorBlock.C1 ? THREE_COLOR_WEIGHTS : FOUR_COLOR_WEIGHTS };
+
+    float alpha2{};
+    float beta2{};
+    float alphaBeta{};
+    float alphaX[3]{};
+    float betaX[3]{};
+    for (int32_t i{}; i < 16; ++i)
+        {
+            if (transparent[i])
+                {
+                    continue;
+                }
+            const float alpha{ weights[colorBlock.Indices[i]] };
+            const float beta{ 1.f - alpha };
+            const float color[3]{ block.R[i], block.G[i], block.B[i] };
+            alpha2 += alpha * alpha;
+            beta2 += beta * beta;
+            alphaBeta += alpha * beta;
+            for (int32_t c{}; c < 3; ++c)
+                {
+                    alphaX[c] += alpha * color[c];
+                    betaX[c] += beta * color[c];
+                }
+        }
+
+    const float determinant{ alpha2 * beta2 - alphaBeta * alphaBeta };
+    if (std::fabs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+    for (int32_t c{}; c < 3; ++c)
+        {
+            outEndpoint0[c] = std::clamp((alphaX[c] * beta2 - betaX[c] * alphaBeta) / determinant, 0.f, 255.f);
+            outEndpoint1[c] = std::clamp((betaX[c] * alpha2 - alphaX[c] * alphaBeta) / determinant, 0.f, 255.f);
+        }
+    return true;
+}
+
+/**
+ * \brief BC1 color block. The endpoints are the extremes of the colors along their principal axis, then refined by least squares.
+ * With punch through alpha, the pixels below half opacity are encoded transparent.
+ */
+void
+EncodeColorBlock(const BlockPixels& block, bool punchThrough, uint8_t* outBlock)
+{
+    bool    transparent[16]{};
+    int32_t numOpaque{};
+    float   mean[3]{};
+    for (int32_t i{}; i < 16; ++i)
+        {
+            transparent[i] = punchThrough && block.A[i] < 128.f;
+            if (!transparent[i])
+                {
+                    mean[0] += block.R[i];
+                    mean[1] += block.G[i];
+                    mean[2] += block.B[i];
+                    ++numOpaque;
+                }
+        }
+
+    ColorBlock colorBlock{};
+    if (numOpaque == 0)
+        {
+            // Both endpoints black, every index on the transparent entry
+            std::memset(colorBlock.Indices, 3, sizeof(colorBlock.Indices));
+        }
+    else
+        {
+            const bool threeColorMode{ numOpaque < 16 };
+            for (float& channel : mean)
+                {
+                    channel /= static_cast<float>(numOpaque);
+                }
+
+            // Covariance of the opaque colors
+            float covariance[6]{};
+            float minColor[3]{ 255.f, 255.f, 255.f };
+            float maxColor[3]{};
+            for (int32_t i{}; i < 16; ++i)
+                {
+                    if (transparent[i])
+                        {
+                            continue;
+                        }
+                    const float color[3]{ block.R[i], block.G[i], block.B[i] };
+                    const float d[3]{ color[0] - mean[0], color[1] - mean[1], color[2] - mean[2] };
+                    covariance[0] += d[0] * d[0];
+                    covariance[1] += d[0] * d[1];
+                    covariance[2] += d[0] * d[2];
+                    covariance[3] += d[1] * d[1];
+                    covariance[4] += d[1] * d[2];
+                    covariance[5] += d[2] * d[2];
+                    for (int32_t c{}; c < 3; ++c)
+                        {
+                            minColor[c] = std::min(minColor[c], color[c]);
+                            maxColor[c] = std::max(maxColor[c], color[c]);
+                        }
+                }
+
+            // Principal axis by power iteration, starting from the bounding box diagonal
+            float axis[3]{ maxColor[0] - minColor[0], maxColor[1] - minColor[1], maxColor[2] - minColor[2] };
+            for (int32_t iteration{}; iteration < 4; ++iteration)
+                {
+                    const float next[3]{ covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                        covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                        covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2] };
+                    const float length{ std::max({ std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2]) }) };
+                    if (length < 1e-6f)
+                        {
+                            break;
+                        }
+                    for (int32_t c{}; c < 3; ++c)
+                        {
+                            axis[c] = next[c] / length;
+                        }
+                }
+
+            float minProjection{ FLT_MAX };
+            float maxProjection{ -FLT_MAX };
+            for (int32_t i{}; i < 16; ++i)
+                {
+                    if (transparent[i])
+                        {
+                            continue;
+                        }
+                    const float projection{ (block.R[i] - mean[0]) * axis[0] + (block.G[i] - mean[1]) * axis[1] + (block.B[i] - mean[2]) * axis[2] };
+                    minProjection = std::min(minProjection, projection);
+                    maxProjection = std::max(maxProjection, projection);
+                }
+            const float axisLength2{ axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] };
+            float       endpoint0[3]{ mean[0], mean[1], mean[2] };
+            float       endpoint1[3]{ mean[0], mean[1], mean[2] };
+            if (axisLength2 > 1e-6f)
+                {
+                    for (int32_t c{}; c < 3; ++c)
+                        {
+                            endpoint0[c] = std::clamp(mean[c] + axis[c] * maxProjection / axisLength2, 0.f, 255.f);
+                            endpoint1[c] = std::clamp(mean[c] + axis[c] * minProjection / axisLength2, 0.f, 255.f);
+                        }
+                }
+
+            colorBlock = QuantizeColorBlock(block, transparent, threeColorMode, endpoint0, endpoint1);
+            if (colorBlock.Error > 0.f && RefitEndpoints(block, transparent, colorBlock, threeColorMode, endpoint0, endpoint1))
+                {
+                    if (const ColorBlock refined{ QuantizeColorBlock(block, transparent, threeColorMode, endpoint0, endpoint1) }; refined.Error < colorBlock.Error)
+                        {
+                            colorBlock = refined;
+                        }
+                }
+        }
+
+    uint32_t indexBits{};
+    for (int32_t i{}; i < 16; ++i)
+        {
+            indexBits |= static_cast<uint32_t>(colorBlock.Indices[i]) << (2 * i);
+        }
+    // Little endian, as every platform the editor targets
+    outBlock[0] = static_cast<uint8_t>(colorBlock.C0);
+    outBlock[1] = static_cast<uint8_t>(colorBlock.C0 >> 8);
+    outBlock[2] = static_cast<uint8_t>(colorBlock.C1);
+    outBlock[3] = static_cast<uint8_t>(colorBlock.C1 >> 8);
+    std::memcpy(outBlock + 4, &indexBits, sizeof(indexBits));
+}
+
+/**
+ * \brief BC3 alpha block in the 8 values mode, the endpoints are the alpha extremes.
+ */
+void
+EncodeAlphaBlock(const BlockPixels& block, uint8_t* outBlock)
+{
+    const auto [minAlpha, maxAlpha]{ std::minmax_element(std::begin(block.A), std::end(block.A)) };
+    const int32_t alpha0{ static_cast<int32_t>(*maxAlpha) };
+    const int32_t alpha1{ static_cast<int32_t>(*minAlpha) };
+
+    uint64_t indexBits{};
+    if (alpha0 != alpha1)
+        {
+            // Decoded with the same integer math as the GPU
+            int32_t palette[8]{ alpha0, alpha1 };
+            for (int32_t i{ 2 }; i < 8; ++i)
+                {
+                    palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+                }
+            for (int32_t pixel{}; pixel < 16; ++pixel)
+                {
+                    const int32_t alpha{ static_cast<int32_t>(block.A[pixel]) };
+                    int32_t       bestIndex{};
+                    for (int32_t i{ 1 }; i < 8; ++i)
+                        {
+                            if (std::abs(palette[i] - alpha) < std::abs(palette[bestIndex] - alpha))
+                                {
+                                    bestIndex = i;
+                                }
+                        }
+                    indexBits |= static_cast<uint64_t>(bestIndex) << (3 * pixel);
+                }
+        }
+
+    outBlock[0] = static_cast<uint8_t>(alpha0);
+    outBlock[1] = static_cast<uint8_t>(alpha1);
+    for (int32_t i{}; i < 6; ++i)
+        {
+            outBlock[2 + i] = static_cast<uint8_t>(indexBits >> (8 * i));
+        }
+}
+
+void
+PutU32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+{
+    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+}
+
+std::vector<uint8_t>
+CompressBlocks(const uint8_t* rgba, int32_t width, int32_t height, EBlockFormat format)
+{
+    if (!rgba || width <= 0 || height <= 0)
+        {
+            return {};
+        }
+
+    const int32_t        blocksX{ (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION };
+    const int32_t        blocksY{ (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION };
+    const size_t         blockBytes{ GetBlockBytes(format) };
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+    // Every block is independent, a row of blocks is enough work per task
+    ThreadPool::Shared().ParallelFor(static_cast<size_t>(blocksY), [&](size_t begin, size_t end) {
+        BlockPixels block{};
+        for (size_t blockY{ begin }; blockY < end; ++blockY)
+            {
+                uint8_t* outBlock{ blocks.data() + blockY * blocksX * blockBytes };
+                for (int32_t blockX{}; blockX < blocksX; ++blockX, outBlock += blockBytes)
+                    {
+                        LoadBlock(rgba, width, height, blockX, static_cast<int32_t>(blockY), block);
+                        if (format == EBlockFormat::BC3)
+                            {
+                                EncodeAlphaBlock(block, outBlock);
+                                EncodeColorBlock(block, false, outBlock + 8);
+                            }
+                        else
+                            {
+                                EncodeColorBlock(block, true, outBlock);
+                            }
+                    }
+            }
+    });
+    return blocks;
+}
+
+std::vector<uint8_t>
+BuildDdsFile(const uint8_t* rgba, int32_t width, int32_t height, EBlockFormat format)
+{
+    const auto blocks{ CompressBlocks(rgba, width, height, format) };
+    if (blocks.empty())
+        {
+            return {};
+        }
+
+    // "DDS " then DDS_HEADER, the pixel format is given by its FourCC
+    constexpr size_t     HEADER_SIZE{ 4 + 124 };
+    constexpr uint32_t   DDSD_CAPS_HEIGHT_WIDTH_PIXELFORMAT_LINEARSIZE{ 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000 };
+    constexpr uint32_t   DDPF_FOURCC{ 0x4 };
+    constexpr uint32_t   DDSCAPS_TEXTURE{ 0x1000 };
+    std::vector<uint8_t> file(HEADER_SIZE, 0);
+    std::memcpy(file.data(), "DDS ", 4);
+    PutU32(file, 4, 124);
+    PutU32(file, 8, DDSD_CAPS_HEIGHT_WIDTH_PIXELFORMAT_LINEARSIZE);
+    PutU32(file, 12, static_cast<uint32_t>(height));
+    PutU32(file, 16, static_cast<uint32_t>(width));
+    PutU32(file, 20, static_cast<uint32_t>(blocks.size()));
+    PutU32(file, 28, 1);
+    // DDS_PIXELFORMAT
+    PutU32(file, 76, 32);
+    PutU32(file, 80, DDPF_FOURCC);
+    std::memcpy(file.data() + 84, format == EBlockFormat::BC3 ? "DXT5" : "DXT1", 4);
+    PutU32(file, 108, DDSCAPS_TEXTURE);
+
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+std::vector<ValidationIssue>
+FindBlockMisalignedAnimations(const nlohmann::ordered_json& j)
+{
+    std::vector<ValidationIssue> issues{};
+    if (!j.contains("animations") || !j.at("animations").is_array())
+        {
+            return issues;
+        }
+    for (const auto& animation : j.at("animations"))
+        {
+            if (!animation.is_object() || animation.value("type", std::string{}) != "Spritesheet")
+                {
+                    continue;
+                }
+            // Frames advance by their size, thus every frame is aligned when the first one is
+            const int32_t x{ animation.value("x", 0) };
+            const int32_t y{ animation.value("y", 0) };
+            const int32_t width{ animation.value("width", 0) };
+            const int32_t height{ animation.value("height", 0) };
+            if ((x | y | width | height) % BLOCK_DIMENSION != 0)
+                {
+                    issues.push_back({ EValidationSeverity::WARNING,
+                        animation.value("name", std::string{}),
+                        "The frames are not aligned to the 4x4 compression blocks, colors bleed across their borders" });
+                }
+        }
+    return issues;
+}
@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "validation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Block compressed GPU textures, 4 times (BC3) to 8 times (BC1) less memory than RGBA8 once uploaded.
+// Kept free of raylib so it can run headless, the caller decodes the image.
+
+enum class EBlockFormat : uint8_t
+{
+    /**
+     * \brief 4 bits per pixel, RGB with 1 bit alpha: pixels below half opacity become fully transparent.
+     */
+    BC1,
+    /**
+     * \brief 8 bits per pixel, BC1 colors plus an interpolated 8 bit alpha.
+     */
+    BC3,
+};
+
+constexpr int32_t BLOCK_DIMENSION{ 4 };
+
+constexpr size_t
+GetBlockBytes(EBlockFormat format)
+{
+    return format == EBlockFormat::BC1 ? 8 : 16;
+}
+
+/**
+ * \brief Encodes RGBA8 pixels into 4x4 blocks, rows of blocks are encoded in parallel on the shared pool.
+ * Partial blocks on the right and bottom edges replicate the last column and row, so no black or transparent fringe is blended in.
+ */
+std::vector<uint8_t> CompressBlocks(const uint8_t* rgba, int32_t width, int32_t height, EBlockFormat format);
+
+/**
+ * \brief A DDS file (DXT1 or DXT5 FourCC) holding a single mip level, loadable by raylib LoadImage and most engines.
+ */
+std::vector<uint8_t> BuildDdsFile(const uint8_t* rgba, int32_t width, int32_t height, EBlockFormat format);
+
+/**
+ * \brief Spritesheets whose frame rects do not start and end on the 4x4 block grid: their edge blocks share the endpoints with the neighbouring pixels thus colors bleed across the border.
+ */
+std::vector<ValidationIssue> FindBlockMisalignedAnimations(const nlohmann::ordered_json& j);
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+    if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    _workers.reserve(numThreads);
+    for (size_t i{}; i < numThreads; ++i)
+        {
+            _workers.emplace_back([this]() { WorkerLoop(); });
+        }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+}
+
+ThreadPool&
+ThreadPool::Shared()
+{
+    static ThreadPool pool{};
+    return pool;
+}
+
+std::future<void>
+ThreadPool::Submit(std::function<void()> task)
+{
+    auto packaged{ std::make_shared<std::packaged_task<void()>>(std::move(task)) };
+    auto future{ packaged->get_future() };
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        _tasks.emplace([packaged]() { (*packaged)(); });
+    }
+    _wakeUp.notify_one();
+    return future;
+}
+
+void
+ThreadPool::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t grainSize)
+{
+    if (count == 0)
+        {
+            return;
+        }
+
+    // Enough chunks to balance uneven work without paying too much scheduling
+    grainSize = std::max(grainSize, count / (GetNumThreads() * 8) + 1);
+    const size_t numChunks{ (count + grainSize - 1) / grainSize };
+    if (numChunks == 1)
+        {
+            body(0, count);
+            return;
+        }
+
+    // Shared with the helper tasks, they may start after this call returned and find nothing left to do
+    struct State
+    {
+        std::atomic<size_t>     NextChunk{};
+        std::atomic<size_t>     DoneChunks{};
+        std::mutex              Mutex{};
+        std::condition_variable Done{};
+    };
+    auto state{ std::make_shared<State>() };
+
+    const auto runChunks = [state, &body, count, grainSize, numChunks]() {
+        for (size_t chunk{ state->NextChunk++ }; chunk < numChunks; chunk = state->NextChunk++)
+            {
+                const size_t begin{ chunk * grainSize };
+                body(begin, std::min(begin + grainSize, count));
+                if (++state->DoneChunks == numChunks)
+                    {
+                        std::lock_guard<std::mutex> lock{ state->Mutex };
+                        state->Done.notify_all();
+                    }
+            }
+    };
+
+    const size_t numHelpers{ std::min(GetNumThreads(), numChunks - 1) };
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        for (size_t i{}; i < numHelpers; ++i)
+            {
+                // The body reference is only used while chunks remain, which implies this call has not returned yet
+                _tasks.emplace(runChunks);
+            }
+    }
+    _wakeUp.notify_all();
+
+    // The caller works too, so nested calls from inside the pool never deadlock
+    runChunks();
+
+    std::unique_lock<std::mutex> lock{ state->Mutex };
+    state->Done.wait(lock, [&]() { return state->DoneChunks == numChunks; });
+}
+
+void
+ThreadPool::WorkerLoop()
+{
+    while (true)
+        {
+            std::function<void()> task{};
+            {
+                std::unique_lock<std::mutex> lock{ _mutex };
+                _wakeUp.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_stopping && _tasks.empty())
+                    {
+                        return;
+                    }
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+            task();
+        }
+}
@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Fixed size pool of worker threads shared by the CPU heavy operations (image processing, batch exports).
+ */
+class ThreadPool final
+{
+  public:
+    /**
+     * \brief Zero threads means one per hardware thread.
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t GetNumThreads() const { return _workers.size(); }
+
+    std::future<void> Submit(std::function<void()> task);
+
+    /**
+     * \brief Runs body(begin, end) over [0, count) in chunks of at least grainSize, the calling thread takes part.
+     * Returns once every chunk is done, safe to call from inside a pool task.
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t grainSize = 1);
+
+    /**
+     * \brief The process wide pool sized to the machine.
+     */
+    static ThreadPool& Shared();
+
+  private:
+    std::vector<std::thread>          _workers{};
+    std::queue<std::function<void()>> _tasks{};
+    std::mutex                        _mutex{};
+    std::condition_variable           _wakeUp{};
+    bool                              _stopping{};
+
+    void WorkerLoop();
+};
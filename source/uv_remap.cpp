@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "uv_remap.hpp"
+
+#include "project.hpp"
+
+#include <cassert>
+
+namespace
+{
+UvRemapPixels
+ToPixels(const Image& image)
+{
+    assert(image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return { static_cast<const uint8_t*>(image.data), image.width, image.height };
+}
+}
+
+UvRemapReport
+FindRemappedUvs(const Image& previous, const Image& next, const std::vector<UvRemapInput>& animations)
+{
+    return FindRemappedUvs(ToPixels(previous), ToPixels(next), animations);
+}
+
+bool
+HasAnyFrameChanged(const Image& previous, const Image& next, const std::vector<UvRemapInput>& animations)
+{
+    return HasAnyFrameChanged(ToPixels(previous), ToPixels(next), animations);
+}
+
+std::vector<UvRemapInput>
+CollectUvRemapInput(const Project& project)
+{
+    std::vector<UvRemapInput> input{};
+    for (const auto& [symbol, animationData] : project.AnimationNameToSpritesheet)
+        {
+            // Only the animations of the sprite, the other pages are not reloaded
+            if (std::holds_alternative<SpritesheetUv>(animationData.Data) && std::get<SpritesheetUv>(animationData.Data).Property_Page.Value == 0)
+                {
+                    const auto& spriteSheet{ std::get<SpritesheetUv>(animationData.Data) };
+                    input.push_back({ std::string{ project.GetAnimationName(symbol) }, spriteSheet.Uv, spriteSheet.Property_NumOfFrames.Value, spriteSheet.Property_Columns.Value });
+                }
+        }
+    return input;
+}
+
+bool
+ApplyUvRemap(Project& project, const UvRemapReport& report)
+{
+    bool moved{};
+    for (const auto& result : report.Results)
+        {
+            if (result.Ambiguous || result.Confidence < MIN_REMAP_CONFIDENCE)
+                {
+                    continue;
+                }
+            const auto found{ project.FindAnimation(result.AnimationName) };
+            if (found == project.AnimationNameToSpritesheet.end() || !std::holds_alternative<SpritesheetUv>(found->second.Data))
+                {
+                    continue;
+                }
+            auto& spriteSheet{ std::get<SpritesheetUv>(found->second.Data) };
+            // Only apply if the animation was not edited meanwhile
+            if (spriteSheet.Uv.x == result.PreviousUv.x && spriteSheet.Uv.y == result.PreviousUv.y && (result.NewUv.x != spriteSheet.Uv.x || result.NewUv.y != spriteSheet.Uv.y))
+                {
+                    spriteSheet.Uv.x = result.NewUv.x;
+                    spriteSheet.Uv.y = result.NewUv.y;
+                    moved            = true;
+                }
+        }
+
+    if (moved)
+        {
+            // A single undo step for the whole remap
+            project.CommitNewAction();
+        }
+    return moved;
+}
@@ -0,0 +1,51 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "raylib.h"
+
+#include "uv_remap_search.hpp"
+
+#include <vector>
+
+class Project;
+
+/**
+ * \brief The RGBA8 images searched by FindRemappedUvs of uv_remap_search.hpp.
+ */
+UvRemapReport FindRemappedUvs(const Image& previous, const Image& next, const std::vector<UvRemapInput>& animations);
+
+bool HasAnyFrameChanged(const Image& previous, const Image& next, const std::vector<UvRemapInput>& animations);
+
+/**
+ * \brief The spritesheet animations of the project as remap input.
+ */
+std::vector<UvRemapInput> CollectUvRemapInput(const Project& project);
+
+/**
+ * \brief Moves the confidently remapped animations, all the changes are committed as one undo step.
+ * \return True if any animation moved.
+ */
+bool ApplyUvRemap(Project& project, const UvRemapReport& report);
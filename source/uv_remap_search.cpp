@@ -0,0 +1,467 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "uv_remap_search.hpp"
+
+#include "frame_layout.hpp"
+#include "profiler.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+constexpr int32_t  MAX_PYRAMID_LEVELS{ 6 };
+constexpr int32_t  MIN_COARSE_TEMPLATE_SIZE{ 8 };
+constexpr size_t   COARSE_CANDIDATES{ 16 };
+constexpr int32_t  REFINE_RADIUS{ 2 };
+constexpr size_t   MAX_KNOWN_OFFSETS{ 32 };
+constexpr uint64_t NO_MATCH{ std::numeric_limits<uint64_t>::max() };
+
+/**
+ * \brief Single channel image matched instead of RGBA, 4 times less memory traffic.
+ */
+struct Plane
+{
+    int32_t              Width{};
+    int32_t              Height{};
+    std::vector<uint8_t> Pixels{};
+
+    const uint8_t* Row(int32_t y) const { return Pixels.data() + static_cast<size_t>(y) * Width; }
+    bool           Contains(const Rect& r) const { return r.x >= 0 && r.y >= 0 && r.w > 0 && r.h > 0 && r.x + r.w <= Width && r.y + r.h <= Height; }
+};
+
+using Pyramid = std::vector<Plane>;
+
+// Premultiplied luminance mixed with alpha, so transparent and opaque black pixels differ. Transparent pixels are 0
+Plane
+ToSignaturePlane(const UvRemapPixels& image)
+{
+    Plane plane{ image.Width, image.Height, std::vector<uint8_t>(static_cast<size_t>(image.Width) * image.Height) };
+
+    ThreadPool::Shared().ParallelFor(static_cast<size_t>(image.Height), [&](size_t begin, size_t end) {
+        for (size_t y{ begin }; y < end; ++y)
+            {
+                const uint8_t* src{ image.Rgba + y * image.Width * 4 };
+                uint8_t*       dst{ plane.Pixels.data() + y * image.Width };
+                for (int32_t x{}; x < image.Width; ++x, src += 4)
+                    {
+                        const uint32_t luminance{ (src[0] * 77u + src[1] * 150u + src[2] * 29u) >> 8 };
+                        dst[x] = static_cast<uint8_t>(((luminance * src[3]) / 255u + src[3]) >> 1);
+                    }
+            }
+    });
+    return plane;
+}
+
+Plane
+Downsample(const Plane& source)
+{
+    Plane half{ std::max(1, source.Width / 2), std::max(1, source.Height / 2), {} };
+    half.Pixels.resize(static_cast<size_t>(half.Width) * half.Height);
+    ThreadPool::Shared().ParallelFor(static_cast<size_t>(half.Height), [&](size_t begin, size_t end) {
+        for (size_t y{ begin }; y < end; ++y)
+            {
+                const uint8_t* row0{ source.Row(std::min(static_cast<int32_t>(y * 2), source.Height - 1)) };
+                const uint8_t* row1{ source.Row(std::min(static_cast<int32_t>(y * 2 + 1), source.Height - 1)) };
+                uint8_t*       dst{ half.Pixels.data() + y * half.Width };
+                for (int32_t x{}; x < half.Width; ++x)
+                    {
+                        const int32_t x0{ std::min(x * 2, source.Width - 1) };
+                        const int32_t x1{ std::min(x * 2 + 1, source.Width - 1) };
+                        dst[x]          = static_cast<uint8_t>((row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) >> 2);
+                    }
+            }
+    });
+    return half;
+}
+
+Pyramid
+BuildPyramid(const UvRemapPixels& image)
+{
+    Pyramid pyramid{};
+    pyramid.push_back(ToSignaturePlane(image));
+    while (static_cast<int32_t>(pyramid.size()) < MAX_PYRAMID_LEVELS && pyramid.back().Width >= 2 * MIN_COARSE_TEMPLATE_SIZE && pyramid.back().Height >= 2 * MIN_COARSE_TEMPLATE_SIZE)
+        {
+            pyramid.push_back(Downsample(pyramid.back()));
+        }
+    return pyramid;
+}
+
+uint32_t
+RowSad(const uint8_t* a, const uint8_t* b, int32_t width)
+{
+    uint32_t sad{};
+    int32_t  x{};
+#if defined(SPRITE_UV_SSE2)
+    __m128i acc{ _mm_setzero_si128() };
+    for (; x + 16 <= width; x += 16)
+        {
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x))));
+        }
+    sad = static_cast<uint32_t>(_mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+    for (; x < width; ++x)
+        {
+            sad += static_cast<uint32_t>(std::abs(a[x] - b[x]));
+        }
+    return sad;
+}
+
+/**
+ * \brief SAD between the rect of the previous plane and the same sized rect at (x, y) of the next plane.
+ * Stops early once worse than bail.
+ */
+uint64_t
+RectSad(const Plane& previous, const Rect& rect, const Plane& next, int32_t x, int32_t y, uint64_t bail = NO_MATCH)
+{
+    if (!next.Contains({ x, y, rect.w, rect.h }))
+        {
+            return NO_MATCH;
+        }
+    uint64_t sad{};
+    for (int32_t row{}; row < rect.h && sad < bail; ++row)
+        {
+            sad += RowSad(previous.Row(rect.y + row) + rect.x, next.Row(y + row) + x, rect.w);
+        }
+    return sad;
+}
+
+Rect
+ScaleDown(const Rect& r, int32_t level)
+{
+    return { r.x >> level, r.y >> level, std::max(1, r.w >> level), std::max(1, r.h >> level) };
+}
+
+/**
+ * \brief Matches every frame of the animation shifted by the offset.
+ */
+uint64_t
+AnimationSad(const Plane& previous, const Plane& next, const UvRemapInput& animation, Vec2 offset)
+{
+    uint64_t sad{};
+    for (int32_t i{}; i < animation.NumOfFrames; ++i)
+        {
+            const Rect frameRect{ animation.Uv.x + frame::OffsetX(i, animation.Columns, animation.Uv.w), animation.Uv.y + frame::OffsetY(i, animation.Columns, animation.Uv.h), animation.Uv.w, animation.Uv.h };
+            // Frames out of the previous image can not be matched, they are ignored
+            if (!previous.Contains(frameRect))
+                {
+                    continue;
+                }
+            const uint64_t frameSad{ RectSad(previous, frameRect, next, frameRect.x + offset.x, frameRect.y + offset.y) };
+            if (frameSad == NO_MATCH)
+                {
+                    return NO_MATCH;
+                }
+            sad += frameSad;
+        }
+    return sad;
+}
+
+/**
+ * \brief The SAD relative to the energy of the frames, their SAD against a transparent block: a mostly transparent frame matching
+ * blank space scores 0, not the share of its transparent pixels. Zero as well if the match covers another number of non transparent pixels.
+ */
+float
+MatchConfidence(const Plane& previous, const Plane& next, const UvRemapInput& animation, Vec2 offset)
+{
+    uint64_t sad{};
+    uint64_t energy{};
+    uint64_t numPreviousOpaque{};
+    uint64_t numNextOpaque{};
+    for (int32_t i{}; i < animation.NumOfFrames; ++i)
+        {
+            const Rect frameRect{ animation.Uv.x + frame::OffsetX(i, animation.Columns, animation.Uv.w), animation.Uv.y + frame::OffsetY(i, animation.Columns, animation.Uv.h), animation.Uv.w, animation.Uv.h };
+            if (!previous.Contains(frameRect))
+                {
+                    continue;
+                }
+            if (!next.Contains({ frameRect.x + offset.x, frameRect.y + offset.y, frameRect.w, frameRect.h }))
+                {
+                    return 0.f;
+                }
+            for (int32_t row{}; row < frameRect.h; ++row)
+                {
+                    const uint8_t* previousRow{ previous.Row(frameRect.y + row) + frameRect.x };
+                    const uint8_t* nextRow{ next.Row(frameRect.y + offset.y + row) + frameRect.x + offset.x };
+                    for (int32_t x{}; x < frameRect.w; ++x)
+                        {
+                            sad += static_cast<uint64_t>(std::abs(previousRow[x] - nextRow[x]));
+                            energy += previousRow[x];
+                            numPreviousOpaque += previousRow[x] != 0;
+                            numNextOpaque += nextRow[x] != 0;
+                        }
+                }
+        }
+    if (energy == 0 || numPreviousOpaque != numNextOpaque || sad >= energy)
+        {
+            return 0.f;
+        }
+    return 1.f - static_cast<float>(static_cast<double>(sad) / static_cast<double>(energy));
+}
+
+bool
+IsFlat(const Plane& plane, const Rect& rect)
+{
+    const uint8_t first{ plane.Row(rect.y)[rect.x] };
+    for (int32_t y{ rect.y }; y < rect.y + rect.h; ++y)
+        {
+            const uint8_t* row{ plane.Row(y) + rect.x };
+            if (std::any_of(row, row + rect.w, [first](uint8_t value) { return value != first; }))
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+/**
+ * \brief Coarse to fine search of the template in the whole next image.
+ */
+Vec2
+SearchTemplate(const Pyramid& previous, const Pyramid& next, const Rect& templateRect)
+{
+    // Coarsest level still keeping enough template pixels to be meaningful
+    int32_t level{ static_cast<int32_t>(std::min(previous.size(), next.size())) - 1 };
+    while (level > 0 && ((templateRect.w >> level) < MIN_COARSE_TEMPLATE_SIZE || (templateRect.h >> level) < MIN_COARSE_TEMPLATE_SIZE))
+        {
+            --level;
+        }
+
+    // Exhaustive search at the coarse level keeping the best few candidates
+    const Rect                                coarseRect{ ScaleDown(templateRect, level) };
+    const Plane&                              coarseNext{ next[level] };
+    std::vector<std::pair<uint64_t, Vec2>> candidates{};
+    for (int32_t y{}; y + coarseRect.h <= coarseNext.Height; ++y)
+        {
+            for (int32_t x{}; x + coarseRect.w <= coarseNext.Width; ++x)
+                {
+                    const uint64_t bail{ candidates.size() < COARSE_CANDIDATES ? NO_MATCH : candidates.back().first };
+                    const uint64_t sad{ RectSad(previous[level], coarseRect, coarseNext, x, y, bail) };
+                    if (sad >= bail)
+                        {
+                            continue;
+                        }
+                    const auto position{ std::upper_bound(candidates.begin(), candidates.end(), sad, [](uint64_t value, const auto& candidate) { return value < candidate.first; }) };
+                    candidates.insert(position, { sad, Vec2{ x, y } });
+                    if (candidates.size() > COARSE_CANDIDATES)
+                        {
+                            candidates.pop_back();
+                        }
+                }
+        }
+
+    // Refine every candidate down to full resolution
+    Vec2     best{};
+    uint64_t bestSad{ NO_MATCH };
+    for (const auto& [coarseSad, coarsePosition] : candidates)
+        {
+            Vec2 position{ coarsePosition };
+            for (int32_t l{ level - 1 }; l >= 0; --l)
+                {
+                    const Rect levelRect{ ScaleDown(templateRect, l) };
+                    const Vec2 center{ position.x * 2, position.y * 2 };
+                    uint64_t   levelBestSad{ NO_MATCH };
+                    for (int32_t dy{ -REFINE_RADIUS }; dy <= REFINE_RADIUS; ++dy)
+                        {
+                            for (int32_t dx{ -REFINE_RADIUS }; dx <= REFINE_RADIUS; ++dx)
+                                {
+                                    const uint64_t sad{ RectSad(previous[l], levelRect, next[l], center.x + dx, center.y + dy, levelBestSad) };
+                                    if (sad < levelBestSad)
+                                        {
+                                            levelBestSad = sad;
+                                            position     = { center.x + dx, center.y + dy };
+                                        }
+                                }
+                        }
+                }
+            const uint64_t sad{ RectSad(previous[0], templateRect, next[0], position.x, position.y, bestSad) };
+            if (sad < bestSad)
+                {
+                    bestSad = sad;
+                    best    = position;
+                }
+        }
+
+    return { best.x - templateRect.x, best.y - templateRect.y };
+}
+}
+
+std::string
+UvRemapReport::ToString() const
+{
+    constexpr size_t MAX_LISTED{ 10 };
+
+    std::ostringstream out{};
+    out << "Remapped " << NumMoved << " of " << Results.size() << " animations in " << Seconds << "s.";
+
+    size_t listed{};
+    for (const auto& result : Results)
+        {
+            if (result.Confidence >= MIN_REMAP_CONFIDENCE && !result.Ambiguous)
+                {
+                    continue;
+                }
+            if (listed++ == MAX_LISTED)
+                {
+                    out << "\n...";
+                    break;
+                }
+            out << "\n" << result.AnimationName << (result.Ambiguous ? ": ambiguous, kept" : ": low confidence ") << (result.Ambiguous ? "" : std::to_string(result.Confidence));
+        }
+    return out.str();
+}
+
+UvRemapReport
+FindRemappedUvs(const UvRemapPixels& previous, const UvRemapPixels& next, const std::vector<UvRemapInput>& animations)
+{
+    PROFILE_SCOPE("FindRemappedUvs");
+    const auto start{ std::chrono::steady_clock::now() };
+
+    const Pyramid previousPyramid{ BuildPyramid(previous) };
+    const Pyramid nextPyramid{ BuildPyramid(next) };
+
+    UvRemapReport report{};
+    report.Results.resize(animations.size());
+
+    // Offsets that matched exactly, the rest of a moved block usually shares them
+    std::mutex        knownOffsetsMutex{};
+    std::vector<Vec2> knownOffsets{ Vec2{ 0, 0 } };
+
+    ThreadPool::Shared().ParallelFor(animations.size(), [&](size_t begin, size_t end) {
+        for (size_t i{ begin }; i < end; ++i)
+            {
+                const auto& animation{ animations[i] };
+                auto&       result{ report.Results[i] };
+                result.AnimationName = animation.AnimationName;
+                result.PreviousUv    = animation.Uv;
+                result.NewUv         = animation.Uv;
+
+                if (!previousPyramid[0].Contains(animation.Uv))
+                    {
+                        continue;
+                    }
+                if (IsFlat(previousPyramid[0], animation.Uv))
+                    {
+                        result.Ambiguous  = true;
+                        result.Confidence = MatchConfidence(previousPyramid[0], nextPyramid[0], animation, {});
+                        continue;
+                    }
+
+                std::vector<Vec2> offsets{};
+                {
+                    std::lock_guard<std::mutex> lock{ knownOffsetsMutex };
+                    offsets = knownOffsets;
+                }
+
+                // Cheap hypotheses first, no motion then the offsets of the other animations
+                Vec2     bestOffset{};
+                uint64_t bestSad{ NO_MATCH };
+                for (const Vec2& offset : offsets)
+                    {
+                        const auto sad{ AnimationSad(previousPyramid[0], nextPyramid[0], animation, offset) };
+                        if (sad < bestSad)
+                            {
+                                bestSad    = sad;
+                                bestOffset = offset;
+                            }
+                        if (sad == 0)
+                            {
+                                break;
+                            }
+                    }
+
+                if (bestSad != 0)
+                    {
+                        const Vec2 offset{ SearchTemplate(previousPyramid, nextPyramid, animation.Uv) };
+                        const auto sad{ AnimationSad(previousPyramid[0], nextPyramid[0], animation, offset) };
+                        if (sad < bestSad)
+                            {
+                                bestSad    = sad;
+                                bestOffset = offset;
+                            }
+                        if (sad == 0)
+                            {
+                                std::lock_guard<std::mutex> lock{ knownOffsetsMutex };
+                                if (knownOffsets.size() < MAX_KNOWN_OFFSETS)
+                                    {
+                                        knownOffsets.push_back(offset);
+                                    }
+                            }
+                    }
+
+                result.Confidence = MatchConfidence(previousPyramid[0], nextPyramid[0], animation, bestOffset);
+                result.NewUv.x += bestOffset.x;
+                result.NewUv.y += bestOffset.y;
+            }
+    });
+
+    for (const auto& result : report.Results)
+        {
+            if (result.Ambiguous || result.Confidence < MIN_REMAP_CONFIDENCE)
+                {
+                    ++report.NumLowConfidence;
+                }
+            else if (result.NewUv.x != result.PreviousUv.x || result.NewUv.y != result.PreviousUv.y)
+                {
+                    ++report.NumMoved;
+                }
+        }
+
+    report.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+bool
+HasAnyFrameChanged(const UvRemapPixels& previous, const UvRemapPixels& next, const std::vector<UvRemapInput>& animations)
+{
+    for (const auto& animation : animations)
+        {
+            const Rect& r{ animation.Uv };
+            if (r.x < 0 || r.y < 0 || r.w <= 0 || r.h <= 0 || r.x + r.w > previous.Width || r.y + r.h > previous.Height)
+                {
+                    continue;
+                }
+            if (r.x + r.w > next.Width || r.y + r.h > next.Height)
+                {
+                    return true;
+                }
+            for (int32_t y{ r.y }; y < r.y + r.h; ++y)
+                {
+                    const uint8_t* previousRow{ previous.Rgba + (static_cast<size_t>(y) * previous.Width + r.x) * 4 };
+                    const uint8_t* nextRow{ next.Rgba + (static_cast<size_t>(y) * next.Width + r.x) * 4 };
+                    if (std::memcmp(previousRow, nextRow, static_cast<size_t>(r.w) * 4) != 0)
+                        {
+                            return true;
+                        }
+                }
+        }
+    return false;
+}
@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "geometry_types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The search of the moved frames, kept free of raylib so it can be tested headless
+
+/**
+ * \brief Results below this confidence are reported but not applied.
+ */
+constexpr float MIN_REMAP_CONFIDENCE{ 0.92f };
+
+/**
+ * \brief RGBA8 pixels of a version of the sprite.
+ */
+struct UvRemapPixels
+{
+    const uint8_t* Rgba{};
+    int32_t        Width{};
+    int32_t        Height{};
+};
+
+struct UvRemapInput
+{
+    std::string AnimationName{};
+    Rect        Uv{};
+    int32_t     NumOfFrames{ 1 };
+    int32_t     Columns{ 1 };
+};
+
+struct UvRemapResult
+{
+    std::string AnimationName{};
+    Rect        PreviousUv{};
+    Rect        NewUv{};
+    /**
+     * \brief 1 when every frame matches exactly at the new position, 0 when the match is no closer than an empty area.
+     * The difference is relative to the content of the frames, a mostly transparent frame does not match blank space.
+     */
+    float Confidence{};
+    /**
+     * \brief The frame has no distinctive pixels (e.g. fully transparent), any position would match.
+     */
+    bool Ambiguous{};
+};
+
+struct UvRemapReport
+{
+    std::vector<UvRemapResult> Results{};
+    int32_t                    NumMoved{};
+    int32_t                    NumLowConfidence{};
+    double                     Seconds{};
+
+    std::string ToString() const;
+};
+
+/**
+ * \brief Locates the frames of every animation of the previous image in the next one.
+ * Each animation is matched by the sum of absolute differences on a coarse to fine pyramid, offsets found by
+ * other animations are tried first since a layout change usually moves whole blocks together. Runs on all cores.
+ * A match covering a different number of non transparent pixels than the frames has a zero confidence.
+ */
+UvRemapReport FindRemappedUvs(const UvRemapPixels& previous, const UvRemapPixels& next, const std::vector<UvRemapInput>& animations);
+
+/**
+ * \brief Cheap check comparing the first frame of every animation in place, no remap is needed if none changed.
+ */
+bool HasAnyFrameChanged(const UvRemapPixels& previous, const UvRemapPixels& next, const std::vector<UvRemapInput>& animations);
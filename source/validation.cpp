@@ -0,0 +1,445 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "validation.hpp"
+
+#include "frame_layout.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+
+namespace
+{
+constexpr std::string_view INTEGER_FIELDS[]{ "x", "y", "width", "height", "frames", "columns", "durationMs" };
+
+int32_t
+ClampToInt32(int64_t value)
+{
+    return static_cast<int32_t>(std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()));
+}
+
+/**
+ * \brief "frame 2" or "3 frames ..., the first is frame 2".
+ */
+std::string
+DescribeFrames(int32_t count, int32_t firstFrame, const std::string& singular, const std::string& plural)
+{
+    if (count == 1)
+        {
+            return "frame " + std::to_string(firstFrame) + " " + singular;
+        }
+    return std::to_string(count) + " frames " + plural + ", the first is frame " + std::to_string(firstFrame);
+}
+
+/**
+ * \brief Whether any pixel of the row has a non zero alpha.
+ */
+bool
+HasOpaquePixel(const uint8_t* row, int32_t numPixels)
+{
+    int32_t x{};
+#ifdef SPRITE_UV_SSE2
+    const __m128i alphaMask{ _mm_set1_epi32(static_cast<int32_t>(0xFF000000u)) };
+    const __m128i zero{ _mm_setzero_si128() };
+    for (; x + 4 <= numPixels; x += 4)
+        {
+            const __m128i alpha{ _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(x) * 4)), alphaMask) };
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(alpha, zero)) != 0xFFFF)
+                {
+                    return true;
+                }
+        }
+#endif
+    for (; x < numPixels; ++x)
+        {
+            if (row[static_cast<size_t>(x) * 4 + 3] != 0)
+                {
+                    return true;
+                }
+        }
+    return false;
+}
+}
+
+std::string
+ValidationIssue::ToString() const
+{
+    std::string str{ Severity == EValidationSeverity::FATAL ? "error: " : "warning: " };
+    if (!Animation.empty())
+        {
+            str += Animation + ": ";
+        }
+    return str + Message;
+}
+
+std::vector<FrameOverlap>
+FindFrameOverlaps(const std::vector<PlacedFrame>& frames)
+{
+    std::vector<size_t> order(frames.size());
+    std::iota(order.begin(), order.end(), size_t{});
+    std::sort(order.begin(), order.end(), [&frames](size_t a, size_t b) {
+        return std::tie(frames[a].Page, frames[a].Bounds.x, a) < std::tie(frames[b].Page, frames[b].Bounds.x, b);
+    });
+
+    // The frames crossing the sweep line, by top edge and by right edge
+    using ActiveFrame = std::pair<int64_t, size_t>;
+    std::vector<FrameOverlap>                                                              overlaps{};
+    std::set<ActiveFrame>                                                                  activeByTop{};
+    std::priority_queue<ActiveFrame, std::vector<ActiveFrame>, std::greater<ActiveFrame>> activeByRight{};
+    // Only grows while frames are active, an overestimate only widens the search
+    int64_t                                                                                tallest{};
+    int32_t                                                                                page{ std::numeric_limits<int32_t>::min() };
+    for (const size_t index : order)
+        {
+            const PlacedFrame& frame{ frames[index] };
+            if (frame.Bounds.w <= 0 || frame.Bounds.h <= 0)
+                {
+                    continue;
+                }
+            if (frame.Page != page)
+                {
+                    page = frame.Page;
+                    activeByTop.clear();
+                    activeByRight = {};
+                }
+            // The active frames ending before this one can not overlap it nor any frame after it
+            while (!activeByRight.empty() && activeByRight.top().first <= frame.Bounds.x)
+                {
+                    const size_t retired{ activeByRight.top().second };
+                    activeByRight.pop();
+                    activeByTop.erase({ frames[retired].Bounds.y, retired });
+                }
+            if (activeByTop.empty())
+                {
+                    tallest = 0;
+                }
+
+            // Every active frame overlaps horizontally, the ones overlapping vertically start less than the tallest height above
+            const int64_t top{ frame.Bounds.y };
+            const int64_t bottom{ top + frame.Bounds.h };
+            for (auto it{ activeByTop.lower_bound({ top - tallest + 1, 0 }) }; it != activeByTop.end() && it->first < bottom; ++it)
+                {
+                    const PlacedFrame& other{ frames[it->second] };
+                    const int64_t      otherBottom{ static_cast<int64_t>(other.Bounds.y) + other.Bounds.h };
+                    if (otherBottom <= top || other.Animation == frame.Animation)
+                        {
+                            continue;
+                        }
+                    const int64_t left{ frame.Bounds.x };
+                    const int64_t right{ std::min(static_cast<int64_t>(other.Bounds.x) + other.Bounds.w, left + frame.Bounds.w) };
+                    const int64_t intersectionTop{ std::max<int64_t>(top, other.Bounds.y) };
+                    const Rect    intersection{ frame.Bounds.x, static_cast<int32_t>(intersectionTop), static_cast<int32_t>(right - left),
+                        static_cast<int32_t>(std::min(bottom, otherBottom) - intersectionTop) };
+                    overlaps.push_back({ std::min(index, it->second), std::max(index, it->second), intersection });
+                }
+
+            activeByTop.emplace(top, index);
+            activeByRight.emplace(static_cast<int64_t>(frame.Bounds.x) + frame.Bounds.w, index);
+            tallest = std::max<int64_t>(tallest, frame.Bounds.h);
+        }
+    return overlaps;
+}
+
+bool
+IsFrameTransparent(const PagePixels& pixels, const Rect& frame)
+{
+    const int32_t left{ std::max(0, frame.x) };
+    const int32_t top{ std::max(0, frame.y) };
+    const int32_t right{ static_cast<int32_t>(std::min<int64_t>(pixels.Width, static_cast<int64_t>(frame.x) + frame.w)) };
+    const int32_t bottom{ static_cast<int32_t>(std::min<int64_t>(pixels.Height, static_cast<int64_t>(frame.y) + frame.h)) };
+    for (int32_t y{ top }; y < bottom; ++y)
+        {
+            if (left < right && HasOpaquePixel(pixels.Rgba + (static_cast<size_t>(y) * pixels.Width + left) * 4, right - left))
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+void
+FrameValidator::CheckAnimation(CheckedAnimation& animation, int32_t animationIndex, const std::vector<PagePixels>& pagePixels) const
+{
+    const FrameLayout& layout{ animation.Layout };
+    animation.Frames.clear();
+    animation.Issues.clear();
+    animation.Annotations.clear();
+    if (layout.Uv.w <= 0 || layout.Uv.h <= 0 || layout.NumFrames < 1)
+        {
+            return;
+        }
+
+    const int32_t numFrames{ std::min(layout.NumFrames, MAX_CHECKED_FRAMES) };
+    if (layout.NumFrames > MAX_CHECKED_FRAMES)
+        {
+            animation.Issues.push_back({ EValidationSeverity::WARNING, animation.Name, "more than " + std::to_string(MAX_CHECKED_FRAMES) + " frames, only the first are checked" });
+        }
+    const Vec2        pageSize{ layout.Page >= 0 && static_cast<size_t>(layout.Page) < _pageSizes.size() ? _pageSizes[layout.Page] : Vec2{} };
+    const PagePixels* pixels{ layout.Page >= 0 && static_cast<size_t>(layout.Page) < pagePixels.size() && pagePixels[layout.Page].Rgba ? &pagePixels[layout.Page] : nullptr };
+    int32_t           numOutside{};
+    int32_t           firstOutside{};
+    int32_t           numEmpty{};
+    int32_t           firstEmpty{};
+    animation.Frames.reserve(static_cast<size_t>(numFrames));
+    for (int32_t i{}; i < numFrames; ++i)
+        {
+            const int64_t x{ static_cast<int64_t>(layout.Uv.x) + frame::OffsetX(i, layout.Columns, layout.Uv.w) };
+            const int64_t y{ static_cast<int64_t>(layout.Uv.y) + frame::OffsetY(i, layout.Columns, layout.Uv.h) };
+            const Rect    bounds{ ClampToInt32(x), ClampToInt32(y), layout.Uv.w, layout.Uv.h };
+            animation.Frames.push_back({ animationIndex, i, layout.Page, bounds });
+
+            // Unknown page sizes are not checked, the page issue is reported by the project checks
+            if (pageSize.x > 0 && pageSize.y > 0 && (x < 0 || y < 0 || x + layout.Uv.w > pageSize.x || y + layout.Uv.h > pageSize.y))
+                {
+                    firstOutside = numOutside++ == 0 ? i : firstOutside;
+                    animation.Annotations.push_back({ EFrameIssue::OUTSIDE_PAGE, layout.Page, bounds });
+                }
+            else if (pixels && IsFrameTransparent(*pixels, bounds))
+                {
+                    firstEmpty = numEmpty++ == 0 ? i : firstEmpty;
+                    animation.Annotations.push_back({ EFrameIssue::EMPTY, layout.Page, bounds });
+                }
+        }
+    if (numOutside > 0)
+        {
+            const std::string page{ "page " + std::to_string(layout.Page) + " (" + std::to_string(pageSize.x) + "x" + std::to_string(pageSize.y) + ")" };
+            animation.Issues.push_back({ EValidationSeverity::FATAL, animation.Name, DescribeFrames(numOutside, firstOutside, "is outside " + page, "are outside " + page) });
+        }
+    if (numEmpty > 0)
+        {
+            animation.Issues.push_back({ EValidationSeverity::WARNING, animation.Name, DescribeFrames(numEmpty, firstEmpty, "is fully transparent", "are fully transparent") });
+        }
+}
+
+bool
+FrameValidator::Update(const std::vector<std::string_view>& names, const std::vector<FrameLayout>& layouts, const std::vector<Vec2>& pageSizes,
+                       const std::vector<PagePixels>& pagePixels, uint64_t pixelsVersion)
+{
+    const bool pagesChanged{ pageSizes.size() != _pageSizes.size() || !std::equal(pageSizes.begin(), pageSizes.end(), _pageSizes.begin(), [](const Vec2& a, const Vec2& b) {
+                                 return a.x == b.x && a.y == b.y;
+                             }) };
+    const bool checkAll{ pagesChanged || pixelsVersion != _pixelsVersion };
+    _pageSizes     = pageSizes;
+    _pixelsVersion = pixelsVersion;
+
+    // An animation is checked again when the one at its list index is another one or changed
+    const bool resized{ _animations.size() != layouts.size() };
+    _numChecked = 0;
+    _animations.resize(layouts.size());
+    for (size_t i{}; i < layouts.size(); ++i)
+        {
+            CheckedAnimation& animation{ _animations[i] };
+            if (!checkAll && animation.Name == names[i] && animation.Layout == layouts[i])
+                {
+                    continue;
+                }
+            animation.Name   = names[i];
+            animation.Layout = layouts[i];
+            CheckAnimation(animation, static_cast<int32_t>(i), pagePixels);
+            ++_numChecked;
+        }
+    if (_numChecked == 0 && !resized)
+        {
+            return false;
+        }
+
+    _issues.clear();
+    _annotations.clear();
+    std::vector<PlacedFrame> frames{};
+    for (const auto& animation : _animations)
+        {
+            _issues.insert(_issues.end(), animation.Issues.begin(), animation.Issues.end());
+            _annotations.insert(_annotations.end(), animation.Annotations.begin(), animation.Annotations.end());
+            frames.insert(frames.end(), animation.Frames.begin(), animation.Frames.end());
+        }
+
+    // One issue per pair of animations, reported on the first one in list order
+    std::map<std::pair<int32_t, int32_t>, int32_t> overlapCounts{};
+    for (const FrameOverlap& overlap : FindFrameOverlaps(frames))
+        {
+            const PlacedFrame& first{ frames[overlap.First] };
+            const PlacedFrame& second{ frames[overlap.Second] };
+            ++overlapCounts[{ std::min(first.Animation, second.Animation), std::max(first.Animation, second.Animation) }];
+            _annotations.push_back({ EFrameIssue::OVERLAP, first.Page, overlap.Intersection });
+        }
+    for (const auto& [pair, count] : overlapCounts)
+        {
+            const std::string other{ "'" + _animations[pair.second].Name + "'" };
+            _issues.push_back({ EValidationSeverity::WARNING, _animations[pair.first].Name,
+                count == 1 ? "a frame overlaps a frame of " + other : std::to_string(count) + " frame pairs overlap with " + other });
+        }
+    return true;
+}
+
+std::vector<ValidationIssue>
+ValidateProjectJson(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes)
+{
+    std::vector<ValidationIssue> issues{};
+    const auto addIssue = [&issues](EValidationSeverity severity, std::string animation, std::string message) {
+        issues.push_back({ severity, std::move(animation), std::move(message) });
+    };
+
+    if (!j.is_object() || !j.contains("animations") || !j.at("animations").is_array())
+        {
+            addIssue(EValidationSeverity::FATAL, {}, "missing the animations array");
+            return issues;
+        }
+
+    const auto& animations{ j.at("animations") };
+    if (j.contains("pages") && (!j.at("pages").is_array() || !std::all_of(j.at("pages").begin(), j.at("pages").end(), [](const auto& page) { return page.is_string(); })))
+        {
+            addIssue(EValidationSeverity::FATAL, {}, "pages must be an array of paths");
+        }
+    for (size_t page{}; page < pageSizes.size(); ++page)
+        {
+            if (pageSizes[page].x <= 0 || pageSizes[page].y <= 0)
+                {
+                    addIssue(EValidationSeverity::FATAL, {}, "page " + std::to_string(page) + " can not be read");
+                }
+        }
+    if (!j.contains("selectedAnimationIndex") || !j.at("selectedAnimationIndex").is_number_integer())
+        {
+            addIssue(EValidationSeverity::FATAL, {}, "missing the selectedAnimationIndex");
+        }
+    else if (const auto selected{ j.at("selectedAnimationIndex").get<int64_t>() }; selected < -1 || selected >= static_cast<int64_t>(animations.size()))
+        {
+            addIssue(EValidationSeverity::FATAL, {}, "selectedAnimationIndex out of range");
+        }
+
+    std::unordered_set<std::string_view> names{};
+    // The well formed sprite sheets, their frames are checked last
+    std::vector<std::string_view>        frameNames{};
+    std::vector<FrameLayout>             frameLayouts{};
+    for (size_t i{}; i < animations.size(); ++i)
+        {
+            const auto& animJson{ animations[i] };
+            if (!animJson.is_object() || !animJson.contains("name") || !animJson.at("name").is_string() || animJson.at("name").get_ref<const std::string&>().empty())
+                {
+                    addIssue(EValidationSeverity::FATAL, "#" + std::to_string(i), "missing the name");
+                    continue;
+                }
+            const auto& name{ animJson.at("name").get_ref<const std::string&>() };
+            if (!names.insert(name).second)
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "duplicated name");
+                }
+
+            const auto type{ animJson.value("type", std::string{}) };
+            if (type == "Keyframe")
+                {
+                    addIssue(EValidationSeverity::WARNING, name, "keyframe animations are not supported yet");
+                    continue;
+                }
+            if (type != "Spritesheet")
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "unknown type '" + type + "'");
+                    continue;
+                }
+
+            bool hasAllFields{ true };
+            for (const auto field : INTEGER_FIELDS)
+                {
+                    const auto found{ animJson.find(field) };
+                    if (found == animJson.end() || !found->is_number_integer())
+                        {
+                            addIssue(EValidationSeverity::FATAL, name, "missing the integer " + std::string{ field });
+                            hasAllFields = false;
+                        }
+                }
+            if (!animJson.contains("looping") || !animJson.at("looping").is_boolean())
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "missing the boolean looping");
+                }
+            if (animJson.contains("page") && !animJson.at("page").is_number_integer())
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "page must be an integer");
+                    hasAllFields = false;
+                }
+            if (!hasAllFields)
+                {
+                    continue;
+                }
+
+            if (animJson.at("width").get<int64_t>() <= 0 || animJson.at("height").get<int64_t>() <= 0)
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "empty frame size");
+                }
+            const auto numFrames{ animJson.at("frames").get<int64_t>() };
+            const auto durationMs{ animJson.at("durationMs").get<int64_t>() };
+            if (numFrames < 1)
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "needs at least one frame");
+                }
+            if (animJson.at("columns").get<int64_t>() < 1)
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "needs at least one column");
+                }
+            if (durationMs < 0)
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "negative frame duration");
+                }
+            else if (durationMs == 0 && numFrames > 1)
+                {
+                    addIssue(EValidationSeverity::WARNING, name, "zero frame duration, only the first frame is shown");
+                }
+            if (numFrames > std::numeric_limits<int32_t>::max() || durationMs > std::numeric_limits<int32_t>::max())
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "frame count or duration out of range");
+                }
+            // The exports store the total duration in 32 bits
+            else if (numFrames >= 1 && numFrames * durationMs > std::numeric_limits<uint32_t>::max())
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "total duration of " + std::to_string(numFrames * durationMs) + " ms is too long");
+                }
+            if (const auto page{ animJson.value("page", int64_t{}) }; page < 0 || page >= static_cast<int64_t>(std::max<size_t>(1, pageSizes.size())))
+                {
+                    addIssue(EValidationSeverity::FATAL, name, "page " + std::to_string(page) + " does not exist");
+                }
+            frameNames.push_back(name);
+            frameLayouts.push_back({ { ClampToInt32(animJson.at("x").get<int64_t>()), ClampToInt32(animJson.at("y").get<int64_t>()),
+                                       ClampToInt32(animJson.at("width").get<int64_t>()), ClampToInt32(animJson.at("height").get<int64_t>()) },
+                ClampToInt32(animJson.at("frames").get<int64_t>()), ClampToInt32(animJson.at("columns").get<int64_t>()), ClampToInt32(animJson.value("page", int64_t{})) });
+        }
+
+    FrameValidator frameValidator{};
+    frameValidator.Update(frameNames, frameLayouts, pageSizes);
+    issues.insert(issues.end(), frameValidator.GetIssues().begin(), frameValidator.GetIssues().end());
+    return issues;
+}
+
+bool
+HasValidationErrors(const std::vector<ValidationIssue>& issues)
+{
+    return std::any_of(issues.begin(), issues.end(), [](const ValidationIssue& issue) { return issue.Severity == EValidationSeverity::FATAL; });
+}
@@ -0,0 +1,191 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include "geometry_types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class EValidationSeverity : uint8_t
+{
+    WARNING,
+    /**
+     * \brief The project can not be exported.
+     */
+    FATAL,
+};
+
+struct ValidationIssue
+{
+    EValidationSeverity Severity{};
+    /**
+     * \brief Empty for the issues of the project itself.
+     */
+    std::string Animation{};
+    std::string Message{};
+
+    std::string ToString() const;
+};
+
+enum class EFrameIssue : uint8_t
+{
+    OUTSIDE_PAGE,
+    OVERLAP,
+    EMPTY,
+};
+
+/**
+ * \brief A sprite sheet as the frame checks see it, the first frame rect then the frames wrapping after the columns.
+ */
+struct FrameLayout
+{
+    Rect    Uv{};
+    int32_t NumFrames{};
+    int32_t Columns{};
+    int32_t Page{};
+
+    bool operator==(const FrameLayout& other) const
+    {
+        return Uv.x == other.Uv.x && Uv.y == other.Uv.y && Uv.w == other.Uv.w && Uv.h == other.Uv.h && NumFrames == other.NumFrames && Columns == other.Columns &&
+               Page == other.Page;
+    }
+    bool operator!=(const FrameLayout& other) const { return !(*this == other); }
+};
+
+/**
+ * \brief RGBA8 pixels of a page for the empty frame check, null if the page is not on the CPU.
+ */
+struct PagePixels
+{
+    const uint8_t* Rgba{};
+    int32_t        Width{};
+    int32_t        Height{};
+};
+
+/**
+ * \brief What the canvas highlights, in pixels of the page.
+ */
+struct FrameAnnotation
+{
+    EFrameIssue Issue{};
+    int32_t     Page{};
+    /**
+     * \brief The frame, or the intersection of the two frames for an overlap.
+     */
+    Rect        Bounds{};
+};
+
+/**
+ * \brief A frame of the project, placed on its page.
+ */
+struct PlacedFrame
+{
+    int32_t Animation{};
+    int32_t Frame{};
+    int32_t Page{};
+    Rect    Bounds{};
+};
+
+struct FrameOverlap
+{
+    size_t First{};
+    size_t Second{};
+    Rect   Intersection{};
+};
+
+/**
+ * \brief Every overlapping pair of frames of different animations on the same page. Sweeps the frames by their left edge, the active frames
+ * are kept sorted by their top edge thus a frame only visits the active frames within the tallest active height above it:
+ * O(n log n + k) for frames of similar heights instead of comparing every pair.
+ */
+std::vector<FrameOverlap> FindFrameOverlaps(const std::vector<PlacedFrame>& frames);
+
+/**
+ * \brief True if every pixel of the frame, clipped to the page, has a zero alpha.
+ */
+bool IsFrameTransparent(const PagePixels& pixels, const Rect& frame);
+
+/**
+ * \brief Checks the frames of every sprite sheet: frames outside their page are errors, frames overlapping a frame of another animation and
+ * fully transparent frames are warnings. Incremental, an animation keeps its results while its name, layout and page do not change, only the
+ * overlap sweep runs again over every frame.
+ */
+class FrameValidator final
+{
+  public:
+    /**
+     * \brief Checking more frames than this per animation would stall on a corrupted frame count.
+     */
+    constexpr static int32_t MAX_CHECKED_FRAMES{ 65536 };
+
+    /**
+     * \param names Parallel to the layouts, in list order.
+     * \param pagePixels Per page, the empty frame check is skipped for the pages not on the CPU.
+     * \param pixelsVersion Changes whenever the pixels do, the empty frames are then checked again.
+     * \return True if anything was checked again.
+     */
+    bool Update(const std::vector<std::string_view>& names, const std::vector<FrameLayout>& layouts, const std::vector<Vec2>& pageSizes,
+                const std::vector<PagePixels>& pagePixels = {}, uint64_t pixelsVersion = 0);
+
+    const std::vector<ValidationIssue>& GetIssues() const { return _issues; }
+    const std::vector<FrameAnnotation>& GetAnnotations() const { return _annotations; }
+    /**
+     * \brief Animations checked again by the last update.
+     */
+    size_t                              GetNumChecked() const { return _numChecked; }
+
+  private:
+    struct CheckedAnimation
+    {
+        std::string                  Name{};
+        FrameLayout                  Layout{};
+        std::vector<PlacedFrame>     Frames{};
+        std::vector<ValidationIssue> Issues{};
+        std::vector<FrameAnnotation> Annotations{};
+    };
+
+    std::vector<CheckedAnimation> _animations{};
+    std::vector<Vec2>             _pageSizes{};
+    uint64_t                      _pixelsVersion{};
+    std::vector<ValidationIssue>  _issues{};
+    std::vector<FrameAnnotation>  _annotations{};
+    size_t                        _numChecked{};
+
+    void CheckAnimation(CheckedAnimation& animation, int32_t animationIndex, const std::vector<PagePixels>& pagePixels) const;
+};
+
+/**
+ * \brief Checks a project file the way Project::Deserialize reads it, without throwing: every issue is reported, not only the first.
+ * The frames of the well formed sprite sheets are then checked by a FrameValidator, without the pixels.
+ * Kept free of raylib so it can run headless.
+ */
+std::vector<ValidationIssue> ValidateProjectJson(const nlohmann::ordered_json& j, const std::vector<Vec2>& pageSizes);
+
+bool HasValidationErrors(const std::vector<ValidationIssue>& issues);
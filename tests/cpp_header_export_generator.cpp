@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Writes the C++ header export of animations named from ESCAPED_NAMES, compiled by cpp_header_export_test
+
+#include "escaped_names.hpp"
+#include "export_format.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+int
+main(int argc, char** argv)
+{
+    if (argc != 2)
+        {
+            std::fprintf(stderr, "Usage: cpp_header_export_generator <output.hpp>\n");
+            return EXIT_FAILURE;
+        }
+
+    nlohmann::ordered_json j{};
+    j["animations"] = nlohmann::ordered_json::array();
+    int32_t y{};
+    for (const char* name : ESCAPED_NAMES)
+        {
+            nlohmann::ordered_json animJson{};
+            animJson["name"]       = name;
+            animJson["type"]       = "Spritesheet";
+            animJson["x"]          = 0;
+            animJson["y"]          = y;
+            animJson["width"]      = 16;
+            animJson["height"]     = 16;
+            animJson["frames"]     = 2;
+            animJson["columns"]    = 2;
+            animJson["durationMs"] = 100;
+            animJson["looping"]    = true;
+            j["animations"].push_back(animJson);
+            y += 16;
+        }
+
+    std::ofstream file{ argv[1], std::ios::binary };
+    file << BuildCppHeaderExport(j, { { 32, 256 } }, "test_animations");
+    return file ? EXIT_SUCCESS : EXIT_FAILURE;
+}
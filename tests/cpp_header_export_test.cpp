@@ -0,0 +1,56 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Compiles the generated header with every warning as an error, then checks the names survived the escaping
+
+#include "escaped_names.hpp"
+#include "test_animations.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+static_assert(test_animations::ANIMATION_COUNT == sizeof(ESCAPED_NAMES) / sizeof(ESCAPED_NAMES[0]));
+static_assert(test_animations::Find("tab\there") == static_cast<test_animations::EAnimation>(2));
+static_assert(test_animations::Find("\?\?/") == static_cast<test_animations::EAnimation>(7));
+
+int
+main()
+{
+    int32_t numFailures{};
+    for (uint32_t i{}; i < static_cast<uint32_t>(test_animations::ANIMATION_COUNT); ++i)
+        {
+            if (std::string_view{ test_animations::ANIMATIONS[i].name } != ESCAPED_NAMES[i])
+                {
+                    std::fprintf(stderr, "FAILED: name %u does not match\n", i);
+                    ++numFailures;
+                }
+        }
+    if (numFailures > 0)
+        {
+            return EXIT_FAILURE;
+        }
+    std::printf("cpp_header_export_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+// Animation names the generated C++ header must escape, shared by the generator and the test compiling its output.
+// Control characters, quotes, backslashes, trigraph sequences and hex digits after a hex escape.
+inline constexpr const char* ESCAPED_NAMES[]{
+    "Idle",
+    "new\nline",
+    "tab\there",
+    "carriage\rreturn",
+    "quote\"d",
+    "back\\slash",
+    "trigraph\?\?=",
+    "\?\?/",
+    "question?",
+    "bell\a",
+    "hex\x01" "F",
+    "del\x7F" "7",
+    "caf\xC3\xA9",
+};
@@ -0,0 +1,165 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Round trip of the binary export: the json written by the editor, built by BuildBinaryExport, read back by the runtime reader
+
+#include "export_format.hpp"
+#include "frame_layout.hpp"
+
+#include <sprite_uv/runtime.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+int32_t numFailures{};
+
+void
+Check(bool condition, const std::string& what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+            ++numFailures;
+        }
+}
+
+// Same layout as Project::SerializeAnimationData
+nlohmann::ordered_json
+MakeProjectJson()
+{
+    nlohmann::ordered_json j = nlohmann::ordered_json::parse(R"({
+        "animations": [
+            { "name": "Idle", "type": "Spritesheet", "x": 0, "y": 0, "width": 32, "height": 32, "frames": 8, "columns": 4, "durationMs": 100, "looping": true },
+            { "name": "Jump", "type": "Spritesheet", "x": 128, "y": 16, "width": 24, "height": 40, "frames": 3, "columns": 3, "durationMs": 75, "looping": false },
+            { "name": "Hit on page 1", "type": "Spritesheet", "x": 8, "y": 8, "width": 48, "height": 48, "frames": 5, "columns": 2, "durationMs": 50, "looping": true, "page": 1 },
+            { "name": "Still", "type": "Spritesheet", "x": 250, "y": 100, "width": 6, "height": 28, "frames": 1, "columns": 1, "durationMs": 0, "looping": false }
+        ],
+        "pages": [ "sprite_page1.png" ]
+    })");
+    // Enough animations to fill the lookup table with collisions
+    for (int32_t i{}; i < 200; ++i)
+        {
+            nlohmann::ordered_json animJson{};
+            animJson["name"]       = "Generated_" + std::to_string(i);
+            animJson["type"]       = "Spritesheet";
+            animJson["x"]          = (i * 7) % 200;
+            animJson["y"]          = (i * 13) % 100;
+            animJson["width"]      = 4 + i % 9;
+            animJson["height"]     = 3 + i % 5;
+            animJson["frames"]     = 1 + i % 6;
+            animJson["columns"]    = 1 + i % 4;
+            animJson["durationMs"] = 16 * (1 + i % 3);
+            animJson["looping"]    = i % 2 == 0;
+            j["animations"].push_back(animJson);
+        }
+    return j;
+}
+
+bool
+IsNear(float value, float expected)
+{
+    return std::abs(value - expected) <= 1e-6f * std::max(1.f, std::abs(expected));
+}
+}
+
+int
+main()
+{
+    const nlohmann::ordered_json j = MakeProjectJson();
+    const std::vector<Vec2>      pageSizes{ { 256, 128 }, { 512, 256 } };
+    const std::vector<uint8_t>   buffer{ BuildBinaryExport(j, pageSizes) };
+
+    const auto set{ sprite_uv::AnimationSet::FromMemory(buffer.data(), buffer.size()) };
+    Check(set.has_value(), "the export is accepted by the reader");
+    if (!set.has_value())
+        {
+            return EXIT_FAILURE;
+        }
+    Check(set->GetTextureWidth() == 256 && set->GetTextureHeight() == 128, "the texture size is the sprite size");
+    Check(set->GetAnimations().size() == j.at("animations").size(), "every animation is exported");
+
+    for (const auto& animJson : j.at("animations"))
+        {
+            const std::string name{ animJson.at("name").get<std::string>() };
+            const auto*       animation{ set->Find(name) };
+            Check(animation != nullptr, name + ": found by name");
+            if (!animation)
+                {
+                    continue;
+                }
+            Check(set->FindByHash(sprite_uv::HashName(name)) == animation, name + ": found by hash");
+            Check(set->GetName(*animation) == name, name + ": name");
+
+            const int32_t frames{ animJson.at("frames").get<int32_t>() };
+            const int32_t columns{ animJson.at("columns").get<int32_t>() };
+            const int32_t durationMs{ animJson.at("durationMs").get<int32_t>() };
+            const int32_t page{ animJson.value("page", 0) };
+            Check(animation->FrameCount == static_cast<uint32_t>(frames), name + ": frame count");
+            Check(sprite_uv::AnimationSet::IsLooping(*animation) == animJson.at("looping").get<bool>(), name + ": looping");
+            Check(sprite_uv::AnimationSet::GetPage(*animation) == static_cast<uint32_t>(page), name + ": page");
+            Check(animation->TotalDurationMs == static_cast<uint32_t>(frames * durationMs), name + ": total duration");
+
+            const Vec2  pageSize{ pageSizes[page] };
+            const auto  uvs{ set->GetFrames(*animation) };
+            const auto  durations{ set->GetDurations(*animation) };
+            const float width{ static_cast<float>(pageSize.x) };
+            const float height{ static_cast<float>(pageSize.y) };
+            for (int32_t f{}; f < frames; ++f)
+                {
+                    const int32_t x{ animJson.at("x").get<int32_t>() + frame::OffsetX(f, columns, animJson.at("width").get<int32_t>()) };
+                    const int32_t y{ animJson.at("y").get<int32_t>() + frame::OffsetY(f, columns, animJson.at("height").get<int32_t>()) };
+                    const auto&   uv{ uvs[f] };
+                    Check(durations[f] == static_cast<uint32_t>(durationMs), name + ": duration of frame " + std::to_string(f));
+                    Check(IsNear(uv.U0, x / width) && IsNear(uv.V0, y / height) && IsNear(uv.U1, (x + animJson.at("width").get<int32_t>()) / width) &&
+                              IsNear(uv.V1, (y + animJson.at("height").get<int32_t>()) / height),
+                          name + ": UV of frame " + std::to_string(f));
+                }
+        }
+    Check(set->Find("Unknown") == nullptr, "an unknown name is not found");
+
+    // The total duration is stored in 32 bits, an animation lasting longer is not truncated but fails the export
+    nlohmann::ordered_json longest = nlohmann::ordered_json::parse(R"({
+        "animations": [ { "name": "Longest", "type": "Spritesheet", "x": 0, "y": 0, "width": 1, "height": 1, "frames": 2, "columns": 1, "durationMs": 2147483647, "looping": true } ]
+    })");
+    const std::vector<uint8_t> longestBuffer{ BuildBinaryExport(longest, pageSizes) };
+    const auto                 longestSet{ sprite_uv::AnimationSet::FromMemory(longestBuffer.data(), longestBuffer.size()) };
+    Check(longestSet.has_value() && longestSet->Find("Longest") && longestSet->Find("Longest")->TotalDurationMs == 4294967294u, "a total duration up to UINT32_MAX is kept");
+    longest["animations"][0]["frames"] = 3;
+    Check(BuildBinaryExport(longest, pageSizes).empty(), "a total duration above UINT32_MAX fails the export");
+
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("export_round_trip_test passed\n");
+    return EXIT_SUCCESS;
+}
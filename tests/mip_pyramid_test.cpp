@@ -0,0 +1,273 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Headless checks of the mip chain kernels, no raylib and no GL context needed
+
+#include "mip_pyramid.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+int32_t numFailures{};
+
+void
+Check(bool condition, const char* what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++numFailures;
+        }
+}
+
+// Rounding differs by one between the SSE2 and the scalar path
+bool
+IsNear(const uint8_t* texel, int32_t r, int32_t g, int32_t b, int32_t a)
+{
+    return std::abs(texel[0] - r) <= 1 && std::abs(texel[1] - g) <= 1 && std::abs(texel[2] - b) <= 1 && std::abs(texel[3] - a) <= 1;
+}
+
+void
+SetTexel(std::vector<uint8_t>& image, int32_t width, int32_t x, int32_t y, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    uint8_t* texel{ &image[(static_cast<size_t>(y) * width + x) * 4] };
+    texel[0] = r;
+    texel[1] = g;
+    texel[2] = b;
+    texel[3] = a;
+}
+
+void
+TestAlphaWeightedAverage()
+{
+    // One opaque red texel among transparent white ones, the white must not bleed into the red
+    std::vector<uint8_t> src(2 * 2 * 4);
+    SetTexel(src, 2, 0, 0, 255, 0, 0, 255);
+    SetTexel(src, 2, 1, 0, 255, 255, 255, 0);
+    SetTexel(src, 2, 0, 1, 255, 255, 255, 0);
+    SetTexel(src, 2, 1, 1, 255, 255, 255, 0);
+    uint8_t dst[4]{};
+    DownsampleImage(src.data(), 2, 2, dst, 1, 1, EMipFilter::BOX);
+    Check(IsNear(dst, 255, 0, 0, 64), "box: the color is weighted by alpha");
+
+    // Half opaque red and half opaque blue average to purple with the mean alpha
+    SetTexel(src, 2, 0, 0, 255, 0, 0, 255);
+    SetTexel(src, 2, 1, 0, 0, 0, 255, 255);
+    SetTexel(src, 2, 0, 1, 255, 0, 0, 255);
+    SetTexel(src, 2, 1, 1, 0, 0, 255, 255);
+    DownsampleImage(src.data(), 2, 2, dst, 1, 1, EMipFilter::BOX);
+    Check(IsNear(dst, 128, 0, 128, 255), "box: opaque texels average evenly");
+}
+
+void
+TestOddSizes()
+{
+    // 3 -> 1, every texel covers the destination fully
+    std::vector<uint8_t> src(3 * 4);
+    SetTexel(src, 3, 0, 0, 0, 0, 0, 255);
+    SetTexel(src, 3, 1, 0, 90, 90, 90, 255);
+    SetTexel(src, 3, 2, 0, 180, 180, 180, 255);
+    uint8_t dst[4 * 2]{};
+    DownsampleImage(src.data(), 3, 1, dst, 1, 1, EMipFilter::BOX);
+    Check(IsNear(dst, 90, 90, 90, 255), "box: 3 -> 1 averages all texels");
+
+    // 5 -> 2, the middle texel is split between both destination texels
+    src.assign(5 * 4, 255);
+    for (int32_t x{}; x < 5; ++x)
+        {
+            const uint8_t value{ static_cast<uint8_t>(x * 50) };
+            SetTexel(src, 5, x, 0, value, value, value, 255);
+        }
+    DownsampleImage(src.data(), 5, 1, dst, 2, 1, EMipFilter::BOX);
+    // (0 * 1 + 50 * 1 + 100 * 0.5) / 2.5 and (100 * 0.5 + 150 * 1 + 200 * 1) / 2.5
+    Check(IsNear(dst, 40, 40, 40, 255), "box: 5 -> 2 first texel");
+    Check(IsNear(dst + 4, 160, 160, 160, 255), "box: 5 -> 2 second texel");
+
+    // A constant image stays constant whatever the size and the filter
+    for (const EMipFilter filter : { EMipFilter::BOX, EMipFilter::LANCZOS })
+        {
+            const int32_t        width{ 7 };
+            const int32_t        height{ 5 };
+            const int32_t        numLevels{ GetNumMipLevels(width, height) };
+            std::vector<uint8_t> chain(GetMipChainBytes(width, height, numLevels));
+            for (size_t i{}; i < static_cast<size_t>(width) * height; ++i)
+                {
+                    chain[i * 4]     = 30;
+                    chain[i * 4 + 1] = 60;
+                    chain[i * 4 + 2] = 90;
+                    chain[i * 4 + 3] = 200;
+                }
+            GenerateMipChain(chain.data(), width, height, numLevels, filter);
+            bool constant{ true };
+            for (size_t i{}; i < chain.size(); i += 4)
+                {
+                    constant = constant && IsNear(&chain[i], 30, 60, 90, 200);
+                }
+            Check(constant, filter == EMipFilter::BOX ? "box: 7x5 constant chain" : "lanczos: 7x5 constant chain");
+        }
+}
+
+void
+TestColumnLevels()
+{
+    // 1x8 -> 1x4 -> 1x2 -> 1x1, the width stays one
+    Check(GetNumMipLevels(1, 8) == 4, "1x8 has 4 levels");
+    Check(GetMipChainBytes(1, 8, 4) == (8 + 4 + 2 + 1) * 4, "1x8 chain bytes");
+    std::vector<uint8_t> chain(GetMipChainBytes(1, 8, 4));
+    for (int32_t y{}; y < 8; ++y)
+        {
+            const uint8_t value{ static_cast<uint8_t>(y * 20) };
+            SetTexel(chain, 1, 0, y, value, value, value, 255);
+        }
+    GenerateMipChain(chain.data(), 1, 8, 4, EMipFilter::BOX);
+    const uint8_t* level1{ &chain[8 * 4] };
+    const uint8_t* level2{ &chain[(8 + 4) * 4] };
+    const uint8_t* level3{ &chain[(8 + 4 + 2) * 4] };
+    Check(IsNear(level1, 10, 10, 10, 255) && IsNear(level1 + 12, 130, 130, 130, 255), "box: 1x8 -> 1x4 averages pairs");
+    Check(IsNear(level2, 30, 30, 30, 255) && IsNear(level2 + 4, 110, 110, 110, 255), "box: 1x4 -> 1x2 averages pairs");
+    Check(IsNear(level3, 70, 70, 70, 255), "box: 1x2 -> 1x1 is the mean");
+}
+
+void
+TestTransparentBlock()
+{
+    // Opaque on the left, transparent white on the right, far from the edge the right stays transparent black
+    const int32_t        size{ 16 };
+    std::vector<uint8_t> src(static_cast<size_t>(size) * size * 4);
+    for (int32_t y{}; y < size; ++y)
+        {
+            for (int32_t x{}; x < size; ++x)
+                {
+                    if (x < size / 2)
+                        {
+                            SetTexel(src, size, x, y, 200, 40, 10, 255);
+                        }
+                    else
+                        {
+                            SetTexel(src, size, x, y, 255, 255, 255, 0);
+                        }
+                }
+        }
+    std::vector<uint8_t> dst(static_cast<size_t>(size / 2) * (size / 2) * 4);
+    for (const EMipFilter filter : { EMipFilter::BOX, EMipFilter::LANCZOS })
+        {
+            DownsampleImage(src.data(), size, size, dst.data(), size / 2, size / 2, filter);
+            // The box reads two texels, the Lanczos kernel four on each side of the center
+            const int32_t firstClear{ filter == EMipFilter::BOX ? size / 4 : size / 4 + 2 };
+            bool          transparent{ true };
+            for (int32_t y{}; y < size / 2; ++y)
+                {
+                    for (int32_t x{ firstClear }; x < size / 2; ++x)
+                        {
+                            transparent = transparent && IsNear(&dst[(static_cast<size_t>(y) * (size / 2) + x) * 4], 0, 0, 0, 0);
+                        }
+                }
+            Check(transparent, filter == EMipFilter::BOX ? "box: transparent block stays transparent" : "lanczos: transparent block stays transparent");
+        }
+
+    // A fully transparent image has fully transparent levels
+    std::vector<uint8_t> chain(GetMipChainBytes(size, size, GetNumMipLevels(size, size)), 0);
+    for (size_t i{}; i < static_cast<size_t>(size) * size * 4; i += 4)
+        {
+            chain[i] = chain[i + 1] = chain[i + 2] = 255;
+        }
+    GenerateMipChain(chain.data(), size, size, GetNumMipLevels(size, size), EMipFilter::LANCZOS);
+    bool transparent{ true };
+    for (size_t i{ static_cast<size_t>(size) * size * 4 }; i < chain.size(); ++i)
+        {
+            transparent = transparent && chain[i] == 0;
+        }
+    Check(transparent, "lanczos: a transparent image has transparent levels");
+}
+
+void
+TestRegionUpdate()
+{
+    // Regenerating the levels of a changed region gives the same chain as generating it all again
+    std::mt19937 random{ 1234 };
+    for (const EMipFilter filter : { EMipFilter::BOX, EMipFilter::LANCZOS })
+        {
+            for (int32_t i{}; i < 100; ++i)
+                {
+                    const int32_t        width{ 1 + static_cast<int32_t>(random() % 97) };
+                    const int32_t        height{ 1 + static_cast<int32_t>(random() % 61) };
+                    const int32_t        numLevels{ GetNumMipLevels(width, height) };
+                    const size_t         levelBytes{ static_cast<size_t>(width) * height * 4 };
+                    std::vector<uint8_t> image(levelBytes);
+                    for (uint8_t& value : image)
+                        {
+                            value = static_cast<uint8_t>(random());
+                        }
+                    std::vector<uint8_t> levels(GetMipChainBytes(width, height, numLevels) - levelBytes);
+                    GenerateMipLevels(image.data(), width, height, numLevels, filter, levels.data());
+
+                    MipRegion region{};
+                    region.X      = static_cast<int32_t>(random() % width);
+                    region.Y      = static_cast<int32_t>(random() % height);
+                    region.Width  = 1 + static_cast<int32_t>(random() % (width - region.X));
+                    region.Height = 1 + static_cast<int32_t>(random() % (height - region.Y));
+                    for (int32_t y{ region.Y }; y < region.Y + region.Height; ++y)
+                        {
+                            for (int32_t x{ region.X }; x < region.X + region.Width; ++x)
+                                {
+                                    SetTexel(image, width, x, y, static_cast<uint8_t>(random()), static_cast<uint8_t>(random()), static_cast<uint8_t>(random()),
+                                             static_cast<uint8_t>(random()));
+                                }
+                        }
+                    std::vector<MipRegion> regions(static_cast<size_t>(numLevels));
+                    UpdateMipLevels(image.data(), width, height, numLevels, filter, levels.data(), region, regions.data());
+
+                    std::vector<uint8_t> expected(levels.size());
+                    GenerateMipLevels(image.data(), width, height, numLevels, filter, expected.data());
+                    if (levels != expected)
+                        {
+                            Check(false, filter == EMipFilter::BOX ? "box: region update matches the full chain" : "lanczos: region update matches the full chain");
+                            break;
+                        }
+                }
+        }
+}
+}
+
+int
+main()
+{
+    TestAlphaWeightedAverage();
+    TestOddSizes();
+    TestColumnLevels();
+    TestTransparentBlock();
+    TestRegionUpdate();
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("mip_pyramid_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+// Headless checks of the name search against a plain substring filter
+
+#include "name_index.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+int32_t numFailures{};
+
+void
+Check(bool condition, const std::string& what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+            ++numFailures;
+        }
+}
+
+std::string
+Lowered(std::string_view str)
+{
+    std::string lowered{ str };
+    for (char& c : lowered)
+        {
+            c = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+    return lowered;
+}
+
+// What the index must answer
+std::vector<uint32_t>
+NaiveSearch(const std::vector<std::string>& names, std::string_view query)
+{
+    const std::string     loweredQuery{ Lowered(query) };
+    std::vector<uint32_t> matches{};
+    for (uint32_t id{}; id < names.size(); ++id)
+        {
+            if (Lowered(names[id]).find(loweredQuery) != std::string::npos)
+                {
+                    matches.push_back(id);
+                }
+        }
+    return matches;
+}
+
+std::string
+RandomString(std::mt19937& random, size_t maxLength)
+{
+    // A small alphabet with both cases, trigrams are shared by many names
+    constexpr char ALPHABET[]{ "abcABC_1" };
+    std::string    str(random() % (maxLength + 1), ' ');
+    for (char& c : str)
+        {
+            c = ALPHABET[random() % (sizeof(ALPHABET) - 1)];
+        }
+    return str;
+}
+
+void
+TestPaths()
+{
+    NameIndex                index{};
+    std::vector<std::string> names{ "Idle", "Walk_Left", "Walk_Right", "Run_Left", "Jump" };
+    for (const auto& name : names)
+        {
+            index.Add(name);
+        }
+
+    // Short queries scan every name
+    Check(index.Search("") == NaiveSearch(names, ""), "an empty query matches every name");
+    Check(index.Search("l") == NaiveSearch(names, "l") && index.GetNumVerified() == names.size(), "a short query scans every name");
+
+    // A fresh query of three characters only verifies the names of its rarest trigram
+    Check(index.Search("RUN") == NaiveSearch(names, "run") && index.GetNumVerified() == 1, "the rarest trigram bounds the work");
+    Check(index.Search("xyz").empty() && index.GetNumVerified() == 0, "an unknown trigram matches nothing");
+
+    // Typing narrows the previous matches, a name added between keystrokes is still found
+    Check(index.Search("wal") == NaiveSearch(names, "wal"), "a prefix");
+    names.push_back("Crawl_Left");
+    index.Add(names.back());
+    Check(index.Search("walk") == NaiveSearch(names, "walk") && index.GetNumVerified() == 3, "an extension verifies the previous matches and the new name");
+    names.push_back("Sidewalk");
+    index.Add(names.back());
+    Check(index.Search("walk") == NaiveSearch(names, "walk"), "the same query after an added name");
+    Check(index.Search("walk_") == NaiveSearch(names, "walk_"), "an extension after an added name");
+}
+
+void
+TestRandomTyping()
+{
+    std::mt19937             random{ 31 };
+    NameIndex                index{};
+    std::vector<std::string> names{};
+    std::string              query{};
+    for (int32_t step{}; step < 5000; ++step)
+        {
+            switch (random() % 8)
+                {
+                    case 0:
+                    case 1:
+                        {
+                            names.push_back(RandomString(random, 10));
+                            Check(index.Add(names.back()) == names.size() - 1, "ids are assigned in insertion order");
+                            break;
+                        }
+                    case 2:
+                    case 3:
+                    case 4: query += RandomString(random, 1); break;
+                    case 5:
+                        {
+                            if (!query.empty())
+                                {
+                                    query.pop_back();
+                                }
+                            break;
+                        }
+                    case 6: query = RandomString(random, 5); break;
+                    default: query.insert(0, RandomString(random, 1)); break;
+                }
+            if (index.Search(query) != NaiveSearch(names, query))
+                {
+                    Check(false, "step " + std::to_string(step) + ": '" + query + "' over " + std::to_string(names.size()) + " names matches the substring filter");
+                    return;
+                }
+        }
+    Check(index.GetSize() == names.size(), "every name is indexed");
+}
+}
+
+int
+main()
+{
+    TestPaths();
+    TestRandomTyping();
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("name_index_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// The runtime reader must reject truncated and corrupt files instead of reading out of them
+
+#include "export_format.hpp"
+
+#include <sprite_uv/runtime.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+using namespace sprite_uv::binary;
+
+int32_t numFailures{};
+
+void
+Check(bool condition, const char* what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++numFailures;
+        }
+}
+
+uint32_t
+GetU32(const std::vector<uint8_t>& buffer, size_t offset)
+{
+    uint32_t value{};
+    std::memcpy(&value, buffer.data() + offset, sizeof(value));
+    return value;
+}
+
+void
+SetU32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+{
+    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+
+std::vector<uint8_t>
+MakeExport()
+{
+    nlohmann::ordered_json j{};
+    j["animations"] = nlohmann::ordered_json::array();
+    for (int32_t i{}; i < 5; ++i)
+        {
+            nlohmann::ordered_json animJson{};
+            animJson["name"]       = "Anim_" + std::to_string(i);
+            animJson["type"]       = "Spritesheet";
+            animJson["x"]          = 0;
+            animJson["y"]          = i * 16;
+            animJson["width"]      = 16;
+            animJson["height"]     = 16;
+            animJson["frames"]     = 4;
+            animJson["columns"]    = 4;
+            animJson["durationMs"] = 100;
+            animJson["looping"]    = true;
+            j["animations"].push_back(animJson);
+        }
+    return BuildBinaryExport(j, { { 64, 128 } });
+}
+
+/**
+ * \brief Applies the corruption to a valid export and checks the reader refuses it.
+ */
+void
+CheckRejected(const std::function<void(std::vector<uint8_t>&)>& corrupt, const char* what)
+{
+    std::vector<uint8_t> buffer{ MakeExport() };
+    corrupt(buffer);
+    Check(!sprite_uv::AnimationSet::FromMemory(buffer.data(), buffer.size()).has_value(), what);
+}
+
+size_t
+GetAnimationOffset(const std::vector<uint8_t>& buffer, uint32_t index)
+{
+    return GetU32(buffer, offsetof(BinaryHeader, AnimationsOffset)) + index * sizeof(BinaryAnimation);
+}
+}
+
+int
+main()
+{
+    const std::vector<uint8_t> valid{ MakeExport() };
+    Check(sprite_uv::AnimationSet::FromMemory(valid.data(), valid.size()).has_value(), "a valid export is accepted");
+    Check(!sprite_uv::AnimationSet::FromMemory(valid.data(), valid.size() - 1).has_value(), "a truncated export is rejected");
+
+    CheckRejected(
+        [](std::vector<uint8_t>& buffer) {
+            SetU32(buffer, GetAnimationOffset(buffer, 4) + offsetof(BinaryAnimation, FirstFrame), GetU32(buffer, offsetof(BinaryHeader, FrameCount)) - 1);
+        },
+        "frames past the frame array are rejected");
+    CheckRejected([](std::vector<uint8_t>& buffer) { SetU32(buffer, GetAnimationOffset(buffer, 2) + offsetof(BinaryAnimation, FrameCount), 0xFFFFFFF0u); },
+                  "a frame count overflowing the first frame is rejected");
+    CheckRejected([](std::vector<uint8_t>& buffer) { SetU32(buffer, GetAnimationOffset(buffer, 0) + offsetof(BinaryAnimation, FrameCount), 0); },
+                  "an animation without frames is rejected");
+    CheckRejected(
+        [](std::vector<uint8_t>& buffer) {
+            SetU32(buffer, GetAnimationOffset(buffer, 1) + offsetof(BinaryAnimation, NameOffset), GetU32(buffer, offsetof(BinaryHeader, StringTableSize)));
+        },
+        "a name past the string table is rejected");
+    CheckRejected([](std::vector<uint8_t>& buffer) { SetU32(buffer, GetAnimationOffset(buffer, 3) + offsetof(BinaryAnimation, NameLength), 3); },
+                  "a name without terminator is rejected");
+    CheckRejected([](std::vector<uint8_t>& buffer) { SetU32(buffer, offsetof(BinaryHeader, LookupCapacity), 12); },
+                  "a lookup table size not a power of two is rejected");
+    CheckRejected([](std::vector<uint8_t>& buffer) { SetU32(buffer, offsetof(BinaryHeader, LookupCapacity), 8); },
+                  "a lookup table loaded above 50% is rejected");
+
+    // A table without empty slot must still end the probing, the load check happens on the header count only
+    std::vector<uint8_t> full{ valid };
+    const uint32_t       lookupOffset{ GetU32(full, offsetof(BinaryHeader, LookupOffset)) };
+    const uint32_t       lookupCapacity{ GetU32(full, offsetof(BinaryHeader, LookupCapacity)) };
+    for (uint32_t slot{}; slot < lookupCapacity; ++slot)
+        {
+            SetU32(full, lookupOffset + slot * sizeof(BinaryLookupEntry) + offsetof(BinaryLookupEntry, NameHash), 0);
+            SetU32(full, lookupOffset + slot * sizeof(BinaryLookupEntry) + offsetof(BinaryLookupEntry, AnimationIndex), 0);
+        }
+    const auto set{ sprite_uv::AnimationSet::FromMemory(full.data(), full.size()) };
+    Check(set.has_value(), "a lookup table without empty slot passes the header checks");
+    if (set.has_value())
+        {
+            Check(set->Find("Unknown") == nullptr, "probing a full table ends");
+            Check(set->FindByHash(sprite_uv::HashName("Anim_0")) == nullptr, "probing a full table by hash ends");
+        }
+
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("runtime_reader_test passed\n");
+    return EXIT_SUCCESS;
+}
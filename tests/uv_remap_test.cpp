@@ -0,0 +1,192 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+// Headless checks of the search of the moved frames, no raylib needed
+
+#include "uv_remap_search.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+int32_t numFailures{};
+
+void
+Check(bool condition, const char* what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what);
+            ++numFailures;
+        }
+}
+
+struct TestImage
+{
+    int32_t              Width{};
+    int32_t              Height{};
+    std::vector<uint8_t> Rgba{};
+
+    TestImage(int32_t width, int32_t height) : Width{ width }, Height{ height }, Rgba(static_cast<size_t>(width) * height * 4) {}
+
+    UvRemapPixels Pixels() const { return { Rgba.data(), Width, Height }; }
+    uint8_t*      Texel(int32_t x, int32_t y) { return &Rgba[(static_cast<size_t>(y) * Width + x) * 4]; }
+};
+
+// Opaque noise, every position of the block is distinctive
+void
+FillNoise(TestImage& image, const Rect& rect, std::mt19937& random)
+{
+    for (int32_t y{ rect.y }; y < rect.y + rect.h; ++y)
+        {
+            for (int32_t x{ rect.x }; x < rect.x + rect.w; ++x)
+                {
+                    uint8_t* texel{ image.Texel(x, y) };
+                    texel[0] = static_cast<uint8_t>(random());
+                    texel[1] = static_cast<uint8_t>(random());
+                    texel[2] = static_cast<uint8_t>(random());
+                    texel[3] = 255;
+                }
+        }
+}
+
+void
+CopyBlock(const TestImage& source, const Rect& rect, TestImage& destination, int32_t x, int32_t y)
+{
+    for (int32_t row{}; row < rect.h; ++row)
+        {
+            for (int32_t column{}; column < rect.w; ++column)
+                {
+                    const uint8_t* from{ &source.Rgba[(static_cast<size_t>(rect.y + row) * source.Width + rect.x + column) * 4] };
+                    uint8_t*       to{ destination.Texel(x + column, y + row) };
+                    to[0]          = from[0];
+                    to[1]          = from[1];
+                    to[2]          = from[2];
+                    to[3]          = from[3];
+                }
+        }
+}
+
+const UvRemapResult*
+FindResult(const UvRemapReport& report, const std::string& name)
+{
+    for (const auto& result : report.Results)
+        {
+            if (result.AnimationName == name)
+                {
+                    return &result;
+                }
+        }
+    return nullptr;
+}
+
+void
+TestMovedBlock()
+{
+    // Two animations of two frames moved together, both are found with a full confidence
+    std::mt19937 random{ 42 };
+    TestImage    previous{ 128, 128 };
+    FillNoise(previous, { 8, 8, 32, 16 }, random);
+    FillNoise(previous, { 8, 40, 48, 16 }, random);
+    TestImage next{ 128, 128 };
+    CopyBlock(previous, { 8, 8, 48, 48 }, next, 28, 16);
+
+    const std::vector<UvRemapInput> animations{ { "walk", { 8, 8, 16, 16 }, 2, 2 }, { "run", { 8, 40, 24, 16 }, 2, 2 } };
+    Check(HasAnyFrameChanged(previous.Pixels(), next.Pixels(), animations), "a moved block changed the frames");
+    Check(!HasAnyFrameChanged(previous.Pixels(), previous.Pixels(), animations), "the same image changed no frame");
+
+    const UvRemapReport report{ FindRemappedUvs(previous.Pixels(), next.Pixels(), animations) };
+    const auto*         walk{ FindResult(report, "walk") };
+    const auto*         run{ FindResult(report, "run") };
+    Check(walk && walk->NewUv.x == 28 && walk->NewUv.y == 16 && walk->Confidence == 1.f, "the first animation follows the block");
+    Check(run && run->NewUv.x == 28 && run->NewUv.y == 48 && run->Confidence == 1.f, "the second animation follows the block");
+    Check(report.NumMoved == 2 && report.NumLowConfidence == 0, "both animations are moved");
+}
+
+void
+TestRemovedSparseFrame()
+{
+    // A small opaque mark in a large transparent frame, removed from the next image: blank space must not be a confident match
+    std::mt19937 random{ 7 };
+    TestImage    previous{ 96, 96 };
+    FillNoise(previous, { 14, 14, 4, 4 }, random);
+    FillNoise(previous, { 60, 60, 24, 24 }, random);
+    TestImage next{ 96, 96 };
+    CopyBlock(previous, { 60, 60, 24, 24 }, next, 60, 60);
+
+    const std::vector<UvRemapInput> animations{ { "spark", { 0, 0, 32, 32 }, 1, 1 }, { "idle", { 60, 60, 24, 24 }, 1, 1 } };
+    const UvRemapReport             report{ FindRemappedUvs(previous.Pixels(), next.Pixels(), animations) };
+    const auto*                     spark{ FindResult(report, "spark") };
+    Check(spark && spark->Confidence < MIN_REMAP_CONFIDENCE, "a removed mark has a low confidence");
+    Check(spark && spark->Confidence == 0.f, "an empty area is no closer than blank space");
+    Check(report.NumMoved == 0 && report.NumLowConfidence == 1, "the removed frame is reported, not moved");
+}
+
+void
+TestRedrawnCoverage()
+{
+    // A single erased pixel barely changes the difference but the covered pixels differ, the frame was redrawn
+    std::mt19937 random{ 99 };
+    TestImage    previous{ 64, 64 };
+    FillNoise(previous, { 16, 16, 32, 32 }, random);
+    TestImage next{ previous };
+    next.Texel(30, 30)[3] = 0;
+
+    const std::vector<UvRemapInput> animations{ { "hit", { 16, 16, 32, 32 }, 1, 1 } };
+    const UvRemapReport             report{ FindRemappedUvs(previous.Pixels(), next.Pixels(), animations) };
+    Check(report.Results.size() == 1 && report.Results[0].Confidence == 0.f, "another coverage is never a confident match");
+    Check(report.NumLowConfidence == 1, "the redrawn frame is reported");
+}
+
+void
+TestTransparentFrame()
+{
+    // Nothing to match in a fully transparent frame, it is kept
+    TestImage                       previous{ 32, 32 };
+    TestImage                       next{ 32, 32 };
+    const std::vector<UvRemapInput> animations{ { "empty", { 0, 0, 16, 16 }, 1, 1 } };
+    const UvRemapReport             report{ FindRemappedUvs(previous.Pixels(), next.Pixels(), animations) };
+    Check(report.Results.size() == 1 && report.Results[0].Ambiguous, "a transparent frame is ambiguous");
+    Check(report.NumMoved == 0 && report.NumLowConfidence == 1, "a transparent frame is not moved");
+}
+}
+
+int
+main()
+{
+    TestMovedBlock();
+    TestRemovedSparseFrame();
+    TestRedrawnCoverage();
+    TestTransparentFrame();
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("uv_remap_test passed\n");
+    return EXIT_SUCCESS;
+}
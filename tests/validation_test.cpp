@@ -0,0 +1,361 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+// Headless checks of the frame checks against brute force, no raylib needed
+
+#include "validation.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+int32_t numFailures{};
+
+void
+Check(bool condition, const std::string& what)
+{
+    if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+            ++numFailures;
+        }
+}
+
+using OverlapKey = std::tuple<size_t, size_t, int32_t, int32_t, int32_t, int32_t>;
+
+std::vector<OverlapKey>
+ToKeys(const std::vector<FrameOverlap>& overlaps)
+{
+    std::vector<OverlapKey> keys{};
+    for (const auto& overlap : overlaps)
+        {
+            keys.emplace_back(overlap.First, overlap.Second, overlap.Intersection.x, overlap.Intersection.y, overlap.Intersection.w, overlap.Intersection.h);
+        }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Every pair, what the sweep must find
+std::vector<OverlapKey>
+BruteForceOverlaps(const std::vector<PlacedFrame>& frames)
+{
+    std::vector<OverlapKey> keys{};
+    for (size_t i{}; i < frames.size(); ++i)
+        {
+            for (size_t j{ i + 1 }; j < frames.size(); ++j)
+                {
+                    const Rect& a{ frames[i].Bounds };
+                    const Rect& b{ frames[j].Bounds };
+                    if (frames[i].Page != frames[j].Page || frames[i].Animation == frames[j].Animation || a.w <= 0 || a.h <= 0 || b.w <= 0 || b.h <= 0)
+                        {
+                            continue;
+                        }
+                    const int32_t left{ std::max(a.x, b.x) };
+                    const int32_t top{ std::max(a.y, b.y) };
+                    const int32_t right{ std::min(a.x + a.w, b.x + b.w) };
+                    const int32_t bottom{ std::min(a.y + a.h, b.y + b.h) };
+                    if (left < right && top < bottom)
+                        {
+                            keys.emplace_back(i, j, left, top, right - left, bottom - top);
+                        }
+                }
+        }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+void
+TestTouchingEdges()
+{
+    // Frames sharing an edge or a corner do not overlap
+    const std::vector<PlacedFrame> frames{ { 0, 0, 0, { 0, 0, 10, 10 } }, { 1, 0, 0, { 10, 0, 10, 10 } }, { 2, 0, 0, { 0, 10, 10, 10 } }, { 3, 0, 0, { 10, 10, 10, 10 } } };
+    Check(FindFrameOverlaps(frames).empty(), "touching edges are not overlaps");
+
+    // One pixel more is
+    const std::vector<PlacedFrame> overlapping{ { 0, 0, 0, { 0, 0, 11, 10 } }, { 1, 0, 0, { 10, 0, 10, 10 } } };
+    const auto                     overlaps{ FindFrameOverlaps(overlapping) };
+    Check(overlaps.size() == 1 && overlaps[0].Intersection.x == 10 && overlaps[0].Intersection.w == 1 && overlaps[0].Intersection.h == 10, "a one pixel overlap is found");
+}
+
+void
+TestSameAnimation()
+{
+    // The frames of one animation may overlap each other, e.g. a sheet read with a smaller step
+    const std::vector<PlacedFrame> frames{ { 0, 0, 0, { 0, 0, 10, 10 } }, { 0, 1, 0, { 5, 0, 10, 10 } }, { 0, 2, 0, { 10, 0, 10, 10 } } };
+    Check(FindFrameOverlaps(frames).empty(), "frames of one animation are ignored");
+}
+
+void
+TestTallFrame()
+{
+    // A tall frame starting far above short ones, the search must reach back the tallest height
+    std::vector<PlacedFrame> frames{ { 0, 0, 0, { 0, 0, 4, 200 } } };
+    for (int32_t i{}; i < 20; ++i)
+        {
+            frames.push_back({ 1, i, 0, { 2, i * 10, 8, 5 } });
+        }
+    // Past the tall frame, only the short ones are active
+    frames.push_back({ 2, 0, 0, { 5, 190, 4, 4 } });
+    Check(ToKeys(FindFrameOverlaps(frames)) == BruteForceOverlaps(frames), "a tall frame among short ones");
+    Check(FindFrameOverlaps(frames).size() == 21, "the tall frame overlaps every short frame");
+}
+
+void
+TestPageReset()
+{
+    // The same rects on two pages only overlap within their page, the tall frame of the first page does not widen the second
+    std::vector<PlacedFrame> frames{ { 0, 0, 0, { 0, 0, 10, 500 } }, { 1, 0, 1, { 0, 0, 10, 10 } }, { 2, 0, 1, { 5, 5, 10, 10 } }, { 3, 0, 0, { 20, 400, 10, 10 } } };
+    const auto               keys{ ToKeys(FindFrameOverlaps(frames)) };
+    Check(keys == BruteForceOverlaps(frames), "overlaps across pages");
+    Check(keys.size() == 1 && std::get<0>(keys[0]) == 1 && std::get<1>(keys[0]) == 2, "only the frames of the same page overlap");
+}
+
+void
+TestRandomLayouts()
+{
+    // Small coordinates so that touching and nested frames are common, empty frames included
+    std::mt19937 random{ 2024 };
+    for (int32_t iteration{}; iteration < 2000; ++iteration)
+        {
+            const size_t             numFrames{ random() % 40 };
+            std::vector<PlacedFrame> frames(numFrames);
+            for (size_t i{}; i < numFrames; ++i)
+                {
+                    // Mostly short, sometimes tall and narrow
+                    const bool tall{ random() % 8 == 0 };
+                    frames[i].Animation = static_cast<int32_t>(random() % 6);
+                    frames[i].Frame     = static_cast<int32_t>(i);
+                    frames[i].Page      = static_cast<int32_t>(random() % 3);
+                    frames[i].Bounds    = { static_cast<int32_t>(random() % 32), static_cast<int32_t>(random() % 32), static_cast<int32_t>(random() % (tall ? 4 : 12)),
+                        static_cast<int32_t>(random() % (tall ? 40 : 8)) };
+                }
+            if (ToKeys(FindFrameOverlaps(frames)) != BruteForceOverlaps(frames))
+                {
+                    Check(false, "random layout " + std::to_string(iteration) + " matches the pairwise check");
+                    return;
+                }
+        }
+}
+
+// What IsFrameTransparent must answer, pixel by pixel
+bool
+BruteForceTransparent(const PagePixels& pixels, const Rect& frame)
+{
+    for (int32_t y{ std::max(0, frame.y) }; y < std::min(pixels.Height, frame.y + frame.h); ++y)
+        {
+            for (int32_t x{ std::max(0, frame.x) }; x < std::min(pixels.Width, frame.x + frame.w); ++x)
+                {
+                    if (pixels.Rgba[(static_cast<size_t>(y) * pixels.Width + x) * 4 + 3] != 0)
+                        {
+                            return false;
+                        }
+                }
+        }
+    return true;
+}
+
+void
+TestTransparentFrames()
+{
+    // A single opaque pixel at every column, the last columns are the scalar tail after the SSE2 groups of 4
+    const int32_t        width{ 13 };
+    const int32_t        height{ 3 };
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 255);
+    for (size_t i{ 3 }; i < rgba.size(); i += 4)
+        {
+            rgba[i] = 0;
+        }
+    const PagePixels pixels{ rgba.data(), width, height };
+    Check(IsFrameTransparent(pixels, { 0, 0, width, height }), "transparent white is transparent");
+    for (int32_t x{}; x < width; ++x)
+        {
+            uint8_t& alpha{ rgba[(static_cast<size_t>(1) * width + x) * 4 + 3] };
+            alpha = 1;
+            for (int32_t frameWidth{ 1 }; x + frameWidth <= width; ++frameWidth)
+                {
+                    const int32_t left{ x + 1 - std::min(frameWidth, x + 1) };
+                    const Rect    frame{ left, 0, frameWidth, height };
+                    Check(IsFrameTransparent(pixels, frame) == BruteForceTransparent(pixels, frame),
+                          "opaque pixel at column " + std::to_string(x) + " in a frame " + std::to_string(frameWidth) + " wide");
+                }
+            Check(!IsFrameTransparent(pixels, { x, 1, 1, 1 }), "opaque pixel at column " + std::to_string(x) + " alone");
+            alpha = 0;
+        }
+
+    // Clipped to the page, the pixels outside are not read
+    std::mt19937 random{ 5 };
+    for (int32_t i{}; i < 500; ++i)
+        {
+            std::fill(rgba.begin(), rgba.end(), uint8_t{});
+            rgba[(random() % (static_cast<size_t>(width) * height)) * 4 + 3] = 255;
+            const Rect frame{ static_cast<int32_t>(random() % 20) - 5, static_cast<int32_t>(random() % 8) - 3, static_cast<int32_t>(random() % 20),
+                static_cast<int32_t>(random() % 8) };
+            if (IsFrameTransparent(pixels, frame) != BruteForceTransparent(pixels, frame))
+                {
+                    Check(false, "random clipped frame " + std::to_string(i));
+                    break;
+                }
+        }
+}
+
+std::vector<std::string>
+ToStrings(const std::vector<ValidationIssue>& issues)
+{
+    std::vector<std::string> strings{};
+    for (const auto& issue : issues)
+        {
+            strings.push_back(issue.ToString());
+        }
+    std::sort(strings.begin(), strings.end());
+    return strings;
+}
+
+std::vector<std::tuple<EFrameIssue, int32_t, int32_t, int32_t, int32_t, int32_t>>
+ToKeys(const std::vector<FrameAnnotation>& annotations)
+{
+    std::vector<std::tuple<EFrameIssue, int32_t, int32_t, int32_t, int32_t, int32_t>> keys{};
+    for (const auto& annotation : annotations)
+        {
+            keys.emplace_back(annotation.Issue, annotation.Page, annotation.Bounds.x, annotation.Bounds.y, annotation.Bounds.w, annotation.Bounds.h);
+        }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+void
+TestIncrementalUpdate()
+{
+    // Random edits, the incremental validator must agree with a new one checking everything
+    std::mt19937                   random{ 77 };
+    const std::vector<std::string> allNames{ "a", "b", "c", "d", "e", "f", "g", "h" };
+    std::vector<Vec2>              pageSizes{ { 64, 64 }, { 32, 32 } };
+    std::vector<uint8_t>           rgba(64 * 64 * 4, 0);
+    std::vector<PagePixels>        pagePixels{ { rgba.data(), 64, 64 } };
+    uint64_t                       pixelsVersion{ 1 };
+    std::vector<std::string>       names{};
+    std::vector<FrameLayout>       layouts{};
+
+    const auto randomLayout = [&random]() {
+        FrameLayout layout{};
+        layout.Uv        = { static_cast<int32_t>(random() % 60), static_cast<int32_t>(random() % 60), 1 + static_cast<int32_t>(random() % 12), 1 + static_cast<int32_t>(random() % 12) };
+        layout.NumFrames = 1 + static_cast<int32_t>(random() % 4);
+        layout.Columns   = 1 + static_cast<int32_t>(random() % 3);
+        layout.Page      = static_cast<int32_t>(random() % 2);
+        return layout;
+    };
+
+    FrameValidator incremental{};
+    for (int32_t step{}; step < 300; ++step)
+        {
+            const auto edit{ random() % 6 };
+            if (edit == 0 && names.size() < allNames.size())
+                {
+                    names.push_back(allNames[names.size()]);
+                    layouts.push_back(randomLayout());
+                }
+            else if (edit == 1 && !names.empty())
+                {
+                    names.pop_back();
+                    layouts.pop_back();
+                }
+            else if (edit == 2 && !layouts.empty())
+                {
+                    layouts[random() % layouts.size()] = randomLayout();
+                }
+            else if (edit == 3)
+                {
+                    pageSizes[1] = { 16 + static_cast<int32_t>(random() % 32), 16 + static_cast<int32_t>(random() % 32) };
+                }
+            else if (edit == 4)
+                {
+                    rgba[(random() % (64 * 64)) * 4 + 3] ^= 255;
+                    ++pixelsVersion;
+                }
+
+            std::vector<std::string_view> views(names.begin(), names.end());
+            const bool                    changed{ incremental.Update(views, layouts, pageSizes, pagePixels, pixelsVersion) };
+            FrameValidator                fresh{};
+            fresh.Update(views, layouts, pageSizes, pagePixels, pixelsVersion);
+            if (ToStrings(incremental.GetIssues()) != ToStrings(fresh.GetIssues()) || ToKeys(incremental.GetAnnotations()) != ToKeys(fresh.GetAnnotations()))
+                {
+                    Check(false, "incremental update " + std::to_string(step) + " matches a full check");
+                    return;
+                }
+            Check(edit != 5 || !changed, "an update without edits checks nothing");
+        }
+
+    // Only the edited animation is checked again
+    names   = { "a", "b", "c" };
+    layouts = { { { 0, 0, 8, 8 }, 2, 2, 0 }, { { 4, 4, 8, 8 }, 1, 1, 0 }, { { 40, 40, 8, 8 }, 1, 1, 0 } };
+    std::vector<std::string_view> views(names.begin(), names.end());
+    FrameValidator                validator{};
+    validator.Update(views, layouts, pageSizes, pagePixels, pixelsVersion);
+    Check(validator.GetNumChecked() == 3, "the first update checks every animation");
+    layouts[2].Uv.x = 0;
+    validator.Update(views, layouts, pageSizes, pagePixels, pixelsVersion);
+    Check(validator.GetNumChecked() == 1, "an edit checks one animation again");
+    validator.Update(views, layouts, pageSizes, pagePixels, pixelsVersion + 1);
+    Check(validator.GetNumChecked() == 3, "new pixels check every animation again");
+}
+
+void
+TestTotalDuration()
+{
+    // The exports store the total duration in 32 bits
+    nlohmann::ordered_json j = nlohmann::ordered_json::parse(R"({
+        "selectedAnimationIndex": 0,
+        "animations": [ { "name": "Long", "type": "Spritesheet", "x": 0, "y": 0, "width": 1, "height": 1, "frames": 2, "columns": 2, "durationMs": 2147483647, "looping": true } ]
+    })");
+    Check(!HasValidationErrors(ValidateProjectJson(j, { { 8, 8 } })), "a total duration up to UINT32_MAX is valid");
+    j["animations"][0]["frames"]  = 3;
+    j["animations"][0]["columns"] = 3;
+    Check(HasValidationErrors(ValidateProjectJson(j, { { 8, 8 } })), "a total duration above UINT32_MAX is an error");
+}
+}
+
+int
+main()
+{
+    TestTouchingEdges();
+    TestSameAnimation();
+    TestTallFrame();
+    TestPageReset();
+    TestRandomLayouts();
+    TestTransparentFrames();
+    TestIncrementalUpdate();
+    TestTotalDuration();
+    if (numFailures > 0)
+        {
+            std::fprintf(stderr, "%d checks failed\n", numFailures);
+            return EXIT_FAILURE;
+        }
+    std::printf("validation_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2025 Kirichenko Stanislav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Minimal client of the server mode (sprite_uv_editor --serve <socket>), for scripts and end to end tests.
+// Sends every request given as argument, or every line of stdin when there is none, then prints the responses until the server closed the connection.
+//   sprite_uv_client /tmp/sprite_uv.sock '{"id":1,"command":"validate","sprite":"hero.png"}'
+//   sprite_uv_client /tmp/sprite_uv.sock < requests.ndjson
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+bool
+SendAll(int fd, const std::string& data)
+{
+    for (size_t sent{}; sent < data.size();)
+        {
+            const ssize_t written{ ::write(fd, data.data() + sent, data.size() - sent) };
+            if (written < 0 && errno != EINTR)
+                {
+                    return false;
+                }
+            sent += written > 0 ? static_cast<size_t>(written) : 0;
+        }
+    return true;
+}
+}
+
+int
+main(int argc, char** argv)
+{
+    if (argc < 2)
+        {
+            std::cerr << "Usage: " << argv[0] << " <socket> [request ...]" << std::endl;
+            return 2;
+        }
+
+    sockaddr_un       address{};
+    const std::string socketPath{ argv[1] };
+    if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "Socket path too long" << std::endl;
+            return 2;
+        }
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, socketPath.size());
+
+    const int fd{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            std::cerr << "Failed to connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+
+    std::string requests{};
+    if (argc > 2)
+        {
+            for (int i{ 2 }; i < argc; ++i)
+                {
+                    requests.append(argv[i]).push_back('\n');
+                }
+        }
+    else
+        {
+            for (std::string line{}; std::getline(std::cin, line);)
+                {
+                    requests.append(line).push_back('\n');
+                }
+        }
+    // The server answers what it read then closes the connection once the write side is shut
+    if (!SendAll(fd, requests) || ::shutdown(fd, SHUT_WR) != 0)
+        {
+            std::cerr << "Failed to send the requests: " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            return 1;
+        }
+
+    char chunk[4096];
+    for (ssize_t numRead{}; (numRead = ::read(fd, chunk, sizeof(chunk))) != 0;)
+        {
+            if (numRead < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    break;
+                }
+            std::cout.write(chunk, numRead);
+        }
+    std::cout.flush();
+    ::close(fd);
+    return 0;
+}